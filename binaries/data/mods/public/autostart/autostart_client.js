@@ -9,7 +9,16 @@ class AutoStartClient
 			const playerName = cmdLineArgs['autostart-playername'] || "anonymous";
 			const ip = cmdLineArgs['autostart-client'] ?? "127.0.0.1";
 			const port = +(cmdLineArgs['autostart-port'] ?? 5073);
-			Engine.StartNetworkJoin(playerName, ip, port, !('autostart-disable-replay' in cmdLineArgs));
+			const storeReplay = !('autostart-disable-replay' in cmdLineArgs);
+			if ('autostart-relay' in cmdLineArgs)
+			{
+				const relayPort = +cmdLineArgs['autostart-relay'];
+				if (!Number.isInteger(relayPort) || relayPort < 1 || relayPort > 65535)
+					throw new Error(sprintf(translate("Invalid relay port %(port)s"), { "port": cmdLineArgs['autostart-relay'] }));
+				Engine.StartNetworkRelay(playerName, ip, port, relayPort, storeReplay);
+			}
+			else
+				Engine.StartNetworkJoin(playerName, ip, port, storeReplay);
 		}
 		catch (e)
 		{
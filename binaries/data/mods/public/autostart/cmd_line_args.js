@@ -42,6 +42,8 @@
  * -autostart-port=NUMBER          sets port NUMBER for multiplayer game
  * -autostart-client=IP            (handled in C++) sets multiplayer client to join host at
  *                                 given IP address
+ * -autostart-relay=PORT           with -autostart-client, joins as an observer and
+ *                                 re-serves the game to other observers on PORT
  *
  * Random maps only:
  * -autostart-size=TILES           sets random map size in TILES (default 192)
@@ -55,6 +57,8 @@
  *  "Alice" joins the match as player 2:
  * -autostart-client=127.0.0.1 -autostart-playername="Alice"
  * The players use the developer overlay to control players.
+ *  A headless relay re-serves the match to observers connecting to port 5074:
+ * -autostart-client=127.0.0.1 -autostart-relay=5074 -autostart-nonvisual -autostart-playername="Relay"
  *
  * 2) Load Alpine Lakes random map with random seed, 2 players (Athens and Britons), and player 2 is PetraBot:
  * -autostart="random/alpine_lakes" -autostart-seed=-1 -autostart-players=2 -autostart-civ=1:athen -autostart-civ=2:brit -autostart-ai=2:petra
@@ -45,8 +45,20 @@ class TileClass {
 	/**
 	 * Count the number of tiles in the tileclass within the given radius of the given position.
 	 * Can return either the total number of members or nonmembers.
+	 * Uses the native implementation of the engine when available.
 	 */
 	countInRadius(position, radius, returnMembers)
+	{
+		if (Engine.CountTileClassInRadius)
+			return Engine.CountTileClassInRadius(this.inclusionGrid, this.size, position.x, position.y, radius, returnMembers);
+
+		return this.countInRadiusScripted(position, radius, returnMembers);
+	}
+
+	/**
+	 * Script implementation of countInRadius, which must return identical results.
+	 */
+	countInRadiusScripted(position, radius, returnMembers)
 	{
 		let members = 0;
 		let total = 0;
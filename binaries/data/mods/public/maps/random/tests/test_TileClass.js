@@ -67,4 +67,35 @@ export function* generateMap()
 		TS_ASSERT_EQUALS(tileClass.countNonMembersInRadius(pointBorder, 2), 11);
 		TS_ASSERT_EQUALS(tileClass.countNonMembersInRadius(pointBorder, 3), 22);
 	}
+
+	// Test that the native implementation matches the script one
+	if (Engine.CountTileClassInRadius)
+	{
+		const tileClass = new TileClass(40);
+		for (let x = 0; x < 40; ++x)
+			for (let y = 0; y < 40; ++y)
+				if ((x * 7 + y * 13) % 5 == 0)
+					tileClass.add(new Vector2D(x, y));
+
+		const positions = [
+			new Vector2D(0, 0),
+			new Vector2D(17, 23),
+			new Vector2D(15.5, 16.25),
+			new Vector2D(39, 2),
+			new Vector2D(-3, 20),
+			new Vector2D(44, 44),
+			new Vector2D(Infinity, 20),
+			new Vector2D(-Infinity, 20),
+			new Vector2D(20, Infinity),
+			new Vector2D(NaN, 20),
+			new Vector2D(1e10, 20)
+		];
+
+		for (const position of positions)
+			for (const radius of [0, 0.5, 1, 2.5, 7, 100, Infinity, NaN])
+				for (const returnMembers of [true, false])
+					TS_ASSERT_EQUALS(
+						tileClass.countInRadius(position, radius, returnMembers),
+						tileClass.countInRadiusScripted(position, radius, returnMembers));
+	}
 }
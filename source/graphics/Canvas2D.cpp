@@ -1,4 +1,4 @@
-/* Copyright (C) 2023 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -47,34 +47,10 @@ struct SBindingSlots
 	int32_t tex;
 };
 
-inline void DrawTextureImpl(
-	Renderer::Backend::IDeviceCommandContext* deviceCommandContext,
-	const CTexturePtr& texture, const PlaneArray2D& vertices, PlaneArray2D uvs,
-	const CColor& multiply, const CColor& add, const float grayscaleFactor,
-	const SBindingSlots& bindingSlots)
-{
-	texture->UploadBackendTextureIfNeeded(deviceCommandContext);
-	deviceCommandContext->SetTexture(
-		bindingSlots.tex, texture->GetBackendTexture());
-	for (size_t idx = 0; idx < uvs.size(); idx += 2)
-	{
-		if (texture->GetWidth() > 0.0f)
-			uvs[idx + 0] /= texture->GetWidth();
-		if (texture->GetHeight() > 0.0f)
-			uvs[idx + 1] /= texture->GetHeight();
-	}
-
-	deviceCommandContext->SetUniform(bindingSlots.colorAdd, add.AsFloatArray());
-	deviceCommandContext->SetUniform(bindingSlots.colorMul, multiply.AsFloatArray());
-	deviceCommandContext->SetUniform(bindingSlots.grayscaleFactor, grayscaleFactor);
-
-	deviceCommandContext->SetVertexBufferData(
-		0, vertices.data(), vertices.size() * sizeof(vertices[0]));
-	deviceCommandContext->SetVertexBufferData(
-		1, uvs.data(), uvs.size() * sizeof(uvs[0]));
-
-	deviceCommandContext->Draw(0, vertices.size() / 2);
-}
+// Consecutive quads sharing the texture and the color parameters are drawn
+// with a single draw call. We don't reorder draws, so the GUI is still drawn
+// in its Z order.
+constexpr size_t MAX_QUADS_PER_BATCH = 1024;
 
 } // anonymous namespace
 
@@ -136,10 +112,64 @@ public:
 		if (!Tech)
 			return;
 
+		FlushBatch();
 		DeviceCommandContext->EndPass();
 		Tech.reset();
 	}
 
+	void AddQuadToBatch(
+		const CTexturePtr& texture, const PlaneArray2D& vertices, PlaneArray2D uvs,
+		const CColor& multiply, const CColor& add, const float grayscaleFactor)
+	{
+		texture->UploadBackendTextureIfNeeded(DeviceCommandContext);
+		Renderer::Backend::ITexture* backendTexture = texture->GetBackendTexture();
+		if (BatchTexture != backendTexture || BatchMultiply != multiply ||
+			BatchAdd != add || BatchGrayscaleFactor != grayscaleFactor ||
+			BatchVertices.size() >= MAX_QUADS_PER_BATCH * vertices.size())
+		{
+			FlushBatch();
+			BatchTexture = backendTexture;
+			BatchMultiply = multiply;
+			BatchAdd = add;
+			BatchGrayscaleFactor = grayscaleFactor;
+		}
+
+		for (size_t idx = 0; idx < uvs.size(); idx += 2)
+		{
+			if (texture->GetWidth() > 0.0f)
+				uvs[idx + 0] /= texture->GetWidth();
+			if (texture->GetHeight() > 0.0f)
+				uvs[idx + 1] /= texture->GetHeight();
+		}
+
+		BatchVertices.insert(BatchVertices.end(), vertices.begin(), vertices.end());
+		BatchUVs.insert(BatchUVs.end(), uvs.begin(), uvs.end());
+		++CanvasStats.drawRequests;
+	}
+
+	void FlushBatch()
+	{
+		if (BatchVertices.empty())
+			return;
+
+		DeviceCommandContext->SetTexture(BindingSlots.tex, BatchTexture);
+		DeviceCommandContext->SetUniform(BindingSlots.colorAdd, BatchAdd.AsFloatArray());
+		DeviceCommandContext->SetUniform(BindingSlots.colorMul, BatchMultiply.AsFloatArray());
+		DeviceCommandContext->SetUniform(BindingSlots.grayscaleFactor, BatchGrayscaleFactor);
+
+		DeviceCommandContext->SetVertexBufferData(
+			0, BatchVertices.data(), BatchVertices.size() * sizeof(BatchVertices[0]));
+		DeviceCommandContext->SetVertexBufferData(
+			1, BatchUVs.data(), BatchUVs.size() * sizeof(BatchUVs[0]));
+
+		DeviceCommandContext->Draw(0, BatchVertices.size() / 2);
+
+		BatchVertices.clear();
+		BatchUVs.clear();
+		BatchTexture = nullptr;
+		++CanvasStats.batches;
+	}
+
 	/**
 	 * Returns model-view-projection matrix with (0,0) in top-left of screen.
 	 */
@@ -162,6 +192,7 @@ public:
 
 	void ApplyScissors()
 	{
+		FlushBatch();
 		if (!Scissors.empty())
 		{
 			CRect rect = Scissors.back();
@@ -192,6 +223,16 @@ public:
 	SBindingSlots BindingSlots;
 
 	PS::StaticVector<CRect, 4> Scissors;
+
+	// The pending batch of textured quads.
+	Renderer::Backend::ITexture* BatchTexture = nullptr;
+	CColor BatchMultiply;
+	CColor BatchAdd;
+	float BatchGrayscaleFactor = 0.0f;
+	std::vector<float> BatchVertices;
+	std::vector<float> BatchUVs;
+
+	CCanvas2D::Stats CanvasStats;
 };
 
 CCanvas2D::CCanvas2D(
@@ -338,6 +379,7 @@ void CCanvas2D::DrawLine(const std::vector<CVector2D>& points, const float width
 		points[pointsIndices.back().index] + pointsIndices[pointsIndices.size() - 2].normal * halfWidth);
 
 	m->BindTechIfNeeded();
+	m->FlushBatch();
 
 	m->DeviceCommandContext->SetTexture(
 		m->BindingSlots.tex,
@@ -355,6 +397,9 @@ void CCanvas2D::DrawLine(const std::vector<CVector2D>& points, const float width
 
 	m->DeviceCommandContext->SetIndexBufferData(indices.data(), indices.size() * sizeof(indices[0]));
 	m->DeviceCommandContext->DrawIndexed(0, indices.size(), 0);
+
+	++m->CanvasStats.drawRequests;
+	++m->CanvasStats.batches;
 }
 
 void CCanvas2D::DrawRect(const CRect& rect, const CColor& color)
@@ -375,11 +420,9 @@ void CCanvas2D::DrawRect(const CRect& rect, const CColor& color)
 	};
 
 	m->BindTechIfNeeded();
-	DrawTextureImpl(
-		m->DeviceCommandContext,
+	m->AddQuadToBatch(
 		g_Renderer.GetTextureManager().GetTransparentTexture(),
-		vertices, uvs, CColor(0.0f, 0.0f, 0.0f, 0.0f), color, 0.0f,
-		m->BindingSlots);
+		vertices, uvs, CColor(0.0f, 0.0f, 0.0f, 0.0f), color, 0.0f);
 }
 
 void CCanvas2D::DrawTexture(const CTexturePtr& texture, const CRect& destination)
@@ -413,9 +456,7 @@ void CCanvas2D::DrawTexture(
 	};
 
 	m->BindTechIfNeeded();
-	DrawTextureImpl(
-		m->DeviceCommandContext, texture, vertices, uvs,
-		multiply, add, grayscaleFactor, m->BindingSlots);
+	m->AddQuadToBatch(texture, vertices, uvs, multiply, add, grayscaleFactor);
 }
 
 void CCanvas2D::DrawRotatedTexture(
@@ -452,20 +493,22 @@ void CCanvas2D::DrawRotatedTexture(
 	}
 
 	m->BindTechIfNeeded();
-	DrawTextureImpl(
-		m->DeviceCommandContext, texture, vertices, uvs,
-		multiply, add, grayscaleFactor, m->BindingSlots);
+	m->AddQuadToBatch(texture, vertices, uvs, multiply, add, grayscaleFactor);
 }
 
 void CCanvas2D::DrawText(CTextRenderer& textRenderer)
 {
 	m->BindTechIfNeeded();
+	m->FlushBatch();
 
 	m->DeviceCommandContext->SetUniform(
 		m->BindingSlots.grayscaleFactor, 0.0f);
 
 	textRenderer.Render(
 		m->DeviceCommandContext, m->Tech->GetShader(), m->TransformScale, m->Translation);
+
+	++m->CanvasStats.drawRequests;
+	++m->CanvasStats.batches;
 }
 
 void CCanvas2D::PushScissor(const CRect& scissor)
@@ -486,3 +529,8 @@ void CCanvas2D::Flush()
 {
 	m->UnbindTech();
 }
+
+const CCanvas2D::Stats& CCanvas2D::GetStats() const
+{
+	return m->CanvasStats;
+}
@@ -1,4 +1,4 @@
-/* Copyright (C) 2023 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -125,6 +125,19 @@ public:
 	 */
 	void Flush();
 
+	struct Stats
+	{
+		// Number of lines, rects, textures and texts requested to be drawn.
+		size_t drawRequests = 0;
+		// Number of batches issued to the device for them.
+		size_t batches = 0;
+	};
+
+	/**
+	 * Returns counters accumulated since the canvas was created.
+	 */
+	const Stats& GetStats() const;
+
 private:
 	class Impl;
 	std::unique_ptr<Impl> m;
@@ -22,6 +22,7 @@
 #include "graphics/MapIO.h"
 #include "graphics/Patch.h"
 #include "graphics/Terrain.h"
+#include "lib/bits.h"
 #include "lib/status.h"
 #include "lib/timer.h"
 #include "lib/file/vfs/vfs_path.h"
@@ -29,7 +30,9 @@
 #include "ps/CLogger.h"
 #include "ps/FileIo.h"
 #include "ps/Future.h"
+#include "ps/Profiler2.h"
 #include "ps/scripting/JSInterface_VFS.h"
+#include "ps/TaskManager.h"
 #include "ps/TemplateLoader.h"
 #include "scriptinterface/FunctionWrapper.h"
 #include "scriptinterface/JSON.h"
@@ -40,7 +43,9 @@
 #include "scriptinterface/ScriptInterface.h"
 #include "simulation2/helpers/MapEdgeTiles.h"
 
+#include <algorithm>
 #include <boost/random/linear_congruential.hpp>
+#include <cmath>
 #include <set>
 #include <string>
 #include <vector>
@@ -49,8 +54,81 @@ namespace
 {
 constexpr const char* GENERATOR_NAME{"generateMap"};
 
+// TODO: Maybe this should be optimized depending on the map size.
+constexpr int MAP_GENERATION_CONTEXT_SIZE{96 * MiB};
+
 bool MapGenerationInterruptCallback(JSContext* cx);
 
+/**
+ * Native implementation of TileClass.countInRadius (see maps/random/rmgen/TileClass.js),
+ * which is the most frequently called function of most random map scripts.
+ * The result must be identical to the script version, as maps are generated by every
+ * client, so it follows the same steps, including the odd results for positions
+ * outside the map: Math.max/min propagate NaN, the bitwise operators convert with
+ * ToInt32 (so NaN and infinities become 0) and reading past the grid yields no members.
+ *
+ * @param inclusionGrid Uint16Array with one bit per tile, for size x size tiles.
+ * @return The number of tiles in the tile class within the radius, or the number
+ * of tiles that aren't if @p returnMembers is false.
+ */
+double CountTileClassInRadius(const ScriptRequest& rq, JS::HandleValue inclusionGrid, int size,
+	double x, double y, double radius, bool returnMembers)
+{
+	if (!inclusionGrid.isObject() || !JS_IsUint16Array(&inclusionGrid.toObject()))
+	{
+		ScriptException::Raise(rq, "CountTileClassInRadius: the inclusion grid must be a Uint16Array.");
+		return 0;
+	}
+
+	const int width = (std::max(size, 0) + 15) / 16;
+	const size_t length = JS_GetTypedArrayLength(&inclusionGrid.toObject());
+	if (length < static_cast<size_t>(std::max(size, 0)) * width)
+	{
+		ScriptException::Raise(rq, "CountTileClassInRadius: the inclusion grid is too small.");
+		return 0;
+	}
+
+	// std::max/min return their first argument if either is NaN, like Math.max/min here.
+	const double yMin = std::max(std::ceil(y - radius), 0.0);
+	const double yMax = std::min(std::floor(y + radius), size - 1.0);
+	if (!(yMin <= yMax))
+		return 0;
+
+	JS::AutoCheckCannotGC nogc;
+	bool isSharedMemory;
+	const u16* grid = JS_GetUint16ArrayData(&inclusionGrid.toObject(), &isSharedMemory, nogc);
+
+	i64 members = 0;
+	i64 total = 0;
+	const double radius2 = radius * radius;
+	for (int iy = static_cast<int>(yMin); iy <= static_cast<int>(yMax); ++iy)
+	{
+		const double dy = iy - y;
+		const double dy2 = dy * dy;
+		const double delta = std::sqrt(radius2 - dy2);
+		const i32 xMin = JS::ToInt32(std::max(std::ceil(x - delta), 0.0));
+		const i32 xMax = JS::ToInt32(std::min(std::floor(x + delta), size - 1.0));
+
+		const i32 indexXMin = xMin >> 4;
+		const i32 indexXMax = xMax >> 4;
+		const i64 indexY = static_cast<i64>(iy) * width;
+		for (i32 indexX = indexXMin; indexX <= indexXMax; ++indexX)
+		{
+			const int imin = indexX == indexXMin ? xMin & 0xF : 0;
+			const int imax = indexX == indexXMax ? xMax & 0xF : 15;
+			total += imax - imin + 1;
+			const i64 index = indexY + indexX;
+			if (imin <= imax && index >= 0 && static_cast<size_t>(index) < length)
+			{
+				const u32 mask = (0xFFFFu >> (15 - imax)) & (0xFFFFu << imin);
+				members += PopulationCount<u32>(grid[index] & mask);
+			}
+		}
+	}
+
+	return static_cast<double>(returnMembers ? members : total - members);
+}
+
 /**
  * Provides callback's for the JavaScript.
  */
@@ -97,6 +175,9 @@ public:
 		// Profiling
 		REGISTER_MAPGEN_FUNC(GetMicroseconds);
 
+		// Native implementations of hot library functions
+		ScriptFunction::Register<&CountTileClassInRadius>(rq, "CountTileClassInRadius", flags);
+
 		// Engine constants
 
 		// Length of one tile of the terrain grid in metres.
@@ -426,3 +507,27 @@ Script::StructuredClone RunMapGenerationScript(const StopToken stopToken, std::a
 	const bool exportSuccess{ScriptFunction::Call(rq, map, "MakeExportable", &exportedMap)};
 	return Script::WriteStructuredClone(rq, exportSuccess ? exportedMap : map);
 }
+
+std::unique_ptr<MapGenerationTask> StartMapGenerationTask(const VfsPath& script,
+	const std::string& settings)
+{
+	auto task = std::make_unique<MapGenerationTask>();
+	task->result = g_TaskManager.PushTask(
+		[&progress = task->progress, script, settings](const StopToken stopToken)
+		{
+			PROFILE2("Map Generation");
+
+			const std::shared_ptr<ScriptContext> mapgenContext{ScriptContext::CreateContext(
+				MAP_GENERATION_CONTEXT_SIZE)};
+
+			ScriptInterface mapgenInterface{"Engine", "MapGenerator", mapgenContext,
+				[](const VfsPath& path){
+					// Only allow to load modules inside the maps folder.
+					return path.string().find(RANDOM_MAP_PREFIX) == 0;
+				}};
+
+			return RunMapGenerationScript(stopToken, progress, mapgenInterface, script, settings);
+		});
+
+	return task;
+}
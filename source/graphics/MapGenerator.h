@@ -1,4 +1,4 @@
-/* Copyright (C) 2024 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -24,6 +24,7 @@
 #include "scriptinterface/StructuredClone.h"
 
 #include <atomic>
+#include <memory>
 #include <string>
 
 constexpr std::wstring_view RANDOM_MAP_PREFIX{L"maps/random/"};
@@ -47,4 +48,22 @@ Script::StructuredClone RunMapGenerationScript(const StopToken stopToken, std::a
 	ScriptInterface& scriptInterface, const VfsPath& script, const std::string& settings,
 	const u16 flags = JSPROP_ENUMERATE | JSPROP_READONLY | JSPROP_PERMANENT);
 
+/**
+ * A map generation running on the task manager.
+ */
+struct MapGenerationTask
+{
+	std::atomic<int> progress{1};
+	Future<Script::StructuredClone> result;
+};
+
+/**
+ * Generate the map on the task manager, in a ScriptContext of its own, so
+ * several generations can run at the same time on different workers.
+ * @param script The VFS path for the script, e.g. "maps/random/latium.js".
+ * @param settings JSON string containing settings for the map generator.
+ */
+std::unique_ptr<MapGenerationTask> StartMapGenerationTask(const VfsPath& script,
+	const std::string& settings);
+
 #endif	//INCLUDED_MAPGENERATOR
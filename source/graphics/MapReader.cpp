@@ -33,7 +33,6 @@
 #include "ps/CLogger.h"
 #include "ps/Loader.h"
 #include "ps/Profiler2.h"
-#include "ps/TaskManager.h"
 #include "ps/World.h"
 #include "ps/XML/Xeromyces.h"
 #include "renderer/PostprocManager.h"
@@ -66,9 +65,6 @@ extern bool IsQuitRequested();
 #pragma warning(disable: 4458) // Declaration hides class member.
 #endif
 
-// TODO: Maybe this should be optimized depending on the map size.
-constexpr int MAP_GENERATION_CONTEXT_SIZE{96 * MiB};
-
 CMapReader::CMapReader() = default;
 
 // LoadMap: try to load the map from given file; reinitialise the scene to new data if successful
@@ -1340,39 +1336,15 @@ int CMapReader::LoadRMSettings()
 	return 0;
 }
 
-struct CMapReader::GeneratorState
-{
-	std::atomic<int> progress{1};
-	Future<Script::StructuredClone> task;
-};
-
 int CMapReader::StartMapGeneration(const CStrW& scriptFile)
 {
 	ScriptRequest rq(pSimulation2->GetScriptInterface());
 
-	m_GeneratorState = std::make_unique<GeneratorState>();
+	const VfsPath scriptPath{scriptFile.empty() ? L"" :
+		static_cast<std::wstring>(RANDOM_MAP_PREFIX) + scriptFile};
 
 	// The settings are stringified to pass them to the task.
-	m_GeneratorState->task = g_TaskManager.PushTask(
-		[&progress = m_GeneratorState->progress, scriptFile,
-			settings = Script::StringifyJSON(rq, &m_ScriptSettings)](const StopToken stopToken)
-		{
-			PROFILE2("Map Generation");
-
-			const VfsPath scriptPath{scriptFile.empty() ? L"" :
-				static_cast<std::wstring>(RANDOM_MAP_PREFIX) + scriptFile};
-
-			const std::shared_ptr<ScriptContext> mapgenContext{ScriptContext::CreateContext(
-				MAP_GENERATION_CONTEXT_SIZE)};
-
-			ScriptInterface mapgenInterface{"Engine", "MapGenerator", mapgenContext,
-				[](const VfsPath& path){
-					// Only allow to load modules inside the maps folder.
-					return path.string().find(RANDOM_MAP_PREFIX) == 0;
-				}};
-
-			return RunMapGenerationScript(stopToken, progress, mapgenInterface, scriptPath, settings);
-		});
+	m_GeneratorState = StartMapGenerationTask(scriptPath, Script::StringifyJSON(rq, &m_ScriptSettings));
 
 	return 0;
 }
@@ -1393,10 +1365,10 @@ int CMapReader::PollMapGeneration()
 		return -1;
 	}
 
-	if (!m_GeneratorState->task.IsDone())
+	if (!m_GeneratorState->result.IsDone())
 		return m_GeneratorState->progress.load();
 
-	const Script::StructuredClone results{m_GeneratorState->task.Get()};
+	const Script::StructuredClone results{m_GeneratorState->result.Get()};
 	if (!results)
 		ThrowMapGenerationError();
 
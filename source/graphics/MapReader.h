@@ -1,4 +1,4 @@
-/* Copyright (C) 2023 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * 本文件是 0 A.D. 的一部分。
  *
  * 0 A.D. 是自由软件：您可以根据自由软件基金会发布的 GNU 通用公共许可证
@@ -38,6 +38,7 @@ class CSimContext;
 class CTerrainTextureEntry;
 class CGameView;
 class CXMLReader;
+struct MapGenerationTask;
 class ScriptContext;
 class ScriptInterface;
 
@@ -129,8 +130,7 @@ private:
 	JS::PersistentRootedValue m_MapData;        // 地图数据的持久化JS值
 
 	// 地图生成器状态结构体
-	struct GeneratorState;
-	std::unique_ptr<GeneratorState> m_GeneratorState; // 指向生成器状态的智能指针
+	std::unique_ptr<MapGenerationTask> m_GeneratorState; // 指向生成器状态的智能指针
 
 	CFileUnpacker unpacker; // 文件解包器
 	CTerrain* pTerrain; // 指向地形对象的指针
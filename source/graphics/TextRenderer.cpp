@@ -37,6 +37,29 @@ namespace
 // We can't draw chars more than vertices, currently we use 4 vertices per char.
 constexpr size_t MAX_CHAR_COUNT_PER_BATCH = 65536 / 4;
 
+/**
+ * Every glyph is a quad with the same index pattern, so the index data
+ * doesn't depend on the text and is generated only once.
+ */
+const std::vector<u16>& GetGlyphQuadIndices()
+{
+	static const std::vector<u16> indices = []()
+	{
+		std::vector<u16> quadIndices(MAX_CHAR_COUNT_PER_BATCH * 6);
+		for (size_t idx = 0; idx < MAX_CHAR_COUNT_PER_BATCH; ++idx)
+		{
+			quadIndices[idx * 6 + 0] = static_cast<u16>(idx * 4 + 0);
+			quadIndices[idx * 6 + 1] = static_cast<u16>(idx * 4 + 1);
+			quadIndices[idx * 6 + 2] = static_cast<u16>(idx * 4 + 2);
+			quadIndices[idx * 6 + 3] = static_cast<u16>(idx * 4 + 2);
+			quadIndices[idx * 6 + 4] = static_cast<u16>(idx * 4 + 3);
+			quadIndices[idx * 6 + 5] = static_cast<u16>(idx * 4 + 0);
+		}
+		return quadIndices;
+	}();
+	return indices;
+}
+
 } // anonymous namespace
 
 CTextRenderer::CTextRenderer()
@@ -199,7 +222,7 @@ void CTextRenderer::Render(
 	Renderer::Backend::IShaderProgram* shader,
 	const CVector2D& transformScale, const CVector2D& translation)
 {
-	std::vector<u16> indices;
+	const std::vector<u16>& indices = GetGlyphQuadIndices();
 	std::vector<CVector2D> positions;
 	std::vector<CVector2D> uvs;
 
@@ -267,7 +290,6 @@ void CTextRenderer::Render(
 
 		positions.resize(std::min(MAX_CHAR_COUNT_PER_BATCH, batch.chars) * 4);
 		uvs.resize(std::min(MAX_CHAR_COUNT_PER_BATCH, batch.chars) * 4);
-		indices.resize(std::min(MAX_CHAR_COUNT_PER_BATCH, batch.chars) * 6);
 
 		size_t idx = 0;
 
@@ -281,7 +303,7 @@ void CTextRenderer::Render(
 			deviceCommandContext->SetVertexBufferData(
 				1, uvs.data(), uvs.size() * sizeof(uvs[0]));
 			deviceCommandContext->SetIndexBufferData(
-				indices.data(), indices.size() * sizeof(indices[0]));
+				indices.data(), idx * 6 * sizeof(indices[0]));
 
 			deviceCommandContext->DrawIndexed(0, idx * 6, 0);
 			idx = 0;
@@ -324,13 +346,6 @@ void CTextRenderer::Render(
 				positions[idx*4+3].X = g->x1 + x;
 				positions[idx*4+3].Y = g->y1 + y;
 
-				indices[idx*6+0] = static_cast<u16>(idx*4+0);
-				indices[idx*6+1] = static_cast<u16>(idx*4+1);
-				indices[idx*6+2] = static_cast<u16>(idx*4+2);
-				indices[idx*6+3] = static_cast<u16>(idx*4+2);
-				indices[idx*6+4] = static_cast<u16>(idx*4+3);
-				indices[idx*6+5] = static_cast<u16>(idx*4+0);
-
 				x += g->xadvance;
 
 				++idx;
@@ -16,12 +16,16 @@
  */
 
 #include "graphics/MapGenerator.h"
+#include "lib/timer.h"
 #include "ps/CLogger.h"
 #include "ps/Filesystem.h"
 #include "ps/Future.h"
 #include "simulation2/system/ComponentTest.h"
 
 #include <atomic>
+#include <fmt/format.h>
+#include <string>
+#include <vector>
 
 class TestMapGenerator : public CxxTest::TestSuite
 {
@@ -71,4 +75,42 @@ public:
 				TS_ASSERT_EQUALS(progress.load(), 50);
 		}
 	}
+
+	/**
+	 * Prints the generation time of some map scripts for several map sizes.
+	 */
+	void DISABLE_test_perf()
+	{
+		CXeromycesEngine xeromycesEngine;
+
+		const std::vector<VfsPath> scripts{
+			L"maps/random/mainland.js",
+			L"maps/random/continent.js"
+		};
+
+		for (const VfsPath& script : scripts)
+			for (const int size : { 128, 256, 512 })
+			{
+				ScriptInterface scriptInterface{"Engine", "MapGenerator", g_ScriptContext,
+					[](const VfsPath& path){
+						return path.string().find(RANDOM_MAP_PREFIX) == 0;
+					}};
+
+				const std::string settings{fmt::format(
+					"{{\"Seed\": 0, \"Size\": {}, \"Biome\": \"generic/temperate\", "
+					"\"CircularMap\": true, \"PlayerData\": [null, {{\"Civ\": \"athen\"}}, "
+					"{{\"Civ\": \"spart\"}}]}}", size)};
+
+				std::atomic<int> progress{1};
+				std::atomic<bool> stopRequest{false};
+				const double start = timer_Time();
+				const Script::StructuredClone result{RunMapGenerationScript(StopToken{stopRequest},
+					progress, scriptInterface, script, settings,
+					JSPROP_ENUMERATE | JSPROP_PERMANENT)};
+				const double elapsed = timer_Time() - start;
+
+				TS_ASSERT_DIFFERS(result, nullptr);
+				debug_printf("%s, size %d: %.2f s\n", script.string8().c_str(), size, elapsed);
+			}
+	}
 };
@@ -81,7 +81,11 @@ CGUIText::CGUIText(const CGUI& pGUI, const CGUIString& string, const CStrW& font
 	// word and the next. When we're wrapping, we need subtract the width of the
 	// space after the last word on the line before the wrap.
 	CFontMetrics currentFont(font);
-	float spaceWidth = currentFont.GetCharacterWidth(L' ');
+	const float spaceWidth = currentFont.GetCharacterWidth(L' ');
+
+	// Words are generated again for each line they're laid out on, so
+	// the metrics always match the current value of firstLine.
+	std::vector<SWordMetrics> wordMetrics(string.m_Words.size());
 
 	// Go through string word by word.
 	// a word is defined as [start, end[ in string.m_Words so we skip the last item.
@@ -98,6 +102,7 @@ CGUIText::CGUIText(const CGUI& pGUI, const CGUIString& string, const CStrW& font
 
 		// Width and height of all text calls generated.
 		string.GenerateTextCall(pGUI, feedback, font, string.m_Words[i], string.m_Words[i+1], firstLine);
+		wordMetrics[i] = {feedback.m_Size, feedback.m_NewLine, feedback.m_EndsWithSpace};
 
 		SetupSpriteCalls(pGUI, feedback.m_Images, y, width, bufferZone, i, posLastImage, images);
 
@@ -112,7 +117,7 @@ CGUIText::CGUIText(const CGUI& pGUI, const CGUIString& string, const CStrW& font
 		// If width is 0, then there's no word-wrapping, disable NewLine.
 		if ((width != 0 && ((from != i && lineWidth - spaceCorrection + 2 * bufferZone > width) || feedback.m_NewLine)) || i == static_cast<int>(string.m_Words.size()) - 2)
 		{
-			if (ProcessLine(pGUI, string, font, pObject, images, align, prelimLineHeight, width, bufferZone, firstLine, y, i, from))
+			if (ProcessLine(pGUI, string, font, pObject, images, wordMetrics, align, prelimLineHeight, width, bufferZone, spaceWidth, firstLine, y, i, from))
 				return;
 			lineWidth = 0.f;
 		}
@@ -167,12 +172,11 @@ void CGUIText::SetupSpriteCalls(
 //  couldn't be determined in the first loop (main loop)
 //  because it didn't regard images, so we don't know
 //  if all characters processed, will actually be involved
-//  in that line.
+//  in that line. The words were already measured by the main
+//  loop, so we don't need to generate their text calls again.
 void CGUIText::ComputeLineSize(
-	const CGUI& pGUI,
-	const CGUIString& string,
-	const CStrIntern& font,
-	const bool firstLine,
+	const std::vector<SWordMetrics>& wordMetrics,
+	const float spaceWidth,
 	const float width,
 	const float widthRangeFrom,
 	const float widthRangeTo,
@@ -183,29 +187,20 @@ void CGUIText::ComputeLineSize(
 	// The calculated width of each word includes the space between the current
 	// word and the next. When we're wrapping, we need subtract the width of the
 	// space after the last word on the line before the wrap.
-	CFontMetrics currentFont(font);
-	float spaceWidth = currentFont.GetCharacterWidth(L' ');
-
 	float spaceCorrection = 0.f;
 
 	float x = widthRangeFrom;
 	for (int j = tempFrom; j <= i; ++j)
 	{
-		// We don't want to use feedback now, so we'll have to use another one.
-		CGUIString::SFeedback feedback2;
-
-		// Don't attach object, it'll suppress the errors
-		//  we want them to be reported in the final GenerateTextCall()
-		//  so that we don't get duplicates.
-		string.GenerateTextCall(pGUI, feedback2, font, string.m_Words[j], string.m_Words[j+1], firstLine);
+		const SWordMetrics& metrics = wordMetrics[j];
 
 		// Append X value.
-		x += feedback2.m_Size.Width;
+		x += metrics.m_Size.Width;
 
-		const float currentSpaceCorrection = feedback2.m_EndsWithSpace ? spaceWidth : 0.0f;
+		const float currentSpaceCorrection = metrics.m_EndsWithSpace ? spaceWidth : 0.0f;
 
 		const bool isLineOverflow = x - currentSpaceCorrection > widthRangeTo;
-		if (width != 0 && isLineOverflow && j != tempFrom && !feedback2.m_NewLine)
+		if (width != 0 && isLineOverflow && j != tempFrom && !metrics.m_NewLine)
 			break;
 
 		// Update after the line-break detection, because otherwise spaceCorrection above
@@ -213,16 +208,16 @@ void CGUIText::ComputeLineSize(
 		spaceCorrection = currentSpaceCorrection;
 
 		// Let lineSize.cy be the maximum m_Height we encounter.
-		lineSize.Height = std::max(lineSize.Height, feedback2.m_Size.Height);
+		lineSize.Height = std::max(lineSize.Height, metrics.m_Size.Height);
 
 		// If the current word is an explicit new line ("\n"),
 		// break now before adding the width of this character.
 		// ("\n" doesn't have a glyph, thus is given the same width as
 		// the "missing glyph" character by CFont::GetCharacterWidth().)
-		if (width != 0 && feedback2.m_NewLine)
+		if (width != 0 && metrics.m_NewLine)
 			break;
 
-		lineSize.Width += feedback2.m_Size.Width;
+		lineSize.Width += metrics.m_Size.Width;
 	}
 	// Remove the space if necessary.
 	lineSize.Width -= spaceCorrection;
@@ -234,10 +229,12 @@ bool CGUIText::ProcessLine(
 	const CStrIntern& font,
 	const IGUIObject* pObject,
 	const SGenerateTextImages& images,
+	const std::vector<SWordMetrics>& wordMetrics,
 	const EAlign align,
 	const float prelimLineHeight,
 	const float width,
 	const float bufferZone,
+	const float spaceWidth,
 	bool& firstLine,
 	float& y,
 	int& i,
@@ -252,13 +249,13 @@ bool CGUIText::ProcessLine(
 	ComputeLineRange(images, y, width, prelimLineHeight, widthRangeFrom, widthRangeTo);
 
 	CSize2D lineSize;
-	ComputeLineSize(pGUI, string, font, firstLine, width, widthRangeFrom, widthRangeTo, i, tempFrom, lineSize);
+	ComputeLineSize(wordMetrics, spaceWidth, width, widthRangeFrom, widthRangeTo, i, tempFrom, lineSize);
 
 	// Move down, because font drawing starts from the baseline
 	y += lineSize.Height;
 
 	// Do the real processing now
-	const bool done = AssembleCalls(pGUI, string, font, pObject, firstLine, width, widthRangeTo, GetLineOffset(align, widthRangeFrom, widthRangeTo, lineSize), y, tempFrom, i, from);
+	const bool done = AssembleCalls(pGUI, string, font, pObject, firstLine, width, widthRangeTo, spaceWidth, GetLineOffset(align, widthRangeFrom, widthRangeTo, lineSize), y, tempFrom, i, from);
 
 	// Update dimensions
 	m_Size.Width = std::max(m_Size.Width, lineSize.Width + bufferZone * 2);
@@ -348,6 +345,7 @@ bool CGUIText::AssembleCalls(
 	const bool firstLine,
 	const float width,
 	const float widthRangeTo,
+	const float spaceWidth,
 	const float dx,
 	const float y,
 	const int tempFrom,
@@ -387,8 +385,6 @@ bool CGUIText::AssembleCalls(
 		{
 			// Check if we need to wrap, using the same algorithm as ComputeLineSize
 			// This means we must ignore the 'space before the next word' for the purposes of wrapping.
-			CFontMetrics currentFont(font);
-			float spaceWidth = currentFont.GetCharacterWidth(L' ');
 			float spaceCorrection = feedback2.m_EndsWithSpace ? spaceWidth : 0.f;
 
 			if (feedback2.m_NewLine)
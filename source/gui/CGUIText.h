@@ -1,4 +1,4 @@
-/* Copyright (C) 2022 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -138,6 +138,17 @@ public:
 		std::list<SSpriteCall>::pointer m_pSpriteCall;
 	};
 
+	/**
+	 * Measurements of a word, generated once per word and line in the
+	 * main layout pass and reused to compute the line size.
+	 */
+	struct SWordMetrics
+	{
+		CSize2D m_Size;
+		bool m_NewLine = false;
+		bool m_EndsWithSpace = false;
+	};
+
 	// The SSpriteCall CGUISpriteInstance makes this uncopyable to avoid invalidating its draw cache.
 	// Also take advantage of exchanging the containers directly with move semantics.
 	NONCOPYABLE(CGUIText);
@@ -184,10 +195,12 @@ public:
 		const CStrIntern& font,
 		const IGUIObject* pObject,
 		const SGenerateTextImages& images,
+		const std::vector<SWordMetrics>& wordMetrics,
 		const EAlign align,
 		const float prelimLineHeight,
 		const float width,
 		const float bufferZone,
+		const float spaceWidth,
 		bool& firstLine,
 		float& y,
 		int& i,
@@ -218,10 +231,8 @@ public:
 		float& widthRangeTo) const;
 
 	void ComputeLineSize(
-		const CGUI& pGUI,
-		const CGUIString& string,
-		const CStrIntern& font,
-		const bool firstLine,
+		const std::vector<SWordMetrics>& wordMetrics,
+		const float spaceWidth,
 		const float width,
 		const float widthRangeFrom,
 		const float widthRangeTo,
@@ -237,6 +248,7 @@ public:
 		const bool firstLine,
 		const float width,
 		const float widthRangeTo,
+		const float spaceWidth,
 		const float dx,
 		const float y,
 		const int tempFrom,
@@ -19,6 +19,7 @@
 
 #include "GUIManager.h"
 
+#include "graphics/Canvas2D.h"
 #include "gui/CGUI.h"
 #include "lib/timer.h"
 #include "lobby/IXmppClient.h"
@@ -434,8 +435,14 @@ void CGUIManager::Draw(CCanvas2D& canvas) const
 {
 	PROFILE3("gui");
 
+	const CCanvas2D::Stats statsBefore = canvas.GetStats();
+
 	for (const SGUIPage& p : m_PageStack)
 		p.gui->Draw(canvas);
+
+	const CCanvas2D::Stats& statsAfter = canvas.GetStats();
+	PROFILE2_ATTR("draw requests: %zu", statsAfter.drawRequests - statsBefore.drawRequests);
+	PROFILE2_ATTR("batches: %zu", statsAfter.batches - statsBefore.batches);
 }
 
 void CGUIManager::UpdateResolution()
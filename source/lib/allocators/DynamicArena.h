@@ -39,6 +39,9 @@ namespace Allocators {
  * - can allocate objects up to BLOCK_SIZE in size
  * - can handle any aligment (up to BLOCK_SIZE)
  * - Doesn't de-allocate unless cleared or destroyed.
+ * - reset() makes all memory available again but keeps the blocks, so an
+ *   arena that is reset regularly (e.g. every frame) stops allocating once
+ *   it has reached its peak usage.
  */
 template<size_t BLOCK_SIZE>
 class DynamicArena
@@ -105,6 +108,16 @@ protected:
 			return ptr;
 		}
 
+		void Reset()
+		{
+			m_Size = 0;
+		}
+
+		size_t Size() const
+		{
+			return m_Size;
+		}
+
 	private:
 		size_t m_Size = 0;
 		uint8_t* m_Data = nullptr;
@@ -121,6 +134,7 @@ public:
 	void AllocateNewBlock()
 	{
 		m_Blocks.emplace_back();
+		m_CurrentBlock = m_Blocks.size() - 1;
 	}
 
 	void* allocate(size_t n, const void*, size_t alignment)
@@ -135,10 +149,16 @@ public:
 			throw std::bad_alloc();
 		}
 
-		if (!m_Blocks.back().Available(n, alignment))
-			AllocateNewBlock();
+		// Blocks after the current one are only there after a reset.
+		while (!m_Blocks[m_CurrentBlock].Available(n, alignment))
+		{
+			if (m_CurrentBlock + 1 == m_Blocks.size())
+				AllocateNewBlock();
+			else
+				++m_CurrentBlock;
+		}
 
-		return reinterpret_cast<void*>(m_Blocks.back().Allocate(n, alignment));
+		return reinterpret_cast<void*>(m_Blocks[m_CurrentBlock].Allocate(n, alignment));
 	}
 
 	void deallocate(void*, size_t)
@@ -152,8 +172,40 @@ public:
 		AllocateNewBlock();
 	}
 
+	/**
+	 * Make all memory available again without freeing the blocks.
+	 * All pointers returned before are invalidated.
+	 */
+	void reset()
+	{
+		for (Block& block : m_Blocks)
+			block.Reset();
+		m_CurrentBlock = 0;
+	}
+
+	/**
+	 * @return Number of blocks allocated from the heap.
+	 */
+	size_t GetNumberOfBlocks() const
+	{
+		return m_Blocks.size();
+	}
+
+	/**
+	 * @return Number of bytes used since the last reset or clear, including
+	 * alignment padding but not the unused ends of filled blocks.
+	 */
+	size_t GetUsedSize() const
+	{
+		size_t size = 0;
+		for (size_t i = 0; i <= m_CurrentBlock; ++i)
+			size += m_Blocks[i].Size();
+		return size;
+	}
+
 protected:
 	std::vector<Block> m_Blocks;
+	size_t m_CurrentBlock = 0;
 };
 
 } // namespace Allocators
@@ -1,4 +1,4 @@
-/* Copyright (C) 2021 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  *
  * Permission is hereby granted, free of charge, to any person obtaining
  * a copy of this software and associated documentation files (the
@@ -23,6 +23,9 @@
 #include "lib/self_test.h"
 
 #include "lib/allocators/DynamicArena.h"
+#include "lib/allocators/STLAllocators.h"
+
+#include <vector>
 
 class TestDynamicArena : public CxxTest::TestSuite
 {
@@ -72,4 +75,50 @@ public:
 		p2 = static_cast<u8*>(testArena.allocate(1, nullptr, 8));
 		TS_ASSERT_EQUALS(p + 32, p2);
 	}
+
+	void test_reset()
+	{
+		Allocators::DynamicArena<100> testArena;
+		void* p = testArena.allocate(60, nullptr, 1);
+		void* p2 = testArena.allocate(60, nullptr, 1);
+		TS_ASSERT_EQUALS(testArena.GetNumberOfBlocks(), 2u);
+		TS_ASSERT_EQUALS(testArena.GetUsedSize(), 120u);
+
+		// The same allocations after a reset reuse the same blocks.
+		testArena.reset();
+		TS_ASSERT_EQUALS(testArena.GetUsedSize(), 0u);
+		TS_ASSERT_EQUALS(testArena.allocate(60, nullptr, 1), p);
+		TS_ASSERT_EQUALS(testArena.allocate(60, nullptr, 1), p2);
+		TS_ASSERT_EQUALS(testArena.GetNumberOfBlocks(), 2u);
+
+		// Only growing beyond the previous peak allocates.
+		testArena.allocate(60, nullptr, 1);
+		TS_ASSERT_EQUALS(testArena.GetNumberOfBlocks(), 3u);
+
+		testArena.clear();
+		TS_ASSERT_EQUALS(testArena.GetNumberOfBlocks(), 1u);
+	}
+
+	void test_reset_containers()
+	{
+		using Arena = Allocators::DynamicArena<4 * KiB>;
+		Arena testArena;
+
+		// Simulates per-frame containers: after the first frame no more
+		// blocks are taken from the heap.
+		size_t blocksAfterFirstFrame = 0;
+		for (int frame = 0; frame < 10; ++frame)
+		{
+			{
+				std::vector<int, ProxyAllocator<int, Arena>> list((ProxyAllocator<int, Arena>(testArena)));
+				for (int i = 0; i < 1000; ++i)
+					list.push_back(i);
+				TS_ASSERT_EQUALS(list[999], 999);
+			}
+			if (frame == 0)
+				blocksAfterFirstFrame = testArena.GetNumberOfBlocks();
+			TS_ASSERT_EQUALS(testArena.GetNumberOfBlocks(), blocksAfterFirstFrame);
+			testArena.reset();
+		}
+	}
 };
@@ -27,6 +27,7 @@
 #include "precompiled.h"
 #include "lib/file/archive/archive_zip.h"
 
+#include <atomic>
 #include <time.h>
 #include <limits>
 
@@ -300,7 +301,7 @@ public:
 	ArchiveFile_Zip(const PFile& file, off_t ofs, off_t csize, u32 checksum, ZipMethod method)
 		: m_file(file), m_ofs(ofs)
 		, m_csize(csize), m_checksum(checksum), m_method((u16)method)
-		, m_flags(NeedsFixup)
+		, m_dataOfs(-1)
 	{
 	}
 
@@ -319,9 +320,19 @@ public:
 		return m_file->Pathname();
 	}
 
+	virtual Status Map(const OsPath& UNUSED(name), std::shared_ptr<u8>& buf, size_t size) const
+	{
+		// only stored entries can be used in place.
+		if(m_method != ZIP_METHOD_NONE)
+			return INFO::SKIPPED;
+		ENSURE(size == size_t(m_csize));
+
+		return FileMap(m_file->Descriptor(), DataOffset(), size, buf);
+	}
+
 	virtual Status Load(const OsPath& UNUSED(name), const std::shared_ptr<u8>& buf, size_t size) const
 	{
-		AdjustOffset();
+		const off_t dataOfs = DataOffset();
 
 		PICodec codec;
 		switch(m_method)
@@ -338,7 +349,7 @@ public:
 
 		Stream stream(codec);
 		stream.SetOutputBuffer(buf.get(), size);
-		io::Operation op(*m_file.get(), 0, m_csize, m_ofs);
+		io::Operation op(*m_file.get(), 0, m_csize, dataOfs);
 		StreamFeeder streamFeeder(stream);
 		RETURN_STATUS_IF_ERR(io::Run(op, io::Parameters(), streamFeeder));
 		RETURN_STATUS_IF_ERR(stream.Finish());
@@ -350,21 +361,6 @@ public:
 	}
 
 private:
-	enum Flags
-	{
-		// indicates m_ofs points to a "local file header" instead of
-		// the file data. a fixup routine is called when reading the file;
-		// it skips past the LFH and clears this flag.
-		// this is somewhat of a hack, but vital to archive open performance.
-		// without it, we'd have to scan through the entire archive file,
-		// which can take *seconds*.
-		// (we cannot use the information in CDFH, because its 'extra' field
-		// has been observed to differ from that of the LFH)
-		// since we read the LFH right before the rest of the file, the block
-		// cache will absorb the IO cost.
-		NeedsFixup = 1
-	};
-
 	struct LFH_Copier
 	{
 		LFH_Copier(u8* lfh_dst, size_t lfh_bytes_remaining)
@@ -394,38 +390,48 @@ private:
 	};
 
 	/**
-	 * fix up m_ofs (adjust it to point to cdata instead of the LFH).
+	 * @return offset of the file data, i.e. m_ofs (which points to the
+	 * "local file header") adjusted to skip past the LFH.
 	 *
 	 * note: we cannot use CDFH filename and extra field lengths to skip
 	 * past LFH since that may not mirror CDFH (has happened).
 	 *
-	 * this is called at file-open time instead of while mounting to
+	 * this is computed at file-open time instead of while mounting to
 	 * reduce seeks: since reading the file will typically follow, the
-	 * block cache entirely absorbs the IO cost.
+	 * block cache entirely absorbs the IO cost. without it, we'd have to
+	 * scan through the entire archive file, which can take *seconds*.
+	 *
+	 * the VFS loads files concurrently; threads racing here compute the
+	 * same value, so it's enough to publish it atomically.
 	 **/
-	void AdjustOffset() const
+	off_t DataOffset() const
 	{
-		if(!(m_flags & NeedsFixup))
-			return;
-		m_flags &= ~NeedsFixup;
+		off_t dataOfs = m_dataOfs.load(std::memory_order_acquire);
+		if(dataOfs >= 0)
+			return dataOfs;
 
 		// performance note: this ends up reading one file block, which is
 		// only in the block cache if the file starts in the same block as a
 		// previously read file (i.e. both are small).
 		LFH lfh;
 		io::Operation op(*m_file.get(), 0, sizeof(LFH), m_ofs);
+		dataOfs = m_ofs;
 		if(io::Run(op, io::Parameters(), LFH_Copier((u8*)&lfh, sizeof(LFH))) == INFO::OK)
-			m_ofs += (off_t)lfh.Size();
+			dataOfs += (off_t)lfh.Size();
+		m_dataOfs.store(dataOfs, std::memory_order_release);
+		return dataOfs;
 	}
 
 	PFile m_file;
 
 	// all relevant LFH/CDFH fields not covered by CFileInfo
-	mutable off_t m_ofs;
+	off_t m_ofs;
 	off_t m_csize;
 	u32 m_checksum;
 	u16 m_method;
-	mutable u16 m_flags;
+
+	// offset of the file data, -1 until DataOffset has read the LFH.
+	mutable std::atomic<off_t> m_dataOfs;
 };
 
 
@@ -22,6 +22,7 @@
 
 #include "lib/self_test.h"
 
+#include "lib/allocators/shared_ptr.h"
 #include "lib/file/archive/archive_zip.h"
 #include "lib/file/file_system.h"
 #include "lib/file/io/io.h"
@@ -29,12 +30,21 @@
 
 #include <iterator>
 #include <string>
+#include <vector>
 
 namespace
 {
 	// Implementation of the static buffer used to communicate with ArchiveEntryCallback
 	std::string g_ResultBuffer;
 
+	struct ArchiveEntry
+	{
+		std::string pathname;
+		size_t size;
+		PIArchiveFile file;
+	};
+	std::vector<ArchiveEntry> g_Entries;
+
 	static OsPath MOD_PATH(DataDir() / "mods" / "_test.lib" / "");
 }
 
@@ -103,7 +113,71 @@ public:
 		TS_ASSERT_EQUALS("buildzipwithcomment.sh", g_ResultBuffer);
 	}
 
+	void test_map_stored_entry()
+	{
+		OsPath testDir = MOD_PATH / "file" / "archive";
+		OsPath testPath = testDir / "test_map.zip";
+		TS_ASSERT_EQUALS(INFO::OK, CreateDirectories(testDir, 0700, false));
+
+		// Large enough that the stored entry doesn't start on a mapping boundary.
+		std::vector<u8> contents(100*KiB);
+		for (size_t i = 0; i < contents.size(); ++i)
+			contents[i] = u8(i * 7 + i / 256);
+
+		{
+			PIArchiveWriter writer = CreateArchiveWriter_Zip(testPath, false);
+			TS_ASSERT_DIFFERS(nullptr, writer);
+			// PNGs are stored, other files deflated.
+			TS_ASSERT_OK(writer->AddMemory(contents.data(), contents.size(), time(0), L"first.txt"));
+			TS_ASSERT_OK(writer->AddMemory(contents.data(), contents.size(), time(0), L"stored.png"));
+		}
+
+		PIArchiveReader reader = CreateArchiveReader_Zip(testPath);
+		TS_ASSERT_DIFFERS(nullptr, reader);
+		g_Entries.clear();
+		TS_ASSERT_OK(reader->ReadEntries(TestArchiveZip::CollectEntryCallback, 0));
+		TS_ASSERT_EQUALS(g_Entries.size(), 2u);
+
+		for (const ArchiveEntry& entry : g_Entries)
+		{
+			TS_ASSERT_EQUALS(entry.size, contents.size());
+			std::shared_ptr<u8> buf;
+			const Status ret = entry.file->Map(L"", buf, entry.size);
+			if (entry.pathname == "stored.png")
+				TS_ASSERT_OK(ret);
+			else
+			{
+				TS_ASSERT_EQUALS(ret, INFO::SKIPPED);
+				TS_ASSERT_OK(AllocateAligned(buf, entry.size));
+				TS_ASSERT_OK(entry.file->Load(L"", buf, entry.size));
+			}
+			TS_ASSERT_SAME_DATA(buf.get(), contents.data(), contents.size());
+
+			// Mappings are copy-on-write.
+			buf.get()[0] = contents[0] + 1;
+		}
+		g_Entries.clear();
+		reader.reset();
+
+		std::shared_ptr<u8> stored;
+		reader = CreateArchiveReader_Zip(testPath);
+		TS_ASSERT_OK(reader->ReadEntries(TestArchiveZip::CollectEntryCallback, 0));
+		for (const ArchiveEntry& entry : g_Entries)
+			if (entry.pathname == "stored.png")
+				TS_ASSERT_OK(entry.file->Map(L"", stored, entry.size));
+		g_Entries.clear();
+		reader.reset();
+		// The mapping outlives the reader and its file.
+		TS_ASSERT_SAME_DATA(stored.get(), contents.data(), contents.size());
+	}
+
 private:
+	static void CollectEntryCallback(const VfsPath& path, const CFileInfo& fileInfo, PIArchiveFile archiveFile,
+		uintptr_t UNUSED(cbData))
+	{
+		g_Entries.push_back({path.string8(), size_t(fileInfo.Size()), archiveFile});
+	}
+
 	static void ArchiveEntryCallback(const VfsPath& path, const CFileInfo&, PIArchiveFile,
 		uintptr_t UNUSED(cbData))
 	{
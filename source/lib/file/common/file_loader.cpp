@@ -26,3 +26,8 @@
 /*virtual*/ IFileLoader::~IFileLoader()
 {
 }
+
+/*virtual*/ Status IFileLoader::Map(const OsPath& UNUSED(name), std::shared_ptr<u8>& UNUSED(buf), size_t UNUSED(size)) const
+{
+	return INFO::SKIPPED;
+}
@@ -39,6 +39,15 @@ struct IFileLoader
 	virtual OsPath Path() const = 0;
 
 	virtual Status Load(const OsPath& name, const std::shared_ptr<u8>& buf, size_t size) const = 0;
+
+	/**
+	 * make the contents available without copying them, if possible
+	 * (e.g. by mapping them into memory).
+	 * @param buf receives the contents.
+	 * @return INFO::OK if buf holds the contents, INFO::SKIPPED if the
+	 * caller should Load the file instead, or a negative error code.
+	 **/
+	virtual Status Map(const OsPath& name, std::shared_ptr<u8>& buf, size_t size) const;
 };
 
 typedef std::shared_ptr<IFileLoader> PIFileLoader;
@@ -26,6 +26,7 @@
 #include "lib/sysdep/filesystem.h"
 #include "lib/file/file.h"
 #include "lib/file/io/io.h"
+#include "lib/file/vfs/vfs.h"	// VFS_MOUNT_MAP_FILES
 
 
 RealDirectory::RealDirectory(const OsPath& path, size_t priority, size_t flags)
@@ -53,6 +54,19 @@ RealDirectory::RealDirectory(const OsPath& path, size_t priority, size_t flags)
 }
 
 
+/*virtual*/ Status RealDirectory::Map(const OsPath& name, std::shared_ptr<u8>& buf, size_t size) const
+{
+	// files in other directories may be rewritten while a mapping exists
+	// (truncating a mapped file raises SIGBUS on access).
+	if(!(m_flags & VFS_MOUNT_MAP_FILES))
+		return INFO::SKIPPED;
+
+	File file;
+	RETURN_STATUS_IF_ERR(file.Open(m_path / name, O_RDONLY));
+	return FileMap(file.Descriptor(), 0, size, buf);
+}
+
+
 Status RealDirectory::Store(const OsPath& name, const std::shared_ptr<u8>& fileContents, size_t size)
 {
 	return io::Store(m_path / name, fileContents.get(), size);
@@ -57,6 +57,8 @@ public:
 		return m_path;
 	}
 	virtual Status Load(const OsPath& name, const std::shared_ptr<u8>& buf, size_t size) const;
+	// only maps files if mounted with VFS_MOUNT_MAP_FILES.
+	virtual Status Map(const OsPath& name, std::shared_ptr<u8>& buf, size_t size) const;
 
 	Status Store(const OsPath& name, const std::shared_ptr<u8>& fileContents, size_t size);
 
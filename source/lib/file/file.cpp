@@ -27,7 +27,9 @@
 #include "precompiled.h"
 #include "lib/file/file.h"
 
+#include "lib/alignment.h"
 #include "lib/file/common/file_stats.h"
+#include "lib/posix/posix_mman.h"
 
 static const StatusDefinition fileStatusDefinitions[] = {
 	{ ERR::FILE_ACCESS, L"Insufficient access rights to open file", EACCES },
@@ -61,3 +63,37 @@ void FileClose(int& fd)
 		fd = -1;
 	}
 }
+
+
+// mapping offsets must be a multiple of the allocation granularity,
+// which is 64 KiB on Windows (i.e. larger than the page size).
+static const off_t mapAlignment = 64*KiB;
+
+struct MappingDeleter
+{
+	MappingDeleter(void* base, size_t size)
+		: base(base), size(size)
+	{
+	}
+
+	void operator()(u8*) const
+	{
+		(void)munmap(base, size);
+	}
+
+	void* base;
+	size_t size;
+};
+
+Status FileMap(int fd, off_t ofs, size_t size, std::shared_ptr<u8>& p)
+{
+	ENSURE(size != 0);
+	const off_t alignedOfs = ofs - ofs % mapAlignment;
+	const size_t mappedSize = size + size_t(ofs - alignedOfs);
+	void* base = mmap(0, mappedSize, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, alignedOfs);
+	if(base == MAP_FAILED)
+		return StatusFromErrno();	// NOWARN
+
+	p.reset((u8*)base + (ofs - alignedOfs), MappingDeleter(base, mappedSize));
+	return INFO::OK;
+}
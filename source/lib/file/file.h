@@ -30,6 +30,8 @@
 #include "lib/os_path.h"
 #include "lib/sysdep/filesystem.h"	// O_*, S_*
 
+#include <memory>
+
 namespace ERR
 {
 	const Status FILE_ACCESS = -110300;
@@ -42,6 +44,22 @@ namespace ERR
 Status FileOpen(const OsPath& pathname, int oflag);
 void FileClose(int& fd);
 
+/**
+ * map a range of an open file into memory.
+ *
+ * the mapping is private (copy-on-write), so the contents may be modified
+ * without affecting the file. the file must not be truncated while the
+ * mapping exists, though.
+ *
+ * @param fd file descriptor (may be closed afterwards)
+ * @param ofs offset of the range; need not be aligned.
+ * @param size [bytes] of the range (nonzero)
+ * @param p receives the contents; they are unmapped when the last
+ *		  reference goes away.
+ * @return Status
+ **/
+Status FileMap(int fd, off_t ofs, size_t size, std::shared_ptr<u8>& p);
+
 class File
 {
 public:
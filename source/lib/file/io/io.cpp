@@ -51,10 +51,10 @@ Status Issue(aiocb& cb, size_t queueDepth)
 	UNUSED2(queueDepth);
 #endif
 	{
-		ENSURE(lseek(cb.aio_fildes, cb.aio_offset, SEEK_SET) == cb.aio_offset);
-
+		// use positional IO rather than lseek+read: the file position is
+		// shared, and VFS loads from the same archive may run concurrently.
 		void* buf = (void*)cb.aio_buf;	// cast from volatile void*
-		const ssize_t bytesTransferred = (cb.aio_lio_opcode == LIO_WRITE)? write(cb.aio_fildes, buf, cb.aio_nbytes) : read(cb.aio_fildes, buf, cb.aio_nbytes);
+		const ssize_t bytesTransferred = (cb.aio_lio_opcode == LIO_WRITE)? pwrite(cb.aio_fildes, buf, cb.aio_nbytes, cb.aio_offset) : pread(cb.aio_fildes, buf, cb.aio_nbytes, cb.aio_offset);
 		if(bytesTransferred < 0)
 			WARN_RETURN(StatusFromErrno());
 
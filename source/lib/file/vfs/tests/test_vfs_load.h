@@ -0,0 +1,213 @@
+/* Copyright (C) 2025 Wildfire Games.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "lib/self_test.h"
+
+#include "lib/allocators/shared_ptr.h"
+#include "lib/file/archive/archive_zip.h"
+#include "lib/file/vfs/vfs.h"
+#include "lib/file/vfs/vfs_util.h"
+#include "lib/os_path.h"
+#include "lib/timer.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static OsPath TEST_LOAD_FOLDER(DataDir()/"_test.load.temp");
+
+class TestVfsConcurrentLoad : public CxxTest::TestSuite
+{
+	static constexpr size_t NUM_FILES = 64;
+
+	static VfsPath FileName(size_t i)
+	{
+		return VfsPath(L"dir_" + std::to_wstring(i % 4)) / (L"file_" + std::to_wstring(i) + L".txt");
+	}
+
+	// Load every file in @a pathnames from @a numThreads threads at once.
+	// @return number of files that failed to load.
+	static size_t LoadConcurrently(const PIVFS& fs, const VfsPaths& pathnames, size_t numThreads, size_t* loadedBytes = nullptr)
+	{
+		std::atomic<size_t> failures{0};
+		std::atomic<size_t> bytes{0};
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < numThreads; ++t)
+			threads.emplace_back([&, t]()
+			{
+				// Start each thread at a different file, so they don't all hit the same one.
+				for (size_t i = 0; i < pathnames.size(); ++i)
+				{
+					std::shared_ptr<u8> buf;
+					size_t size = 0;
+					if (fs->LoadFile(pathnames[(i + t * 7) % pathnames.size()], buf, size) != INFO::OK)
+						++failures;
+					bytes += size;
+				}
+			});
+		for (std::thread& thread : threads)
+			thread.join();
+		if (loadedBytes)
+			*loadedBytes = bytes;
+		return failures;
+	}
+
+public:
+	void setUp()
+	{
+		if (DirectoryExists(TEST_LOAD_FOLDER))
+			DeleteDirectory(TEST_LOAD_FOLDER);
+		CreateDirectories(TEST_LOAD_FOLDER, 0700, false);
+
+		PIVFS fs = CreateVfs();
+		TS_ASSERT_OK(fs->Mount(L"", TEST_LOAD_FOLDER / ""));
+		for (size_t i = 0; i < NUM_FILES; ++i)
+		{
+			const std::string contents = "contents of file " + std::to_string(i);
+			std::shared_ptr<u8> buf(new u8[contents.size()], ArrayDeleter());
+			memcpy(buf.get(), contents.data(), contents.size());
+			TS_ASSERT_OK(fs->CreateFile(FileName(i), buf, contents.size()));
+		}
+	}
+
+	void tearDown()
+	{
+		DeleteDirectory(TEST_LOAD_FOLDER);
+	}
+
+	void test_concurrent_load()
+	{
+		// A fresh VFS, so that the first lookups have to populate the directories
+		// while other threads are already looking up files.
+		PIVFS fs = CreateVfs();
+		TS_ASSERT_OK(fs->Mount(L"", TEST_LOAD_FOLDER / ""));
+
+		VfsPaths pathnames;
+		for (size_t i = 0; i < NUM_FILES; ++i)
+			pathnames.push_back(FileName(i));
+
+		TS_ASSERT_EQUALS(LoadConcurrently(fs, pathnames, 8), (size_t)0);
+
+		for (size_t i = 0; i < NUM_FILES; ++i)
+		{
+			std::shared_ptr<u8> buf;
+			size_t size;
+			TS_ASSERT_OK(fs->LoadFile(FileName(i), buf, size));
+			TS_ASSERT_STR_EQUALS(std::string((const char*)buf.get(), size), "contents of file " + std::to_string(i));
+		}
+
+		std::shared_ptr<u8> buf;
+		size_t size;
+		TS_ASSERT_EQUALS(fs->LoadFile(L"dir_0/missing.txt", buf, size), ERR::VFS_FILE_NOT_FOUND);
+		TS_ASSERT_EQUALS(fs->LoadFile(L"missing_dir/file.txt", buf, size), ERR::VFS_DIR_NOT_FOUND);
+	}
+
+	void test_concurrent_load_archive()
+	{
+		// Loads of entries from the same archive share its file descriptor.
+		const OsPath archiveDir = TEST_LOAD_FOLDER / "archive" / "";
+		TS_ASSERT_OK(CreateDirectories(archiveDir, 0700, false));
+
+		// Each entry is small enough to be read rather than mapped, and
+		// large enough to take several reads when deflated.
+		const auto contents = [](size_t i)
+		{
+			std::vector<u8> data(16*KiB);
+			for (size_t k = 0; k < data.size(); ++k)
+				data[k] = u8(i * 31 + k * 7 + k / 251);
+			return data;
+		};
+
+		VfsPaths pathnames;
+		{
+			PIArchiveWriter writer = CreateArchiveWriter_Zip(archiveDir / "test.zip", false);
+			TS_ASSERT_DIFFERS(writer, nullptr);
+			for (size_t i = 0; i < NUM_FILES; ++i)
+			{
+				// PNGs are stored, other files deflated.
+				const VfsPath pathname = FileName(i).ChangeExtension(i % 2 ? L".png" : L".txt");
+				const std::vector<u8> data = contents(i);
+				TS_ASSERT_OK(writer->AddMemory(data.data(), data.size(), time(0), OsPath(pathname.string())));
+				pathnames.push_back(pathname);
+			}
+		}
+
+		PIVFS fs = CreateVfs();
+		TS_ASSERT_OK(fs->Mount(L"", archiveDir));
+
+		std::atomic<size_t> mismatches{0};
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < 8; ++t)
+			threads.emplace_back([&, t]()
+			{
+				for (size_t n = 0; n < NUM_FILES * 4; ++n)
+				{
+					const size_t i = (n + t * 7) % NUM_FILES;
+					std::shared_ptr<u8> buf;
+					size_t size = 0;
+					const std::vector<u8> expected = contents(i);
+					if (fs->LoadFile(pathnames[i], buf, size) != INFO::OK || size != expected.size() ||
+						memcmp(buf.get(), expected.data(), size) != 0)
+						++mismatches;
+				}
+			});
+		for (std::thread& thread : threads)
+			thread.join();
+
+		TS_ASSERT_EQUALS(mismatches, (size_t)0);
+	}
+
+	/**
+	 * Measures how loading all files of the public mod (loose files or
+	 * public.zip) scales with the number of threads.
+	 */
+	void DISABLE_test_perf()
+	{
+		PIVFS fs = CreateVfs();
+		if (fs->Mount(L"", DataDir() / "mods" / "public" / "", VFS_MOUNT_MUST_EXIST) != INFO::OK)
+		{
+			debug_printf("Skipping VFS load benchmark (can't find binaries/data/mods/public/)\n");
+			return;
+		}
+
+		VfsPaths pathnames;
+		const auto addFile = [](const VfsPath& pathname, const CFileInfo& UNUSED(fileInfo), const uintptr_t cbData)
+		{
+			reinterpret_cast<VfsPaths*>(cbData)->push_back(pathname);
+			return INFO::OK;
+		};
+		TS_ASSERT_OK(vfs::ForEachFile(fs, L"", addFile, (uintptr_t)&pathnames, 0, vfs::DIR_RECURSIVE));
+
+		// Warm up the OS file cache, the benchmark is about the VFS itself.
+		LoadConcurrently(fs, pathnames, 1);
+
+		printf("Loading %zu files from the public mod\n", pathnames.size());
+		for (size_t numThreads = 1; numThreads <= std::max(std::thread::hardware_concurrency(), 1u); numThreads *= 2)
+		{
+			size_t bytes;
+			const double t = timer_Time();
+			TS_ASSERT_EQUALS(LoadConcurrently(fs, pathnames, numThreads, &bytes), (size_t)0);
+			const double tt = timer_Time() - t;
+			printf("%zu threads: %lfs, %lf MiB/s\n", numThreads, tt, bytes / tt / MiB);
+		}
+	}
+};
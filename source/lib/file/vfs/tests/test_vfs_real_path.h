@@ -1,4 +1,4 @@
-/* Copyright (C) 2021 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  *
  * Permission is hereby granted, free of charge, to any person obtaining
  * a copy of this software and associated documentation files (the
@@ -22,6 +22,7 @@
 
 #include "lib/self_test.h"
 
+#include "lib/file/archive/archive_zip.h"
 #include "lib/file/vfs/vfs.h"
 #include "lib/file/vfs/vfs_populate.h"
 #include "lib/os_path.h"
@@ -190,4 +191,75 @@ public:
 		g_VFS->GetDirectoryRealPath(L"folder/subfolder/", realPath);
 		TS_ASSERT_EQUALS(realPath, TEST_FOLDER / "other_folder" / "");
 	};
+
+	void test_populate_archives()
+	{
+		createRealDir(TEST_FOLDER / "mod_0");
+
+		// Entries are written with directories interleaved, so the
+		// populate step has to group them by directory.
+		const char* const pathnames[][4] = {
+			{ "a/1.txt", "b/c/2.txt", "a/3.txt", "a/b/4.txt" },
+			{ "b/5.txt", "a/6.txt", "b/c/7.txt", "a/b/8.txt" }
+		};
+		for (size_t i = 0; i < ARRAY_SIZE(pathnames); ++i)
+		{
+			PIArchiveWriter writer = CreateArchiveWriter_Zip(TEST_FOLDER / "mod_0" / (i == 0 ? "first.zip" : "second.zip"), false);
+			TS_ASSERT_DIFFERS(nullptr, writer);
+			for (const char* pathname : pathnames[i])
+				TS_ASSERT_OK(writer->AddMemory((const u8*)pathname, strlen(pathname), time(0), pathname));
+		}
+
+		TS_ASSERT_OK(g_VFS->Mount(L"", TEST_FOLDER / "mod_0" / "", 0, 0));
+
+		for (size_t i = 0; i < ARRAY_SIZE(pathnames); ++i)
+			for (const char* pathname : pathnames[i])
+			{
+				std::shared_ptr<u8> buf;
+				size_t size = 0;
+				TS_ASSERT_OK(g_VFS->LoadFile(pathname, buf, size));
+				TS_ASSERT_EQUALS(size, strlen(pathname));
+				TS_ASSERT_SAME_DATA(buf.get(), pathname, size);
+			}
+
+		CFileInfos files;
+		TS_ASSERT_OK(g_VFS->GetDirectoryEntries(L"a/", &files, nullptr));
+		TS_ASSERT_EQUALS(files.size(), 3u);
+		TS_ASSERT_OK(g_VFS->GetDirectoryEntries(L"b/c/", &files, nullptr));
+		TS_ASSERT_EQUALS(files.size(), 2u);
+	};
+
+	void test_prefetch_archives()
+	{
+		createRealDir(TEST_FOLDER / "mod_0");
+		createRealDir(TEST_FOLDER / "mod_1");
+
+		const char* const pathnames[][3] = {
+			{ "a/1.txt", "b/2.txt", "a/b/3.txt" },
+			{ "b/4.txt", "a.DELETED", "a/5.txt" }
+		};
+		for (size_t i = 0; i < ARRAY_SIZE(pathnames); ++i)
+		{
+			PIArchiveWriter writer = CreateArchiveWriter_Zip(TEST_FOLDER / (i == 0 ? "mod_0" : "mod_1") / "archive.zip", false);
+			TS_ASSERT_DIFFERS(nullptr, writer);
+			for (const char* pathname : pathnames[i])
+				TS_ASSERT_OK(writer->AddMemory((const u8*)pathname, strlen(pathname), time(0), pathname));
+		}
+
+		g_VFS->PrefetchArchives(TEST_FOLDER / "mod_0" / "");
+		g_VFS->PrefetchArchives(TEST_FOLDER / "mod_1" / "");
+		TS_ASSERT_OK(g_VFS->Mount(L"", TEST_FOLDER / "mod_0" / "", 0, 0));
+		TS_ASSERT_OK(g_VFS->Mount(L"", TEST_FOLDER / "mod_1" / "", 0, 1));
+
+		// a.DELETED removes the lower priority a/ of mod_0, but not the
+		// a/5.txt that comes after it in the same archive.
+		CFileInfos files;
+		TS_ASSERT_OK(g_VFS->GetDirectoryEntries(L"a/", &files, nullptr));
+		TS_ASSERT_EQUALS(files.size(), 1u);
+		TS_ASSERT_DIFFERS(g_VFS->GetFileInfo(L"a/1.txt", nullptr), INFO::OK);
+		TS_ASSERT_DIFFERS(g_VFS->GetFileInfo(L"a/b/3.txt", nullptr), INFO::OK);
+		TS_ASSERT_OK(g_VFS->GetFileInfo(L"a/5.txt", nullptr));
+		TS_ASSERT_OK(g_VFS->GetFileInfo(L"b/2.txt", nullptr));
+		TS_ASSERT_OK(g_VFS->GetFileInfo(L"b/4.txt", nullptr));
+	};
 };
@@ -34,6 +34,7 @@
 #include "lib/file/vfs/vfs_populate.h"
 
 #include <mutex>
+#include <shared_mutex>
 #include <thread>
 
 static const StatusDefinition vfsStatusDefinitions[] = {
@@ -43,7 +44,12 @@ static const StatusDefinition vfsStatusDefinitions[] = {
 };
 STATUS_ADD_DEFINITIONS(vfsStatusDefinitions);
 
-static std::mutex vfs_mutex;
+// Lookups that don't need to populate directories share the lock; anything
+// modifying the tree (mounting, populating, adding files, ...) is exclusive.
+static std::shared_mutex vfs_mutex;
+
+// smaller files are cheaper to copy than to map.
+static const size_t mapThreshold = 64*KiB;
 
 class VFS : public IVFS
 {
@@ -56,7 +62,7 @@ public:
 	{
 		ENSURE(path.IsDirectory());
 
-		std::lock_guard<std::mutex> lock(vfs_mutex);
+		std::lock_guard<std::shared_mutex> lock(vfs_mutex);
 		if(!DirectoryExists(path))
 		{
 			if(flags & VFS_MOUNT_MUST_EXIST)
@@ -73,62 +79,46 @@ public:
 		return INFO::OK;
 	}
 
-	virtual Status GetFileInfo(const VfsPath& pathname, CFileInfo* pfileInfo) const
+	virtual void PrefetchArchives(const OsPath& path)
 	{
-		std::lock_guard<std::mutex> lock(vfs_mutex);
-		VfsDirectory* directory;
-		VfsFile* file;
+		ENSURE(path.IsDirectory());
+		vfs_PrefetchArchives(path);
+	}
 
-		Status ret = vfs_Lookup(pathname, &m_rootDirectory, directory, &file);
-		if(!pfileInfo)	// just indicate if the file exists without raising warnings.
-			return ret;
-		WARN_RETURN_STATUS_IF_ERR(ret);
-		*pfileInfo = CFileInfo(file->Name(), file->Size(), file->MTime());
-		return INFO::OK;
+	virtual Status GetFileInfo(const VfsPath& pathname, CFileInfo* pfileInfo) const
+	{
+		return Lookup(pathname, true, [&](Status ret, VfsDirectory* UNUSED(directory), VfsFile* file)
+		{
+			if(!pfileInfo)	// just indicate if the file exists without raising warnings.
+				return ret;
+			WARN_RETURN_STATUS_IF_ERR(ret);
+			*pfileInfo = CFileInfo(file->Name(), file->Size(), file->MTime());
+			return INFO::OK;
+		});
 	}
 
 	virtual Status GetFilePriority(const VfsPath& pathname, size_t* ppriority) const
 	{
-		std::lock_guard<std::mutex> lock(vfs_mutex);
-		VfsDirectory* directory; VfsFile* file;
-		RETURN_STATUS_IF_ERR(vfs_Lookup(pathname, &m_rootDirectory, directory, &file));
-		*ppriority = file->Priority();
-		return INFO::OK;
+		return Lookup(pathname, true, [&](Status ret, VfsDirectory* UNUSED(directory), VfsFile* file)
+		{
+			RETURN_STATUS_IF_ERR(ret);
+			*ppriority = file->Priority();
+			return INFO::OK;
+		});
 	}
 
 	virtual Status GetDirectoryEntries(const VfsPath& path, CFileInfos* fileInfos, DirectoryNames* subdirectoryNames) const
 	{
-		std::lock_guard<std::mutex> lock(vfs_mutex);
-		VfsDirectory* directory;
-		RETURN_STATUS_IF_ERR(vfs_Lookup(path, &m_rootDirectory, directory, 0));
-
-		if(fileInfos)
+		return Lookup(path, false, [&](Status ret, VfsDirectory* directory, VfsFile* UNUSED(file))
 		{
-			const VfsDirectory::VfsFiles& files = directory->Files();
-			fileInfos->clear();
-			fileInfos->reserve(files.size());
-			for(VfsDirectory::VfsFiles::const_iterator it = files.begin(); it != files.end(); ++it)
-			{
-				const VfsFile& file = it->second;
-				fileInfos->push_back(CFileInfo(file.Name(), file.Size(), file.MTime()));
-			}
-		}
-
-		if(subdirectoryNames)
-		{
-			const VfsDirectory::VfsSubdirectories& subdirectories = directory->Subdirectories();
-			subdirectoryNames->clear();
-			subdirectoryNames->reserve(subdirectories.size());
-			for(VfsDirectory::VfsSubdirectories::const_iterator it = subdirectories.begin(); it != subdirectories.end(); ++it)
-				subdirectoryNames->push_back(it->first);
-		}
-
-		return INFO::OK;
+			RETURN_STATUS_IF_ERR(ret);
+			return ListDirectoryEntries(*directory, fileInfos, subdirectoryNames);
+		});
 	}
 
 	virtual Status CreateFile(const VfsPath& pathname, const std::shared_ptr<u8>& fileContents, size_t size)
 	{
-		std::lock_guard<std::mutex> lock(vfs_mutex);
+		std::lock_guard<std::shared_mutex> lock(vfs_mutex);
 		VfsDirectory* directory;
 		Status st;
 		st = vfs_Lookup(pathname, &m_rootDirectory, directory, 0, VFS_LOOKUP_ADD|VFS_LOOKUP_REAL_PATH);
@@ -150,19 +140,30 @@ public:
 
 	virtual Status LoadFile(const VfsPath& pathname, std::shared_ptr<u8>& fileContents, size_t& size)
 	{
-		std::lock_guard<std::mutex> lock(vfs_mutex);
-
-		VfsDirectory* directory; VfsFile* file;
+		PIFileLoader loader;
+		VfsPath name;
 		// per 2010-05-01 meeting, this shouldn't raise 'scary error
 		// dialogs', which might fail to display the culprit pathname
 		// instead, callers should log the error, including pathname.
-		RETURN_STATUS_IF_ERR(vfs_Lookup(pathname, &m_rootDirectory, directory, &file));
+		RETURN_STATUS_IF_ERR(Lookup(pathname, true, [&](Status ret, VfsDirectory* UNUSED(directory), VfsFile* file)
+		{
+			RETURN_STATUS_IF_ERR(ret);
+			loader = file->Loader();
+			name = file->Name();
+			size = file->Size();
+			return INFO::OK;
+		}));
 
+		// The loader is kept alive by our reference, so the (possibly slow)
+		// I/O and decompression don't need to hold the lock.
 		fileContents = DummySharedPtr((u8*)0);
-		size = file->Size();
 
-		RETURN_STATUS_IF_ERR(AllocateAligned(fileContents, size, maxSectorSize));
-		RETURN_STATUS_IF_ERR(file->Loader()->Load(file->Name(), fileContents, file->Size()));
+		// (if mapping fails for whatever reason, fall back to loading)
+		if(size < mapThreshold || loader->Map(name, fileContents, size) != INFO::OK)
+		{
+			RETURN_STATUS_IF_ERR(AllocateAligned(fileContents, size, maxSectorSize));
+			RETURN_STATUS_IF_ERR(loader->Load(name, fileContents, size));
+		}
 
 		stats_io_user_request(size);
 		m_trace->NotifyLoad(pathname, size);
@@ -172,7 +173,7 @@ public:
 
 	virtual std::wstring TextRepresentation() const
 	{
-		std::lock_guard<std::mutex> lock(vfs_mutex);
+		std::shared_lock<std::shared_mutex> lock(vfs_mutex);
 		std::wstring textRepresentation;
 		textRepresentation.reserve(100*KiB);
 		DirectoryDescriptionR(textRepresentation, m_rootDirectory, 0);
@@ -181,16 +182,17 @@ public:
 
 	virtual Status GetOriginalPath(const VfsPath& pathname, OsPath& realPathname)
 	{
-		std::lock_guard<std::mutex> lock(vfs_mutex);
-		VfsDirectory* directory; VfsFile* file;
-		WARN_RETURN_STATUS_IF_ERR(vfs_Lookup(pathname, &m_rootDirectory, directory, &file));
-		realPathname = file->Loader()->Path() / pathname.Filename();
-		return INFO::OK;
+		return Lookup(pathname, true, [&](Status ret, VfsDirectory* UNUSED(directory), VfsFile* file)
+		{
+			WARN_RETURN_STATUS_IF_ERR(ret);
+			realPathname = file->Loader()->Path() / pathname.Filename();
+			return INFO::OK;
+		});
 	}
 
 	virtual Status GetRealPath(const VfsPath& pathname, OsPath& realPathname, bool createMissingDirectories)
 	{
-		std::lock_guard<std::mutex> lock(vfs_mutex);
+		std::lock_guard<std::shared_mutex> lock(vfs_mutex);
 		VfsDirectory* directory; VfsFile* file;
 		size_t flags = VFS_LOOKUP_REAL_PATH | (createMissingDirectories ? VFS_LOOKUP_ADD : 0);
 		WARN_RETURN_STATUS_IF_ERR(vfs_Lookup(pathname, &m_rootDirectory, directory, &file, flags));
@@ -201,7 +203,7 @@ public:
 
 	virtual Status GetDirectoryRealPath(const VfsPath& pathname, OsPath& realPathname, bool createMissingDirectories)
 	{
-		std::lock_guard<std::mutex> lock(vfs_mutex);
+		std::lock_guard<std::shared_mutex> lock(vfs_mutex);
 		VfsDirectory* directory;
 		size_t flags = VFS_LOOKUP_REAL_PATH | (createMissingDirectories ? VFS_LOOKUP_ADD : 0);
 		WARN_RETURN_STATUS_IF_ERR(vfs_Lookup(pathname, &m_rootDirectory, directory, NULL, flags));
@@ -212,7 +214,7 @@ public:
 
 	virtual Status GetVirtualPath(const OsPath& realPathname, VfsPath& pathname)
 	{
-		std::lock_guard<std::mutex> lock(vfs_mutex);
+		std::shared_lock<std::shared_mutex> lock(vfs_mutex);
 		const OsPath realPath = realPathname.Parent()/"";
 		VfsPath path;
 		RETURN_STATUS_IF_ERR(FindRealPathR(realPath, m_rootDirectory, L"", path));
@@ -222,7 +224,7 @@ public:
 
 	virtual Status RemoveFile(const VfsPath& pathname)
 	{
-		std::lock_guard<std::mutex> lock(vfs_mutex);
+		std::lock_guard<std::shared_mutex> lock(vfs_mutex);
 
 		VfsDirectory* directory; VfsFile* file;
 		RETURN_STATUS_IF_ERR(vfs_Lookup(pathname, &m_rootDirectory, directory, &file));
@@ -233,7 +235,7 @@ public:
 
 	virtual Status RepopulateDirectory(const VfsPath& path)
 	{
-		std::lock_guard<std::mutex> lock(vfs_mutex);
+		std::lock_guard<std::shared_mutex> lock(vfs_mutex);
 
 		VfsDirectory* directory;
 		RETURN_STATUS_IF_ERR(vfs_Lookup(path, &m_rootDirectory, directory, 0));
@@ -244,11 +246,62 @@ public:
 
 	virtual void Clear()
 	{
-		std::lock_guard<std::mutex> lock(vfs_mutex);
+		std::lock_guard<std::shared_mutex> lock(vfs_mutex);
 		m_rootDirectory.Clear();
+		vfs_ClearPrefetchedArchives();
 	}
 
 private:
+	static Status ListDirectoryEntries(const VfsDirectory& directory, CFileInfos* fileInfos, DirectoryNames* subdirectoryNames)
+	{
+		if(fileInfos)
+		{
+			const VfsDirectory::VfsFiles& files = directory.Files();
+			fileInfos->clear();
+			fileInfos->reserve(files.size());
+			for(VfsDirectory::VfsFiles::const_iterator it = files.begin(); it != files.end(); ++it)
+			{
+				const VfsFile& file = it->second;
+				fileInfos->push_back(CFileInfo(file.Name(), file.Size(), file.MTime()));
+			}
+		}
+
+		if(subdirectoryNames)
+		{
+			const VfsDirectory::VfsSubdirectories& subdirectories = directory.Subdirectories();
+			subdirectoryNames->clear();
+			subdirectoryNames->reserve(subdirectories.size());
+			for(VfsDirectory::VfsSubdirectories::const_iterator it = subdirectories.begin(); it != subdirectories.end(); ++it)
+				subdirectoryNames->push_back(it->first);
+		}
+
+		return INFO::OK;
+	}
+
+	/**
+	 * Look up @a pathname and pass the result to @a callback(status, directory, file)
+	 * while the tree can't change. Paths whose directories are already populated are
+	 * looked up under the shared lock, so concurrent lookups don't wait for each other;
+	 * otherwise the lookup is repeated under the exclusive lock, populating as usual.
+	 * @param findFile whether @a pathname names a file (file is null otherwise).
+	 **/
+	template<typename Callback>
+	Status Lookup(const VfsPath& pathname, bool findFile, Callback callback) const
+	{
+		VfsDirectory* directory;
+		VfsFile* file = nullptr;
+		VfsFile** pfile = findFile ? &file : nullptr;
+		{
+			std::shared_lock<std::shared_mutex> lock(vfs_mutex);
+			const Status ret = vfs_Lookup(pathname, &m_rootDirectory, directory, pfile, VFS_LOOKUP_NO_POPULATE);
+			if(ret != INFO::SKIPPED)
+				return callback(ret, directory, file);
+		}
+
+		std::lock_guard<std::shared_mutex> lock(vfs_mutex);
+		return callback(vfs_Lookup(pathname, &m_rootDirectory, directory, pfile), directory, file);
+	}
+
 	Status FindRealPathR(const OsPath& realPath, const VfsDirectory& directory, const VfsPath& curPath, VfsPath& path)
 	{
 		PRealDirectory realDirectory = directory.AssociatedDirectory();
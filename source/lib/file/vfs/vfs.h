@@ -76,7 +76,15 @@ enum VfsMountFlags
 	 * ".DELETED" suffix will still apply.
 	 * (the default behavior is to hide both the suffixed and unsuffixed files)
 	 **/
-	VFS_MOUNT_KEEP_DELETED = 8
+	VFS_MOUNT_KEEP_DELETED = 8,
+
+	/**
+	 * let LoadFile map large files into memory instead of copying them.
+	 * only use this for directories whose files aren't modified while
+	 * the game runs (e.g. installed data): a mapped file must not be
+	 * truncated. archives are always eligible.
+	 **/
+	VFS_MOUNT_MAP_FILES = 16
 };
 
 // (member functions are thread-safe after the instance has been
@@ -107,6 +115,17 @@ struct IVFS
 	 **/
 	virtual Status Mount(const VfsPath& mountPoint, const OsPath& path, size_t flags = 0, size_t priority = 0) = 0;
 
+	/**
+	 * start reading the archives in a real directory in the background.
+	 *
+	 * @param path real directory path
+	 *
+	 * mounting the directory later uses what was read. calling this for
+	 * every directory before mounting them reads all their archives
+	 * concurrently rather than one directory at a time.
+	 **/
+	virtual void PrefetchArchives(const OsPath& path) = 0;
+
 	/**
 	 * Retrieve information about a file (similar to POSIX stat).
 	 *
@@ -153,6 +172,10 @@ struct IVFS
 	/**
 	 * Read an entire file into memory.
 	 *
+	 * Large files may be mapped instead of copied (stored archive entries,
+	 * directories mounted with VFS_MOUNT_MAP_FILES), so the contents aren't
+	 * necessarily sector-aligned. They may still be modified in place.
+	 *
 	 * @param pathname
 	 * @param fileContents receives a smart pointer to the contents.
 	 * @param size receives the size [bytes] of the file contents.
@@ -68,20 +68,35 @@ static Status CreateDirectory(const OsPath& path)
 }
 
 
+static Status PopulateIfAllowed(VfsDirectory* directory, bool skipPopulate, bool noPopulate)
+{
+	if (noPopulate)
+		return directory->NeedsPopulate() ? INFO::SKIPPED : INFO::OK;
+	if (skipPopulate)
+		return INFO::OK;
+	return vfs_Populate(directory);
+}
+
+
 Status vfs_Lookup(const VfsPath& pathname, VfsDirectory* startDirectory, VfsDirectory*& directory, VfsFile** pfile, size_t flags)
 {
 	// extract and validate flags (ensure no unknown bits are set)
 	const bool addMissingDirectories    = (flags & VFS_LOOKUP_ADD) != 0;
 	const bool skipPopulate = (flags & VFS_LOOKUP_SKIP_POPULATE) != 0;
 	const bool realPath = (flags & VFS_LOOKUP_REAL_PATH) != 0;
-	ENSURE((flags & ~(VFS_LOOKUP_ADD|VFS_LOOKUP_SKIP_POPULATE|VFS_LOOKUP_REAL_PATH)) == 0);
+	const bool noPopulate = (flags & VFS_LOOKUP_NO_POPULATE) != 0;
+	ENSURE((flags & ~(VFS_LOOKUP_ADD|VFS_LOOKUP_SKIP_POPULATE|VFS_LOOKUP_REAL_PATH|VFS_LOOKUP_NO_POPULATE)) == 0);
+	// (both of these may modify the tree)
+	ENSURE(!noPopulate || (!addMissingDirectories && !realPath));
 
 	directory = startDirectory;
 	if (pfile)
 		*pfile = 0;
 
-	if (!skipPopulate)
-		RETURN_STATUS_IF_ERR(vfs_Populate(directory));
+	// (not RETURN_STATUS_IF_ERR: INFO::SKIPPED must be returned as well)
+	Status ret = PopulateIfAllowed(directory, skipPopulate, noPopulate);
+	if (ret != INFO::OK)
+		return ret;
 
 	// early-out for pathname == "" when mounting into VFS root
 	if (pathname.empty())	// (prevent iterator error in loop end condition)
@@ -138,8 +153,9 @@ Status vfs_Lookup(const VfsPath& pathname, VfsDirectory* startDirectory, VfsDire
 			RETURN_STATUS_IF_ERR(vfs_Attach(subdirectory, realDirectory));
 		}
 
-		if (!skipPopulate)
-			RETURN_STATUS_IF_ERR(vfs_Populate(subdirectory));
+		ret = PopulateIfAllowed(subdirectory, skipPopulate, noPopulate);
+		if (ret != INFO::OK)
+			return ret;
 
 		directory = subdirectory;
 	}
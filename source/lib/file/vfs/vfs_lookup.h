@@ -57,7 +57,14 @@ enum VfsLookupFlags
 	// To make writing predictable, we'll return a path relative to the 'disk path' of the
 	// highest priority subdirectory found in the lookup path.
 	// See test_vfs_real_paths.h for examples of this behaviour.
-	VFS_LOOKUP_REAL_PATH = 4
+	VFS_LOOKUP_REAL_PATH = 4,
+
+	// Don't modify the tree at all, so that concurrent lookups are safe.
+	// If a directory encountered in the path still has to be populated,
+	// return INFO::SKIPPED; the caller should then repeat the lookup
+	// without this flag while holding exclusive access to the tree.
+	// Can't be combined with VFS_LOOKUP_ADD or VFS_LOOKUP_REAL_PATH.
+	VFS_LOOKUP_NO_POPULATE = 8
 };
 
 /**
@@ -69,7 +76,8 @@ enum VfsLookupFlags
  * @param pfile File is set to 0 if there is no name component, otherwise the
  *		  corresponding file.
  * @param flags @see VfsLookupFlags.
- * @return Status (INFO::OK if all components in pathname exist).
+ * @return Status (INFO::OK if all components in pathname exist,
+ *		  INFO::SKIPPED if VFS_LOOKUP_NO_POPULATE prevented the lookup).
  *
  * to allow noiseless file-existence queries, this does not raise warnings.
  **/
@@ -1,4 +1,4 @@
-/* Copyright (C) 2021 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  *
  * Permission is hereby granted, free of charge, to any person obtaining
  * a copy of this software and associated documentation files (the
@@ -32,6 +32,95 @@
 #include "lib/file/vfs/vfs_lookup.h"
 #include "lib/file/vfs/vfs.h"	// error codes
 
+#include <algorithm>
+#include <future>
+#include <map>
+#include <mutex>
+
+struct ArchiveEntry
+{
+	VfsPath pathname;
+	VfsPath directory;
+	CFileInfo fileInfo;
+	PIArchiveFile archiveFile;
+};
+
+typedef std::vector<ArchiveEntry> ArchiveEntries;
+
+struct ArchiveContents
+{
+	Status status = INFO::OK;
+	ArchiveEntries entries;
+};
+
+// sorts entries by their directory so that each one only has to be looked up
+// once. the order within a directory doesn't matter (see AddArchiveEntries).
+struct CompareArchiveEntryByDirectory
+{
+	bool operator()(const ArchiveEntry& a, const ArchiveEntry& b) const
+	{
+		return a.directory < b.directory;
+	}
+};
+
+static void CollectArchiveEntry(const VfsPath& pathname, const CFileInfo& fileInfo, PIArchiveFile archiveFile, uintptr_t cbData)
+{
+	ArchiveEntries* entries = (ArchiveEntries*)cbData;
+	entries->push_back({ pathname, pathname.Parent(), fileInfo, archiveFile });
+}
+
+// reads the central directory of an archive without touching the VFS tree,
+// which allows doing so for several archives at once.
+static ArchiveContents ReadArchive(const OsPath& pathname)
+{
+	ArchiveContents contents;
+
+	PIArchiveReader archiveReader = CreateArchiveReader_Zip(pathname);
+	// archiveReader == nullptr if file could not be opened (e.g. because
+	// archive is currently open in another program)
+	if(!archiveReader)
+		return contents;
+
+	contents.status = archiveReader->ReadEntries(CollectArchiveEntry, (uintptr_t)&contents.entries);
+	if(contents.status < 0)
+		return contents;
+
+	// .DELETED entries hide what was added before them, so they must stay
+	// in place: only the runs of entries between them are sorted.
+	ArchiveEntries& entries = contents.entries;
+	ArchiveEntries::iterator runBegin = entries.begin();
+	while(runBegin != entries.end())
+	{
+		const ArchiveEntries::iterator runEnd = std::find_if(runBegin, entries.end(), [](const ArchiveEntry& entry)
+		{
+			return entry.pathname.Extension() == L".DELETED";
+		});
+		std::stable_sort(runBegin, runEnd, CompareArchiveEntryByDirectory());
+		runBegin = runEnd == entries.end() ? runEnd : runEnd + 1;
+	}
+	return contents;
+}
+
+// archives whose central directory is being read in the background (see
+// vfs_PrefetchArchives), by pathname. they are removed once used.
+static std::mutex prefetchMutex;
+static std::map<OsPath, std::future<ArchiveContents>> prefetchedArchives;
+
+static std::future<ArchiveContents> ReadArchiveAsync(const OsPath& pathname)
+{
+	{
+		std::lock_guard<std::mutex> lock(prefetchMutex);
+		std::map<OsPath, std::future<ArchiveContents>>::iterator it = prefetchedArchives.find(pathname);
+		if(it != prefetchedArchives.end())
+		{
+			std::future<ArchiveContents> contents = std::move(it->second);
+			prefetchedArchives.erase(it);
+			return contents;
+		}
+	}
+	return std::async(std::launch::async, ReadArchive, pathname);
+}
+
 struct CompareFileInfoByName
 {
 	bool operator()(const CFileInfo& a, const CFileInfo& b)
@@ -85,48 +174,68 @@ private:
 		m_directory->AddFile(file);
 	}
 
-	static void AddArchiveFile(const VfsPath& pathname, const CFileInfo& fileInfo, PIArchiveFile archiveFile, uintptr_t cbData)
+	void AddArchiveEntries(const ArchiveEntries& entries) const
 	{
-		PopulateHelper* this_ = (PopulateHelper*)cbData;
-
+		// entries are grouped by directory, so we only need to look up
+		// (and possibly create) each directory once.
 		// (we have to create missing subdirectoryNames because archivers
 		// don't always place directory entries before their files)
 		const size_t flags = VFS_LOOKUP_ADD|VFS_LOOKUP_SKIP_POPULATE;
-		VfsDirectory* directory;
-		WARN_IF_ERR(vfs_Lookup(pathname, this_->m_directory, directory, 0, flags));
-
-		const VfsPath name = fileInfo.Name();
-		const VfsFile file(name, (size_t)fileInfo.Size(), fileInfo.MTime(), this_->m_realDirectory->Priority(), archiveFile);
-		if(name.Extension() == L".DELETED")
+		VfsDirectory* directory = nullptr;
+		for(size_t i = 0; i < entries.size(); i++)
 		{
-			directory->DeleteSubtree(file);
-			if(!(this_->m_realDirectory->Flags() & VFS_MOUNT_KEEP_DELETED))
-				return;
-		}
+			const ArchiveEntry& entry = entries[i];
+			if(!directory || entry.directory != entries[i-1].directory)
+				WARN_IF_ERR(vfs_Lookup(entry.pathname, m_directory, directory, 0, flags));
 
-		directory->AddFile(file);
+			// DeleteSubtree only removes subdirectories of <directory>, so the
+			// pointer remains valid for the following entries.
+			const VfsPath name = entry.fileInfo.Name();
+			const VfsFile file(name, (size_t)entry.fileInfo.Size(), entry.fileInfo.MTime(), m_realDirectory->Priority(), entry.archiveFile);
+			if(name.Extension() == L".DELETED")
+			{
+				directory->DeleteSubtree(file);
+				if(!(m_realDirectory->Flags() & VFS_MOUNT_KEEP_DELETED))
+					continue;
+			}
+
+			directory->AddFile(file);
+		}
 	}
 
 	Status AddFiles(const CFileInfos& files) const
 	{
 		const OsPath path(m_realDirectory->Path());
 
+		std::vector<OsPath> archivePathnames;
 		for(size_t i = 0; i < files.size(); i++)
 		{
 			const OsPath pathname = path / files[i].Name();
 			if(pathname.Extension() == L".zip")
-			{
-				PIArchiveReader archiveReader = CreateArchiveReader_Zip(pathname);
-				// archiveReader == nullptr if file could not be opened (e.g. because
-				// archive is currently open in another program)
-				if(archiveReader)
-					RETURN_STATUS_IF_ERR(archiveReader->ReadEntries(AddArchiveFile, (uintptr_t)this));
-			}
+				archivePathnames.push_back(pathname);
 			else	// regular (non-archive) file
 				AddFile(files[i]);
 		}
 
-		return INFO::OK;
+		// reading and parsing the central directories is independent of
+		// the VFS tree, so do that for all archives at once (or use what
+		// vfs_PrefetchArchives has read already) and only add their entries
+		// (in the original order) on this thread.
+		std::vector<std::future<ArchiveContents>> readers;
+		for(size_t i = 0; i < archivePathnames.size(); i++)
+			readers.push_back(ReadArchiveAsync(archivePathnames[i]));
+
+		Status ret = INFO::OK;
+		for(size_t i = 0; i < archivePathnames.size(); i++)
+		{
+			const ArchiveContents contents = readers[i].get();
+			if(contents.status < 0 && ret == INFO::OK)
+				ret = contents.status;
+			if(ret == INFO::OK)
+				AddArchiveEntries(contents.entries);
+		}
+
+		return ret;
 	}
 
 	void AddSubdirectories(const DirectoryNames& subdirectoryNames) const
@@ -166,6 +275,29 @@ Status vfs_Populate(VfsDirectory* directory)
 }
 
 
+void vfs_PrefetchArchives(const OsPath& path)
+{
+	CFileInfos files;
+	if(GetDirectoryEntries(path, &files, nullptr) != INFO::OK)
+		return;
+
+	std::lock_guard<std::mutex> lock(prefetchMutex);
+	for(size_t i = 0; i < files.size(); i++)
+	{
+		const OsPath pathname = path / files[i].Name();
+		if(pathname.Extension() == L".zip" && prefetchedArchives.find(pathname) == prefetchedArchives.end())
+			prefetchedArchives.emplace(pathname, std::async(std::launch::async, ReadArchive, pathname));
+	}
+}
+
+
+void vfs_ClearPrefetchedArchives()
+{
+	std::lock_guard<std::mutex> lock(prefetchMutex);
+	prefetchedArchives.clear();
+}
+
+
 Status vfs_Attach(VfsDirectory* directory, const PRealDirectory& realDirectory)
 {
 	PRealDirectory existingRealDir = directory->AssociatedDirectory();
@@ -54,4 +54,19 @@ extern Status vfs_Attach(VfsDirectory* directory, const PRealDirectory& realDire
  **/
 extern Status vfs_Populate(VfsDirectory* directory);
 
+/**
+ * start reading the central directories of the archives in a real
+ * directory in the background.
+ *
+ * a later vfs_Populate of a directory attached to @a path uses them, so
+ * calling this for several directories before mounting them reads all
+ * their archives concurrently.
+ **/
+extern void vfs_PrefetchArchives(const OsPath& path);
+
+/**
+ * drop the prefetched archives that haven't been used (yet).
+ **/
+extern void vfs_ClearPrefetchedArchives();
+
 #endif	// #ifndef INCLUDED_VFS_POPULATE
@@ -156,6 +156,15 @@ public:
 	 **/
 	bool ShouldPopulate();
 
+	/**
+	 * @return whether the next ShouldPopulate will return true,
+	 * without resetting the flag.
+	 **/
+	bool NeedsPopulate() const
+	{
+		return m_shouldPopulate;
+	}
+
 	/**
 	 * ensure the next ShouldPopulate returns true.
 	 **/
@@ -26,8 +26,9 @@
 #include "lib/debug.h"
 #include "lib/sysdep/os/win/wutil.h"	// StatusFromWin
 #include "lib/sysdep/os/win/wposix/waio.h"	// waio_reopen
+#include "lib/sysdep/os/win/wposix/wposix_internal.h"	// HANDLE_from_intptr
 #include "lib/sysdep/os/win/wposix/wtime_internal.h"	// wtime_utc_filetime_to_time_t
-#include "lib/sysdep/os/win/wposix/crt_posix.h"			// _close, _lseeki64 etc.
+#include "lib/sysdep/os/win/wposix/crt_posix.h"			// _close, _lseeki64, _get_osfhandle etc.
 
 #include <atomic>
 
@@ -286,6 +287,47 @@ off_t lseek(int fd, off_t ofs, int whence)
 }
 
 
+// positional IO via OVERLAPPED offsets (the handles are synchronous, so
+// this doesn't return early). unlike POSIX, the file pointer is moved,
+// but no caller relies on it.
+
+static ssize_t TransferAt(int fd, void* buf, size_t nbytes, off_t ofs, bool isWrite)
+{
+	WinScopedPreserveLastError s;
+
+	const HANDLE hFile = HANDLE_from_intptr(_get_osfhandle(fd));
+	if(hFile == INVALID_HANDLE_VALUE)
+	{
+		errno = EBADF;
+		return -1;
+	}
+
+	OVERLAPPED overlapped = {};
+	overlapped.Offset = u32(u64(ofs) & 0xFFFFFFFF);
+	overlapped.OffsetHigh = u32(u64(ofs) >> 32);
+	DWORD bytesTransferred = 0;
+	const BOOL ok = isWrite? WriteFile(hFile, buf, (DWORD)nbytes, &bytesTransferred, &overlapped) : ReadFile(hFile, buf, (DWORD)nbytes, &bytesTransferred, &overlapped);
+	if(!ok)
+	{
+		if(!isWrite && GetLastError() == ERROR_HANDLE_EOF)
+			return 0;
+		errno = EIO;
+		return -1;
+	}
+	return (ssize_t)bytesTransferred;
+}
+
+ssize_t pread(int fd, void* buf, size_t nbytes, off_t ofs)
+{
+	return TransferAt(fd, buf, nbytes, ofs, false);
+}
+
+ssize_t pwrite(int fd, const void* buf, size_t nbytes, off_t ofs)
+{
+	return TransferAt(fd, const_cast<void*>(buf), nbytes, ofs, true);
+}
+
+
 int wtruncate(const OsPath& pathname, off_t length)
 {
 	// (re-open the file to avoid the FILE_FLAG_NO_BUFFERING
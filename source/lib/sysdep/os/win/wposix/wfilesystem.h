@@ -60,5 +60,7 @@ typedef unsigned int mode_t;	// defined by MinGW but not VC
 extern int read (int fd, void* buf, size_t nbytes);	// thunk
 extern int write(int fd, void* buf, size_t nbytes);	// thunk
 extern off_t lseek(int fd, off_t ofs, int whence);  // thunk
+extern ssize_t pread (int fd, void* buf, size_t nbytes, off_t ofs);
+extern ssize_t pwrite(int fd, const void* buf, size_t nbytes, off_t ofs);
 
 #endif	// #ifndef INCLUDED_WFILESYSTEM
@@ -1,4 +1,4 @@
-/* Copyright (C) 2021 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  *
  * Permission is hereby granted, free of charge, to any person obtaining
  * a copy of this software and associated documentation files (the
@@ -25,6 +25,7 @@
 #include "lib/tex/tex.h"
 #include "lib/tex/tex_codec.h"
 #include "lib/allocators/shared_ptr.h"
+#include "lib/timer.h"
 
 #include <cstring>
 
@@ -85,4 +86,61 @@ public:
 		// compare img
 		TS_ASSERT_SAME_DATA(t.get_data(), expected, 48);
 	}
+
+	void test_s3tc_decode_dxt5()
+	{
+		const size_t w = 4, h = 4, bpp = 8;
+		std::shared_ptr<u8> img(new u8[w*h], ArrayDeleter());
+		// alpha from 255 to 0 with selectors 0..7 repeated, colors as above
+		memcpy(img.get(), "\xFF\x00\x88\xC6\xFA\x88\xC6\xFA" "\xFF\xFF\x00\x00\x00\xAA\xFF\x55", 16);
+		const u8 expected[] =
+			"\xFF\xFF\xFF\xFF" "\xFF\xFF\xFF\x00" "\xFF\xFF\xFF\xDB" "\xFF\xFF\xFF\xB6"
+			"\xAA\xAA\xAA\x92" "\xAA\xAA\xAA\x6D" "\xAA\xAA\xAA\x49" "\xAA\xAA\xAA\x24"
+			"\x55\x55\x55\xFF" "\x55\x55\x55\x00" "\x55\x55\x55\xDB" "\x55\x55\x55\xB6"
+			"\x00\x00\x00\x92" "\x00\x00\x00\x6D" "\x00\x00\x00\x49" "\x00\x00\x00\x24";
+
+		Tex t;
+		TS_ASSERT_OK(t.wrap(w, h, bpp, 5, img, 0));
+		TS_ASSERT_OK(t.transform_to(0));
+		TS_ASSERT_EQUALS(t.m_Bpp, 32u);
+		TS_ASSERT_SAME_DATA(t.get_data(), expected, 64);
+	}
+
+	void test_s3tc_decode_dxt1a()
+	{
+		const size_t w = 4, h = 4, bpp = 4;
+		std::shared_ptr<u8> img(new u8[w*h/2], ArrayDeleter());
+		// c0 <= c1 selects the 3-color table with transparent black
+		memcpy(img.get(), "\x00\x00\xFF\xFF\x00\xAA\xFF\x55", 8);
+		const u8 expected[] =
+			"\x00\x00\x00\xFF" "\x00\x00\x00\xFF" "\x00\x00\x00\xFF" "\x00\x00\x00\xFF"
+			"\x7F\x7F\x7F\xFF" "\x7F\x7F\x7F\xFF" "\x7F\x7F\x7F\xFF" "\x7F\x7F\x7F\xFF"
+			"\x00\x00\x00\x00" "\x00\x00\x00\x00" "\x00\x00\x00\x00" "\x00\x00\x00\x00"
+			"\xFF\xFF\xFF\xFF" "\xFF\xFF\xFF\xFF" "\xFF\xFF\xFF\xFF" "\xFF\xFF\xFF\xFF";
+
+		Tex t;
+		TS_ASSERT_OK(t.wrap(w, h, bpp, DXT1A, img, 0));
+		TS_ASSERT_OK(t.transform_to(0));
+		TS_ASSERT_EQUALS(t.m_Bpp, 32u);
+		TS_ASSERT_SAME_DATA(t.get_data(), expected, 64);
+	}
+
+	void DISABLE_test_s3tc_decode_perf()
+	{
+		const size_t w = 2048, h = 2048;
+		for (const size_t dxt : { size_t(1), size_t(5) })
+		{
+			const size_t bpp = dxt == 1 ? 4 : 8;
+			std::shared_ptr<u8> img(new u8[w*h*bpp/8], ArrayDeleter());
+			for (size_t i = 0; i < w*h*bpp/8; ++i)
+				img.get()[i] = static_cast<u8>(i * 2654435761u >> 13);
+
+			Tex t;
+			TS_ASSERT_OK(t.wrap(w, h, bpp, dxt, img, 0));
+			const double start = timer_Time();
+			TS_ASSERT_OK(t.transform_to(0));
+			const double elapsed = timer_Time() - start;
+			debug_printf("DXT%zu decode: %.2f ms (%.1f Mpixel/s)\n", dxt, elapsed * 1000.0, w*h / elapsed / 1e6);
+		}
+	}
 };
@@ -40,182 +40,157 @@
 // S3TC decompression
 //-----------------------------------------------------------------------------
 
-// note: this code may not be terribly efficient. it's only used to
-// emulate hardware S3TC support - if that isn't available, performance
-// will suffer anyway due to increased video memory usage.
-
-
-// for efficiency, we precalculate as much as possible about a block
-// and store it here.
-class S3tcBlock
+// note: this is used to emulate hardware S3TC support and to read DDS
+// textures on the CPU (e.g. for the minimap and for Atlas previews).
+// blocks are decoded as a whole into a 4x4 RGBA tile: the color and alpha
+// tables are computed once per block, selectors are consumed by shifting
+// and whole rows are copied to the output.
+
+// extract a range of bits and expand to 8 bits (by replicating
+// MS bits - see http://www.mindcontrol.org/~hplus/graphics/expand-bits.html ;
+// this is also the algorithm used by graphics cards when decompressing S3TC).
+// used to convert 565 to 32bpp RGB.
+static inline u8 s3tc_unpack_to_8(u16 c, size_t bits_below, size_t num_bits)
 {
-public:
-	S3tcBlock(size_t dxt, const u8* RESTRICT block)
-		: m_Dxt(dxt)
-	{
-		// (careful, 'dxt != 1' doesn't work - there's also DXT1a)
-		const u8* a_block = block;
-		const u8* c_block = (dxt == 3 || dxt == 5)? block+8 : block;
-
-		PrecalculateAlpha(dxt, a_block);
-		PrecalculateColor(dxt, c_block);
-	}
+	const size_t num_filler_bits = 8-num_bits;
+	const size_t field = (size_t)bits(c, bits_below, bits_below+num_bits-1);
+	const size_t filler = field >> (num_bits-num_filler_bits);
+	return (u8)((field << num_filler_bits) | filler);
+}
 
-	void WritePixel(size_t pixel_idx, u8* RESTRICT out) const
+// the 4 color choices of a DXT block (RGBA).
+static void s3tc_color_table(size_t dxt, const u8* RESTRICT c_block, u8 c[4][4])
+{
+	// S3TC reference colors (565 format). the color table is generated
+	// from some combination of these, depending on their ordering.
+	const u16 rc0 = read_le16(c_block);
+	const u16 rc1 = read_le16(c_block+2);
+
+	// c0 and c1 are the values of rc[], converted to 32bpp
+	c[0][0] = s3tc_unpack_to_8(rc0, 11, 5);
+	c[0][1] = s3tc_unpack_to_8(rc0,  5, 6);
+	c[0][2] = s3tc_unpack_to_8(rc0,  0, 5);
+	c[1][0] = s3tc_unpack_to_8(rc1, 11, 5);
+	c[1][1] = s3tc_unpack_to_8(rc1,  5, 6);
+	c[1][2] = s3tc_unpack_to_8(rc1,  0, 5);
+
+	// c2 and c3 are combinations of c0 and c1:
+	// (careful, 'dxt != 1' doesn't work - there's also DXT1a)
+	const bool is_dxt1_special_combination = (dxt == 1 || dxt == DXT1A) && rc0 <= rc1;
+	for(int i = 0; i < 3; i++)
 	{
-		ENSURE(pixel_idx < 16);
-
-		// pixel index -> color selector (2 bit) -> color
-		const size_t c_selector = access_bit_tbl(c_selectors, pixel_idx, 2);
-		for(int i = 0; i < 3; i++)
-			out[i] = (u8)c[c_selector][i];
-
-		// if no alpha, done
-		if(m_Dxt == 1)
-			return;
-
-		size_t a;
-		if(m_Dxt == 3)
+		if(is_dxt1_special_combination)
 		{
-			// table of 4-bit alpha entries
-			a = access_bit_tbl(a_bits, pixel_idx, 4);
-			a |= a << 4; // expand to 8 bits (replicate high into low!)
+			c[2][i] = (u8)((c[0][i]+c[1][i])/2);		// c2 = (c0+c1)/2
+			c[3][i] = 0;							// c3 = black
 		}
-		else if(m_Dxt == 5)
+		else
 		{
-			// pixel index -> alpha selector (3 bit) -> alpha
-			const size_t a_selector = access_bit_tbl(a_bits, pixel_idx, 3);
-			a = dxt5_a_tbl[a_selector];
+			c[2][i] = (u8)((c[0][i]*2 + c[1][i] + 1)/3);	// c2 = 2/3*c0 + 1/3*c1
+			c[3][i] = (u8)((c[1][i]*2 + c[0][i] + 1)/3);	// c3 = 1/3*c0 + 2/3*c1
 		}
-		// (m_Dxt == DXT1A)
-		else
-			a = c[c_selector][A];
-		out[A] = (u8)(a & 0xFF);
 	}
 
-private:
-	// pixel colors are stored as size_t[4]. size_t rather than u8 protects from
-	// overflow during calculations, and padding to an even size is a bit
-	// more efficient (even though we don't need the alpha component).
-	enum RGBA {	R, G, B, A };
+	// only DXT1a takes its alpha from the color table (transparent iff c3
+	// of the special combination); it's overwritten for DXT3 and DXT5.
+	c[0][3] = c[1][3] = c[2][3] = 255;
+	c[3][3] = (is_dxt1_special_combination && dxt == DXT1A)? 0 : 255;
+}
 
-	static inline void mix_2_3(size_t dst[4], size_t c0[4], size_t c1[4])
+// the 8 alpha choices of a DXT5 block.
+static void s3tc_dxt5_alpha_table(const u8* RESTRICT a_block, u8 a[8])
+{
+	const u8 a0 = a_block[0], a1 = a_block[1];
+	a[0] = a0;
+	a[1] = a1;
+	if(a0 <= a1)
 	{
-		for(int i = 0; i < 3; i++) dst[i] = (c0[i]*2 + c1[i] + 1)/3;
+		a[2] = (u8)((4*a0 + 1*a1 + 2)/5);
+		a[3] = (u8)((3*a0 + 2*a1 + 2)/5);
+		a[4] = (u8)((2*a0 + 3*a1 + 2)/5);
+		a[5] = (u8)((1*a0 + 4*a1 + 2)/5);
+		a[6] = 0;
+		a[7] = 255;
 	}
-
-	static inline void mix_avg(size_t dst[4], size_t c0[4], size_t c1[4])
+	else
 	{
-		for(int i = 0; i < 3; i++) dst[i] = (c0[i]+c1[i])/2;
+		a[2] = (u8)((6*a0 + 1*a1 + 3)/7);
+		a[3] = (u8)((5*a0 + 2*a1 + 3)/7);
+		a[4] = (u8)((4*a0 + 3*a1 + 3)/7);
+		a[5] = (u8)((3*a0 + 4*a1 + 3)/7);
+		a[6] = (u8)((2*a0 + 5*a1 + 3)/7);
+		a[7] = (u8)((1*a0 + 6*a1 + 3)/7);
 	}
+}
 
-	template<typename T>
-	static inline size_t access_bit_tbl(T tbl, size_t idx, size_t bit_width)
-	{
-		size_t val = (tbl >> (idx*bit_width)) & bit_mask<T>(bit_width);
-		return val;
-	}
+// decode one DXT block into 4x4 pixels of out_Bpp bytes (RGB or RGBA).
+// out_Bpp is a template parameter so that the per-pixel copies become
+// plain stores.
+template<size_t out_Bpp>
+static void s3tc_decode_block(size_t dxt, const u8* RESTRICT block, u8* RESTRICT out, size_t out_pitch)
+{
+	const u8* c_block = (dxt == 3 || dxt == 5)? block+8 : block;
+
+	u8 c[4][4];
+	s3tc_color_table(dxt, c_block, c);
 
-	// extract a range of bits and expand to 8 bits (by replicating
-	// MS bits - see http://www.mindcontrol.org/~hplus/graphics/expand-bits.html ;
-	// this is also the algorithm used by graphics cards when decompressing S3TC).
-	// used to convert 565 to 32bpp RGB.
-	static inline size_t unpack_to_8(u16 c, size_t bits_below, size_t num_bits)
+	// table of 2-bit color selectors
+	u32 c_selectors = read_le32(c_block+4);
+	for(size_t y = 0; y < 4; y++)
 	{
-		const size_t num_filler_bits = 8-num_bits;
-		const size_t field = (size_t)bits(c, bits_below, bits_below+num_bits-1);
-		const size_t filler = field >> (num_bits-num_filler_bits);
-		return (field << num_filler_bits) | filler;
+		u8* pixel = out + y*out_pitch;
+		for(size_t x = 0; x < 4; x++, pixel += out_Bpp, c_selectors >>= 2)
+			memcpy(pixel, c[c_selectors & 3], out_Bpp);
 	}
 
-	void PrecalculateAlpha(size_t dxt, const u8* RESTRICT a_block)
-	{
-		// read block contents
-		const u8 a0 = a_block[0], a1 = a_block[1];
-		a_bits = read_le64(a_block);	// see below
+	if(out_Bpp != 4 || (dxt != 3 && dxt != 5))
+		return;
 
-		if(dxt == 5)
+	if(dxt == 3)
+	{
+		// table of 4-bit alpha entries
+		u64 a_bits = read_le64(block);
+		for(size_t y = 0; y < 4; y++)
 		{
-			// skip a0,a1 bytes (data is little endian)
-			a_bits >>= 16;
-
-			const bool is_dxt5_special_combination = (a0 <= a1);
-			u8* a = dxt5_a_tbl;	// shorthand
-			if(is_dxt5_special_combination)
-			{
-				a[0] = a0;
-				a[1] = a1;
-				a[2] = (4*a0 + 1*a1 + 2)/5;
-				a[3] = (3*a0 + 2*a1 + 2)/5;
-				a[4] = (2*a0 + 3*a1 + 2)/5;
-				a[5] = (1*a0 + 4*a1 + 2)/5;
-				a[6] = 0;
-				a[7] = 255;
-			}
-			else
+			u8* pixel = out + y*out_pitch;
+			for(size_t x = 0; x < 4; x++, a_bits >>= 4)
 			{
-				a[0] = a0;
-				a[1] = a1;
-				a[2] = (6*a0 + 1*a1 + 3)/7;
-				a[3] = (5*a0 + 2*a1 + 3)/7;
-				a[4] = (4*a0 + 3*a1 + 3)/7;
-				a[5] = (3*a0 + 4*a1 + 3)/7;
-				a[6] = (2*a0 + 5*a1 + 3)/7;
-				a[7] = (1*a0 + 6*a1 + 3)/7;
+				const u8 a = (u8)(a_bits & 0xF);
+				pixel[x*4+3] = (u8)(a | (a << 4));	// expand to 8 bits (replicate high into low!)
 			}
 		}
 	}
-
-
-	void PrecalculateColor(size_t dxt, const u8* RESTRICT c_block)
+	else
 	{
-		// read block contents
-		// .. S3TC reference colors (565 format). the color table is generated
-		//    from some combination of these, depending on their ordering.
-		u16 rc[2];
-		for(int i = 0; i < 2; i++)
-			rc[i] = read_le16(c_block + 2*i);
-		// .. table of 2-bit color selectors
-		c_selectors = read_le32(c_block+4);
-
-		const bool is_dxt1_special_combination = (dxt == 1 || dxt == DXT1A) && rc[0] <= rc[1];
-
-		// c0 and c1 are the values of rc[], converted to 32bpp
-		for(int i = 0; i < 2; i++)
-		{
-			c[i][R] = unpack_to_8(rc[i], 11, 5);
-			c[i][G] = unpack_to_8(rc[i],  5, 6);
-			c[i][B] = unpack_to_8(rc[i],  0, 5);
-		}
+		u8 a[8];
+		s3tc_dxt5_alpha_table(block, a);
 
-		// c2 and c3 are combinations of c0 and c1:
-		if(is_dxt1_special_combination)
+		// table of 3-bit alpha selectors (skip a0,a1 bytes; data is little endian)
+		u64 a_selectors = read_le64(block) >> 16;
+		for(size_t y = 0; y < 4; y++)
 		{
-			mix_avg(c[2], c[0], c[1]);			// c2 = (c0+c1)/2
-			for(int i = 0; i < 3; i++) c[3][i] = 0;	// c3 = black
-			c[3][A] = (dxt == DXT1A)? 0 : 255;		// (transparent iff DXT1a)
+			u8* pixel = out + y*out_pitch;
+			for(size_t x = 0; x < 4; x++, a_selectors >>= 3)
+				pixel[x*4+3] = a[a_selectors & 7];
 		}
-		else
+	}
+}
+
+template<size_t out_Bpp>
+static void s3tc_decode_blocks(size_t dxt, size_t s3tc_block_size, size_t blocks_w, size_t blocks_h,
+	const u8* RESTRICT s3tc_data, u8* RESTRICT out)
+{
+	const size_t out_pitch = blocks_w*4 * out_Bpp;
+	for(size_t block_y = 0; block_y < blocks_h; block_y++)
+	{
+		u8* out_row = out + block_y*4 * out_pitch;
+		for(size_t block_x = 0; block_x < blocks_w; block_x++)
 		{
-			mix_2_3(c[2], c[0], c[1]);			// c2 = 2/3*c0 + 1/3*c1
-			mix_2_3(c[3], c[1], c[0]);			// c3 = 1/3*c0 + 2/3*c1
+			s3tc_decode_block<out_Bpp>(dxt, s3tc_data, out_row + block_x*4 * out_Bpp, out_pitch);
+			s3tc_data += s3tc_block_size;
 		}
 	}
-
-	// the 4 color choices for each pixel (RGBA)
-	size_t c[4][4];	// c[i][RGBA_component]
-
-	// (DXT5 only) the 8 alpha choices
-	u8 dxt5_a_tbl[8];
-
-	// alpha block; interpretation depends on dxt.
-	u64 a_bits;
-
-	// table of 2-bit color selectors
-	u32 c_selectors;
-
-	size_t m_Dxt;
-};
+}
 
 
 struct S3tcDecompressInfo
@@ -232,40 +207,21 @@ static void s3tc_decompress_level(size_t UNUSED(level), size_t level_w, size_t l
 	S3tcDecompressInfo* di = (S3tcDecompressInfo*)cbData;
 	const size_t dxt             = di->dxt;
 	const size_t s3tc_block_size = di->s3tc_block_size;
+	const size_t out_Bpp         = di->out_Bpp;
 
 	// note: 1x1 images are legitimate (e.g. in mipmaps). they report their
 	// width as such for glTexImage, but the S3TC data is padded to
 	// 4x4 pixel block boundaries.
 	const size_t blocks_w = DivideRoundUp(level_w, size_t(4));
 	const size_t blocks_h = DivideRoundUp(level_h, size_t(4));
-	const u8* s3tc_data = level_data;
-	ENSURE(level_data_size % s3tc_block_size == 0);
+	ENSURE(level_data_size == blocks_w*blocks_h * s3tc_block_size);
 
-	for(size_t block_y = 0; block_y < blocks_h; block_y++)
-	{
-		for(size_t block_x = 0; block_x < blocks_w; block_x++)
-		{
-			S3tcBlock block(dxt, s3tc_data);
-			s3tc_data += s3tc_block_size;
-
-			size_t pixel_idx = 0;
-			for(int y = 0; y < 4; y++)
-			{
-				// this is ugly, but advancing after x, y and block_y loops
-				// is no better.
-				u8* out = (u8*)di->out + ((block_y*4+y)*blocks_w*4 + block_x*4) * di->out_Bpp;
-				for(int x = 0; x < 4; x++)
-				{
-					block.WritePixel(pixel_idx, out);
-					out += di->out_Bpp;
-					pixel_idx++;
-				}
-			}
-		}
-	}
+	if(out_Bpp == 4)
+		s3tc_decode_blocks<4>(dxt, s3tc_block_size, blocks_w, blocks_h, level_data, di->out);
+	else
+		s3tc_decode_blocks<3>(dxt, s3tc_block_size, blocks_w, blocks_h, level_data, di->out);
 
-	ENSURE(s3tc_data == level_data + level_data_size);
-	di->out += blocks_w*blocks_h * 16 * di->out_Bpp;
+	di->out += blocks_w*blocks_h * 16 * out_Bpp;
 }
 
 
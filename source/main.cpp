@@ -46,6 +46,7 @@ that of Atlas depending on commandline parameters.
 #include "ps/Filesystem.h"
 #include "ps/Game.h"
 #include "ps/Globals.h"
+#include "ps/GUID.h"
 #include "ps/Hotkey.h"
 #include "ps/Loader.h"
 #include "ps/Mod.h"
@@ -66,7 +67,9 @@ that of Atlas depending on commandline parameters.
 #include "ps/GameSetup/CmdLineArgs.h"
 #include "ps/GameSetup/Paths.h"
 #include "ps/XML/Xeromyces.h"
+#include "network/DedicatedServer.h"
 #include "network/NetClient.h"
+#include "network/NetMessages.h"
 #include "network/NetServer.h"
 #include "network/NetSession.h"
 #include "lobby/IXmppClient.h"
@@ -124,6 +127,7 @@ extern "C"
 }
 #endif
 
+#include <charconv>
 #include <chrono>
 #include <utility>
 
@@ -505,6 +509,40 @@ static std::optional<RL::Interface> CreateRLInterface(const CmdLineArgs& args)
 	return std::make_optional<RL::Interface>(server_address.c_str());
 }
 
+static std::optional<CDedicatedServer> CreateDedicatedServer(const CmdLineArgs& args)
+{
+	if (!args.Has("dedicated-server"))
+		return std::nullopt;
+
+	std::vector<u16> ports;
+	for (const CStr& port : args.GetMultiple("dedicated-server"))
+	{
+		if (port.empty())
+		{
+			ports.push_back(PS_DEFAULT_PORT);
+			continue;
+		}
+
+		u16 value{0};
+		const char* const end{port.data() + port.size()};
+		const std::from_chars_result result{std::from_chars(port.data(), end, value)};
+		if (result.ec != std::errc{} || result.ptr != end || value == 0)
+		{
+			LOGERROR("Invalid port \"%s\" for -dedicated-server, it must be a number between 1 and 65535.", port);
+			g_Shutdown = ShutdownType::Quit;
+			return std::nullopt;
+		}
+		ports.push_back(value);
+	}
+
+	// The controller secret lets one client per game configure and start it.
+	const std::string secret{args.Has("dedicated-server-secret") ?
+		args.Get("dedicated-server-secret") : ps_generate_guid()};
+	debug_printf("Dedicated server controller secret: %s\n", secret.c_str());
+
+	return std::make_optional<CDedicatedServer>(ports, secret);
+}
+
 // moved into a helper function to ensure args is destroyed before
 // exit(), which may result in a memory leak.
 static void RunGameOrAtlas(const PS::span<const char* const> argv)
@@ -530,7 +568,8 @@ static void RunGameOrAtlas(const PS::span<const char* const> argv)
 
 	const bool isVisualReplay = args.Has("replay-visual");
 	const bool isNonVisualReplay = args.Has("replay");
-	const bool isVisual = !args.Has("autostart-nonvisual");
+	const bool isDedicatedServer = args.Has("dedicated-server");
+	const bool isVisual = !args.Has("autostart-nonvisual") && !isDedicatedServer;
 
 	const int fixedFrameFrequency{args.Has("fixed-frame-frequency")
 		? args.Get("fixed-frame-frequency").ToInt() : 0};
@@ -593,6 +632,9 @@ static void RunGameOrAtlas(const PS::span<const char* const> argv)
 		// Mount with highest priority, we don't want mods overwriting this.
 		g_VFS->Mount(L"cache/", paths.Cache(), VFS_MOUNT_ARCHIVABLE, VFS_MAX_PRIORITY);
 
+		if (args.Has("profiler2-trace"))
+			g_Profiler2.EnableTrace();
+
 		{
 			CReplayPlayer replay;
 			replay.Load(replayFile);
@@ -601,7 +643,8 @@ static void RunGameOrAtlas(const PS::span<const char* const> argv)
 				args.Has("rejointest") ? args.Get("rejointest").ToInt() : -1,
 				args.Has("ooslog"),
 				!args.Has("hashtest-full") || args.Get("hashtest-full") == "true",
-				args.Has("hashtest-quick") && args.Get("hashtest-quick") == "true");
+				args.Has("hashtest-quick") && args.Get("hashtest-quick") == "true",
+				args.Has("messageprofile"));
 		}
 
 		g_VFS.reset();
@@ -684,7 +727,7 @@ static void RunGameOrAtlas(const PS::span<const char* const> argv)
 			InitGraphics(args, 0, installedMods, *g_ScriptContext, *guiScriptInterface);
 			MainControllerInit();
 		}
-		else if (!InitNonVisual(args))
+		else if (!isDedicatedServer && !InitNonVisual(args))
 			g_Shutdown = ShutdownType::Quit;
 
 		// MSVC doesn't support copy elision in ternary expressions. So we use a lambda instead.
@@ -696,16 +739,33 @@ static void RunGameOrAtlas(const PS::span<const char* const> argv)
 					return std::nullopt;
 			}()};
 
+		std::optional<CDedicatedServer> dedicatedServer{[&]() -> std::optional<CDedicatedServer>
+			{
+				if (g_Shutdown == ShutdownType::None)
+					return CreateDedicatedServer(args);
+				else
+					return std::nullopt;
+			}()};
+		if (dedicatedServer && dedicatedServer->GetNumberOfGames() == 0)
+			g_Shutdown = ShutdownType::Quit;
+
 		while (g_Shutdown == ShutdownType::None)
 		{
 			if (isVisual)
 				Frame(rlInterface ? &*rlInterface : nullptr, fixedFrameFrequency);
 			else if(rlInterface)
 				rlInterface->TryApplyMessage();
+			else if (dedicatedServer)
+			{
+				// The games run on their own threads.
+				dedicatedServer->Update();
+				SDL_Delay(100);
+			}
 			else
 				NonVisualFrame();
 		}
 
+		dedicatedServer.reset();
 		ShutdownNetworkAndUI();
 		guiScriptInterface.reset();
 		ShutdownConfigAndSubsequent();
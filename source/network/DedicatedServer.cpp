@@ -0,0 +1,79 @@
+/* Copyright (C) 2025 Wildfire Games.
+ * This file is part of 0 A.D.
+ *
+ * 0 A.D. is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * 0 A.D. is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 0 A.D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "precompiled.h"
+
+#include "DedicatedServer.h"
+
+#include "lib/alignment.h"
+#include "lib/timer.h"
+#include "network/NetServer.h"
+#include "ps/CLogger.h"
+
+namespace
+{
+constexpr double MEMORY_REPORT_INTERVAL = 60.0;
+} // anonymous namespace
+
+CDedicatedServer::CDedicatedServer(const std::vector<u16>& ports, const std::string& controllerSecret) :
+	m_LastReportTime(timer_Time())
+{
+	m_Games.reserve(ports.size());
+	for (const u16 port : ports)
+	{
+		std::unique_ptr<CNetServer> server = std::make_unique<CNetServer>(false);
+		if (!server->SetupConnection(port))
+		{
+			LOGERROR("Dedicated server: failed to host a game on port %u", port);
+			continue;
+		}
+		server->SetControllerSecret(controllerSecret);
+		LOGMESSAGERENDER("Dedicated server: hosting a game on port %u", port);
+		m_Games.emplace_back(std::move(server));
+	}
+}
+
+CDedicatedServer::~CDedicatedServer() = default;
+
+u16 CDedicatedServer::GetGamePort(const size_t game) const
+{
+	ENSURE(game < m_Games.size());
+	return m_Games[game]->GetLocalPort();
+}
+
+size_t CDedicatedServer::GetGameMemoryUsage(const size_t game) const
+{
+	ENSURE(game < m_Games.size());
+	return m_Games[game]->GetMemoryUsage();
+}
+
+void CDedicatedServer::Update()
+{
+	const double time = timer_Time();
+	if (time - m_LastReportTime < MEMORY_REPORT_INTERVAL)
+		return;
+	m_LastReportTime = time;
+
+	size_t total = 0;
+	for (size_t game = 0; game < m_Games.size(); ++game)
+	{
+		const size_t memoryUsage = GetGameMemoryUsage(game);
+		total += memoryUsage;
+		LOGMESSAGE("Dedicated server: game on port %u uses %zu KiB", GetGamePort(game), memoryUsage / KiB);
+	}
+	LOGMESSAGE("Dedicated server: %zu games use %zu KiB", m_Games.size(), total / KiB);
+}
@@ -0,0 +1,68 @@
+/* Copyright (C) 2025 Wildfire Games.
+ * This file is part of 0 A.D.
+ *
+ * 0 A.D. is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * 0 A.D. is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 0 A.D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDED_DEDICATEDSERVER
+#define INCLUDED_DEDICATEDSERVER
+
+#include "lib/code_annotation.h"
+#include "lib/types.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class CNetServer;
+
+/**
+ * Hosts several independent games without a local client, renderer, GUI or
+ * simulation. Each game is served by its own CNetServer on its own port.
+ * The first client presenting the controller secret becomes the controller
+ * of its game and drives the game setup, like the host client normally does.
+ *
+ * Thread-safety: must be used from the main thread, the games run on their
+ * own network server threads.
+ */
+class CDedicatedServer
+{
+	NONCOPYABLE(CDedicatedServer);
+public:
+	/**
+	 * Starts one game per port. Ports which can't be bound are skipped.
+	 */
+	CDedicatedServer(const std::vector<u16>& ports, const std::string& controllerSecret);
+	~CDedicatedServer();
+
+	size_t GetNumberOfGames() const { return m_Games.size(); }
+
+	u16 GetGamePort(const size_t game) const;
+
+	/**
+	 * @return approximate memory used by the game, see CNetServer::GetMemoryUsage.
+	 */
+	size_t GetGameMemoryUsage(const size_t game) const;
+
+	/**
+	 * Logs the memory usage of every game, at most once per report interval.
+	 */
+	void Update();
+
+private:
+	std::vector<std::unique_ptr<CNetServer>> m_Games;
+	double m_LastReportTime;
+};
+
+#endif // INCLUDED_DEDICATEDSERVER
@@ -23,6 +23,7 @@
 #include "NetEnet.h"
 #include "NetMessage.h"
 #include "NetProtocol.h"
+#include "NetServer.h"
 #include "NetSession.h"
 
 #include "lib/byte_order.h"
@@ -33,6 +34,7 @@
 #include "ps/CConsole.h"
 #include "ps/CLogger.h"
 #include "ps/Compress.h"
+#include "ps/ConfigDB.h"
 #include "ps/CStr.h"
 #include "ps/Game.h"
 #include "ps/Hashing.h"
@@ -394,6 +396,17 @@ std::string CNetClient::TestReadGuiMessages()
 	return r;
 }
 
+u32 CNetClient::GetMeanRTT() const
+{
+	return m_Session ? m_Session->GetMeanRTT() : 0;
+}
+
+void CNetClient::LatchTurnStats(const CNetTurnStats& turnStats)
+{
+	if (m_Session)
+		m_Session->LatchTurnStats(turnStats);
+}
+
 const ScriptInterface& CNetClient::GetScriptInterface()
 {
 	return m_Game->GetSimulation2()->GetScriptInterface();
@@ -573,15 +586,8 @@ bool CNetClient::HandleMessage(CNetMessage* message)
 					return std::exchange(m_SavedState, {});
 				}
 
-				std::stringstream stream;
-
 				LOGMESSAGERENDER("Serializing game at turn %u for rejoining player", m_ClientTurnManager->GetCurrentTurn());
-				u32 turn = to_le32(m_ClientTurnManager->GetCurrentTurn());
-				stream.write((char*)&turn, sizeof(turn));
-
-				bool ok = m_Game->GetSimulation2()->SerializeState(stream);
-				ENSURE(ok);
-				return stream.str();
+				return SerializeJoinState();
 			}()};
 
 		// Compress the content with zlib to save bandwidth
@@ -602,6 +608,46 @@ bool CNetClient::HandleMessage(CNetMessage* message)
 	return ok;
 }
 
+std::string CNetClient::SerializeJoinState()
+{
+	std::stringstream stream;
+
+	u32 turn = to_le32(m_ClientTurnManager->GetCurrentTurn());
+	stream.write((char*)&turn, sizeof(turn));
+
+	bool ok = m_Game->GetSimulation2()->SerializeState(stream);
+	ENSURE(ok);
+	return stream.str();
+}
+
+bool CNetClient::SetupRelay(u16 port)
+{
+	ENSURE(!m_Session); // must be called before we start the connection
+
+	m_Relay = std::make_unique<CNetServer>(false, false, true);
+	if (m_Relay->SetupConnection(port))
+		return true;
+
+	m_Relay.reset();
+	return false;
+}
+
+void CNetClient::UpdateRelaySnapshot()
+{
+	const u32 currentTurn = m_ClientTurnManager->GetCurrentTurn();
+	// Observers replay every command since the snapshot before they can
+	// watch, so keep it reasonably recent without serializing every turn.
+	const int interval{std::max(1, g_ConfigDB.Get("network.relaysnapshotinterval", 150))};
+	if (currentTurn < m_RelaySnapshotTurn + static_cast<u32>(interval))
+		return;
+
+	PROFILE3("relay snapshot");
+	std::string compressedState;
+	CompressZLib(SerializeJoinState(), compressedState, true);
+	m_Relay->UpdateRelaySnapshot(std::move(compressedState));
+	m_RelaySnapshotTurn = currentTurn;
+}
+
 void CNetClient::LoadFinished()
 {
 	if (!m_JoinSyncBuffer.empty())
@@ -803,6 +849,9 @@ bool CNetClient::OnPlayerAssignment(CNetClient* client, CFsmEvent* event)
 
 	client->m_PlayerAssignments.swap(newPlayerAssignments);
 
+	if (client->m_Relay)
+		client->m_Relay->RelayPlayerAssignments(client->m_PlayerAssignments);
+
 	client->PostPlayerAssignmentsToScript();
 
 	return true;
@@ -820,6 +869,7 @@ bool CNetClient::OnGameStart(CNetClient* client, CFsmEvent* event)
 	ScriptRequest rq{scriptInterface};
 	JS::RootedValue initAttribs{rq.cx};
 	Script::ParseJSON(rq, message->m_InitAttributes, &initAttribs);
+	client->m_InitAttributes = message->m_InitAttributes;
 
 	client->PushGuiMessage("type", "start", "initAttributes", initAttribs);
 	client->StartGame(&initAttribs, "");
@@ -835,6 +885,7 @@ bool CNetClient::OnSavedGameStart(CNetClient* client, CFsmEvent* event)
 	ScriptRequest rq{scriptInterface};
 	const std::shared_ptr<JS::RootedValue> initAttribs{std::make_shared<JS::RootedValue>(rq.cx)};
 	Script::ParseJSON(rq, message->m_InitAttributes, &*initAttribs);
+	client->m_InitAttributes = message->m_InitAttributes;
 
 	client->PushGuiMessage("type", "start", "initAttributes", *initAttribs);
 
@@ -881,6 +932,9 @@ bool CNetClient::OnJoinSyncEndCommandBatch(CNetClient* client, CFsmEvent* event)
 
 	CEndCommandBatchMessage* endMessage = (CEndCommandBatchMessage*)event->GetParamRef();
 
+	if (client->m_Relay)
+		client->m_Relay->RelayMessage(endMessage);
+
 	client->m_ClientTurnManager->FinishedAllCommands(endMessage->m_Turn, endMessage->m_TurnLength);
 
 	// Execute all the received commands for the latest turn
@@ -1004,6 +1058,15 @@ bool CNetClient::OnLoadedGame(CNetClient* client, CFsmEvent* event)
 	if (client->m_Rejoin)
 		client->SendRejoinedMessage();
 
+	// Now that we have a state to give them, let observers join the relay.
+	if (client->m_Relay)
+	{
+		std::string compressedState;
+		CompressZLib(client->SerializeJoinState(), compressedState, true);
+		client->m_Relay->StartRelay(client->m_InitAttributes, std::move(compressedState));
+		client->m_RelaySnapshotTurn = client->m_ClientTurnManager->GetCurrentTurn();
+	}
+
 	return true;
 }
 
@@ -1015,6 +1078,9 @@ bool CNetClient::OnInGame(CNetClient* client, CFsmEvent* event)
 
 	if (message)
 	{
+		if (client->m_Relay && (message->GetType() == NMT_SIMULATION_COMMAND || message->GetType() == NMT_END_COMMAND_BATCH))
+			client->m_Relay->RelayMessage(message);
+
 		if (message->GetType() == NMT_SIMULATION_COMMAND)
 		{
 			CSimulationMessage* simMessage = static_cast<CSimulationMessage*> (message);
@@ -1029,6 +1095,9 @@ bool CNetClient::OnInGame(CNetClient* client, CFsmEvent* event)
 		{
 			CEndCommandBatchMessage* endMessage = static_cast<CEndCommandBatchMessage*> (message);
 			client->m_ClientTurnManager->FinishedAllCommands(endMessage->m_Turn, endMessage->m_TurnLength);
+
+			if (client->m_Relay)
+				client->UpdateRelaySnapshot();
 		}
 	}
 
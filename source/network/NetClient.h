@@ -29,12 +29,15 @@
 
 #include <ctime>
 #include <deque>
+#include <memory>
 #include <optional>
 #include <thread>
 
 class CGame;
 class CNetClientSession;
 class CNetClientTurnManager;
+class CNetServer;
+struct CNetTurnStats;
 class ScriptInterface;
 
 typedef struct _ENetHost ENetHost;
@@ -157,6 +160,16 @@ public:
 	 */
 	void CheckServerConnection();
 
+	/**
+	 * Average round trip time to the server, or 0 if not connected.
+	 */
+	u32 GetMeanRTT() const;
+
+	/**
+	 * Show the turn latency of this client in the profiler.
+	 */
+	void LatchTurnStats(const CNetTurnStats& turnStats);
+
 	/**
 	 * Retrieves the next queued GUI message, and removes it from the queue.
 	 * The returned value is in the GetScriptInterface() JS context.
@@ -267,6 +280,15 @@ public:
 	 */
 	void SendPausedMessage(bool pause);
 
+	/**
+	 * Re-serve the game this client joins to observers connecting on the
+	 * given port. The upstream server then only sends the game once to this
+	 * client, whatever the number of observers behind it.
+	 * Must be called before connecting.
+	 * @return false if the port could not be opened.
+	 */
+	bool SetupRelay(u16 port);
+
 	/**
 	 * @return Whether the NetClient is shutting down.
 	 */
@@ -320,6 +342,17 @@ private:
 	 */
 	void PostPlayerAssignmentsToScript();
 
+	/**
+	 * Serialize the current simulation state, prefixed with the turn, for
+	 * clients joining the game.
+	 */
+	std::string SerializeJoinState();
+
+	/**
+	 * Send the relay a fresh snapshot if the last one is old enough.
+	 */
+	void UpdateRelaySnapshot();
+
 	CGame *m_Game;
 	CStrW m_UserName;
 
@@ -371,6 +404,15 @@ private:
 
 	/// Record of the server engine version and loaded mods
 	CSrvHandshakeMessage m_ServerHandshake;
+
+	/// Init attributes of the current game, as sent by the server
+	CStr m_InitAttributes;
+
+	/// Server re-serving this game to observers (or nullptr if not relaying)
+	std::unique_ptr<CNetServer> m_Relay;
+
+	/// Turn of the latest snapshot given to the relay
+	u32 m_RelaySnapshotTurn = 0;
 };
 
 /// Global network client for the standard game
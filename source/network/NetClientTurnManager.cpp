@@ -1,4 +1,4 @@
-/* Copyright (C) 2024 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -20,6 +20,7 @@
 #include "NetClientTurnManager.h"
 #include "NetClient.h"
 
+#include "lib/timer.h"
 #include "ps/CLogger.h"
 #include "ps/Pyrogenesis.h"
 #include "ps/Replay.h"
@@ -50,6 +51,8 @@ void CNetClientTurnManager::PostCommand(JS::HandleValue data)
 	CSimulationMessage msg(m_Simulation2.GetScriptInterface(), m_ClientId, m_PlayerId, m_CurrentTurn + m_CommandDelay, data);
 	m_NetClient.SendMessage(&msg);
 
+	m_PendingCommandTimes.emplace_back(m_CurrentTurn + m_CommandDelay, timer_Time());
+
 	// Add to our local queue
 	//AddCommand(m_ClientId, m_PlayerId, data, m_CurrentTurn + m_CommandDelay);
 	// TODO: we should do this when the server stops sending our commands back to us
@@ -84,6 +87,16 @@ void CNetClientTurnManager::NotifyFinishedUpdate(u32 turn)
 
 	m_Replay.Hash(hash, quick);
 
+	const double now = timer_Time();
+	while (!m_PendingCommandTimes.empty() && m_PendingCommandTimes.front().first <= turn)
+	{
+		m_TurnStats.commandDelay.Add(static_cast<u32>((now - m_PendingCommandTimes.front().second) * 1000.0));
+		m_PendingCommandTimes.pop_front();
+	}
+	m_TurnStats.simulationLag.Add(GetPendingTurns());
+	m_TurnStats.rtt.Add(m_NetClient.GetMeanRTT());
+	m_NetClient.LatchTurnStats(m_TurnStats);
+
 	// Send message to the server
 	CSyncCheckMessage msg;
 	msg.m_Turn = turn;
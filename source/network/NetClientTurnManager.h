@@ -1,4 +1,4 @@
-/* Copyright (C) 2017 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -20,6 +20,10 @@
 
 #include "simulation2/system/TurnManager.h"
 #include "NetMessage.h"
+#include "NetStats.h"
+
+#include <deque>
+#include <utility>
 
 class CNetClient;
 
@@ -49,6 +53,11 @@ private:
 	void NotifyFinishedUpdate(u32 turn) override;
 
 	CNetClient& m_NetClient;
+
+	CNetTurnStats m_TurnStats;
+
+	/// Turn and issue time of our commands which were not executed yet.
+	std::deque<std::pair<u32, double>> m_PendingCommandTimes;
 };
 
 #endif // INCLUDED_NETCLIENTTURNMANAGER
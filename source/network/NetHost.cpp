@@ -1,4 +1,4 @@
-/* Copyright (C) 2010 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -29,6 +29,11 @@ bool CNetHost::SendMessage(const CNetMessage* message, ENetPeer* peer, const cha
 	if (!packet)
 		return false;
 
+	return SendPacket(packet, message, peer, peerName);
+}
+
+bool CNetHost::SendPacket(ENetPacket* packet, const CNetMessage* message, ENetPeer* peer, const char* peerName)
+{
 	LOGMESSAGE("Net: Sending message %s of size %lu to %s", message->ToString().c_str(), (unsigned long)packet->dataLength, peerName);
 
 	// Let ENet send the message to peer
@@ -52,17 +57,15 @@ ENetPacket* CNetHost::CreatePacket(const CNetMessage* message)
 
 	ENSURE(size); // else we'll fail when accessing the 0th element
 
-	// Adjust buffer for message
-	std::vector<u8> buffer;
-	buffer.resize(size);
-
-	// Save message to internal buffer
-	message->Serialize(&buffer[0]);
-
-	// Create a reliable packet
-	ENetPacket* packet = enet_packet_create(&buffer[0], size, ENET_PACKET_FLAG_RELIABLE);
+	// Create a reliable packet and serialize the message straight into it
+	ENetPacket* packet = enet_packet_create(NULL, size, ENET_PACKET_FLAG_RELIABLE);
 	if (!packet)
+	{
 		LOGERROR("Net: Failed to construct packet");
+		return NULL;
+	}
+
+	message->Serialize(packet->data);
 
 	return packet;
 }
@@ -1,4 +1,4 @@
-/* Copyright (C) 2019 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -95,6 +95,17 @@ public:
 	 */
 	static bool SendMessage(const CNetMessage* message, ENetPeer* peer, const char* peerName);
 
+	/**
+	 * Transmit an already serialised message to the given peer. The same packet
+	 * can be sent to several peers; the caller must destroy it if no peer took it.
+	 * @param packet packet created by CreatePacket
+	 * @param message message the packet was created from, for debug logs
+	 * @param peer peer to send to
+	 * @param peerName name of peer for debug logs
+	 * @return true on success, false on failure
+	 */
+	static bool SendPacket(ENetPacket* packet, const CNetMessage* message, ENetPeer* peer, const char* peerName);
+
 	/**
 	 * Construct an ENet packet by serialising the given message.
 	 * @return NULL on failure
@@ -1,4 +1,4 @@
-/* Copyright (C) 2023 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -93,7 +93,8 @@ CStr CNetMessage::ToString() const
 
 CNetMessage* CNetMessageFactory::CreateMessage(const void* pData,
 											   size_t dataSize,
-											   const ScriptInterface& scriptInterface)
+											   const ScriptInterface& scriptInterface,
+											   bool relaySimulationCommands)
 {
 	CNetMessage* pNewMessage = NULL;
 	CNetMessage header;
@@ -208,7 +209,10 @@ CNetMessage* CNetMessageFactory::CreateMessage(const void* pData,
 		break;
 
 	case NMT_SIMULATION_COMMAND:
-		pNewMessage = new CSimulationMessage(scriptInterface);
+		if (relaySimulationCommands)
+			pNewMessage = new CSimulationRelayMessage;
+		else
+			pNewMessage = new CSimulationMessage(scriptInterface);
 		break;
 
 	case NMT_FLARE:
@@ -1,4 +1,4 @@
-/* Copyright (C) 2017 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -20,6 +20,8 @@
 
 #include "Serialization.h"
 
+#include <vector>
+
 // We need the enum from NetMessages.h, but we can't create any classes in
 // NetMessages.h, since they in turn require CNetMessage to be defined
 #define ALLNETMSGS_DONT_CREATE_NMTS
@@ -101,9 +103,12 @@ public:
 	 * @param pData						Data buffer
 	 * @param dataSize					Size of data buffer
 	 * @param scriptInterface			Script instance to use when constructing scripted messages
+	 * @param relaySimulationCommands	Create simulation commands as CSimulationRelayMessage,
+	 *									without deserializing the command
 	 * @return							The new message created
 	 */
-	static CNetMessage* CreateMessage(const void* pData, size_t dataSize, const ScriptInterface& scriptInterface);
+	static CNetMessage* CreateMessage(const void* pData, size_t dataSize, const ScriptInterface& scriptInterface,
+		bool relaySimulationCommands = false);
 };
 
 /**
@@ -135,6 +140,30 @@ private:
 	const ScriptInterface& m_ScriptInterface;
 };
 
+/**
+ * Simulation command as seen by the server, which only needs the header fields.
+ * The command itself is kept as the serialized bytes and written back unchanged,
+ * so relaying it doesn't require a JS round-trip.
+ */
+class CSimulationRelayMessage : public CNetMessage
+{
+public:
+	CSimulationRelayMessage();
+
+	virtual u8* Serialize(u8* pBuffer) const;
+	virtual const u8* Deserialize(const u8* pStart, const u8* pEnd);
+	virtual size_t GetSerializedLength() const;
+	virtual CStr ToString() const;
+
+	u32 m_Client;
+	i32 m_Player;
+	u32 m_Turn;
+	/**
+	 * Serialized command, empty if the message was corrupt.
+	 */
+	std::vector<u8> m_Command;
+};
+
 /**
  * Special message type for updated to game startup settings.
  */
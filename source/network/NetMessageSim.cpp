@@ -1,4 +1,4 @@
-/* Copyright (C) 2021 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -19,13 +19,21 @@
 
 #include "NetMessage.h"
 
+#include "lib/byte_order.h"
 #include "lib/utf8.h"
+#include "ps/CLogger.h"
+#include "scriptinterface/Object.h"
+#include "scriptinterface/ScriptConversions.h"
+#include "scriptinterface/ScriptExtraHeaders.h"
 #include "scriptinterface/ScriptRequest.h"
 #include "scriptinterface/JSON.h"
 #include "simulation2/serialization/BinarySerializer.h"
 #include "simulation2/serialization/StdDeserializer.h"
 #include "simulation2/serialization/StdSerializer.h" // for DEBUG_SERIALIZER_ANNOTATE
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <sstream>
 
 class CBufferBinarySerializerImpl
@@ -110,6 +118,332 @@ public:
 	}
 };
 
+namespace
+{
+/**
+ * Compact encoding of the most common simulation commands. Instead of the generic
+ * script value serialization (which writes a type tag, the property name and the value
+ * type for every property), commands matching one of the schemas below are written as
+ * a list of field indices (in the original property order, to reproduce the exact same
+ * object) followed by their values. Entity lists are delta-encoded as variable length
+ * integers since they are usually close to each other.
+ * Anything not matching a schema uses the generic path.
+ */
+enum class ECommandFieldKind : u8
+{
+	TYPE,
+	ENTITY,
+	ENTITY_LIST,
+	NUMBER,
+	BOOL,
+	STRING
+};
+
+struct SCommandField
+{
+	const char* name;
+	ECommandFieldKind kind;
+};
+
+constexpr std::array<SCommandField, 12> COMMAND_FIELDS{{
+	{ "type", ECommandFieldKind::TYPE },
+	{ "entities", ECommandFieldKind::ENTITY_LIST },
+	{ "x", ECommandFieldKind::NUMBER },
+	{ "z", ECommandFieldKind::NUMBER },
+	{ "target", ECommandFieldKind::ENTITY },
+	{ "queued", ECommandFieldKind::BOOL },
+	{ "pushFront", ECommandFieldKind::BOOL },
+	{ "allowCapture", ECommandFieldKind::BOOL },
+	{ "formation", ECommandFieldKind::STRING },
+	{ "name", ECommandFieldKind::STRING },
+	{ "template", ECommandFieldKind::STRING },
+	{ "count", ECommandFieldKind::NUMBER }
+}};
+
+constexpr u32 FieldBit(const size_t field)
+{
+	return 1u << field;
+}
+
+constexpr u32 COMMON_ORDER_FIELDS = FieldBit(0) | FieldBit(1) | FieldBit(5) | FieldBit(6) | FieldBit(8);
+
+struct SCommandSchema
+{
+	const char* type;
+	u32 fields;
+};
+
+// Index 0 is reserved for the generic encoding.
+constexpr std::array<SCommandSchema, 7> COMMAND_SCHEMAS{{
+	{ nullptr, 0 },
+	{ "walk", COMMON_ORDER_FIELDS | FieldBit(2) | FieldBit(3) },
+	{ "attack", COMMON_ORDER_FIELDS | FieldBit(4) | FieldBit(7) },
+	{ "gather", COMMON_ORDER_FIELDS | FieldBit(4) },
+	{ "train", FieldBit(0) | FieldBit(1) | FieldBit(6) | FieldBit(10) | FieldBit(11) },
+	{ "formation", FieldBit(0) | FieldBit(1) | FieldBit(8) },
+	{ "stance", FieldBit(0) | FieldBit(1) | FieldBit(9) }
+}};
+
+constexpr u8 GENERIC_COMMAND = 0;
+
+bool IsEntityId(JS::HandleValue value)
+{
+	return value.isInt32() && value.toInt32() >= 0;
+}
+
+bool MatchesFieldKind(const ScriptRequest& rq, ECommandFieldKind kind, JS::HandleValue value)
+{
+	switch (kind)
+	{
+	case ECommandFieldKind::TYPE:
+		return true;
+	case ECommandFieldKind::ENTITY:
+		return IsEntityId(value);
+	case ECommandFieldKind::NUMBER:
+		return value.isNumber() && !std::isnan(value.toNumber());
+	case ECommandFieldKind::BOOL:
+		return value.isBoolean();
+	case ECommandFieldKind::STRING:
+		return value.isString();
+	case ECommandFieldKind::ENTITY_LIST:
+	{
+		if (!value.isObject())
+			return false;
+		JS::RootedObject obj(rq.cx, &value.toObject());
+		bool isArray;
+		u32 length;
+		if (!JS::IsArrayObject(rq.cx, obj, &isArray) || !isArray || !JS::GetArrayLength(rq.cx, obj, &length))
+			return false;
+		JS::RootedValue entity(rq.cx);
+		for (u32 i = 0; i < length; ++i)
+			if (!JS_GetElement(rq.cx, obj, i, &entity) || !IsEntityId(entity))
+				return false;
+		return true;
+	}
+	}
+	return false;
+}
+
+/**
+ * @return the schema index of the command, or GENERIC_COMMAND if it doesn't match any schema.
+ * On success @p fields contains the field indices in property order.
+ */
+u8 MatchCommandSchema(const ScriptRequest& rq, JS::HandleValue command, std::vector<u8>& fields)
+{
+	if (!command.isObject())
+		return GENERIC_COMMAND;
+
+	JS::RootedObject obj(rq.cx, &command.toObject());
+	const JSClass* jsclass = JS::GetClass(obj);
+	JS::RootedObject proto(rq.cx);
+	if (!jsclass || JSCLASS_CACHED_PROTO_KEY(jsclass) != JSProto_Object ||
+	    !JS_GetPrototype(rq.cx, obj, &proto) || proto != JS::GetRealmObjectPrototype(rq.cx))
+		return GENERIC_COMMAND;
+
+	std::string type;
+	JS::RootedValue typeVal(rq.cx);
+	if (!Script::GetProperty(rq, command, "type", &typeVal) || !typeVal.isString() ||
+	    !Script::FromJSVal(rq, typeVal, type))
+		return GENERIC_COMMAND;
+
+	const auto schema = std::find_if(COMMAND_SCHEMAS.begin() + 1, COMMAND_SCHEMAS.end(),
+		[&type](const SCommandSchema& schema) { return type == schema.type; });
+	if (schema == COMMAND_SCHEMAS.end())
+		return GENERIC_COMMAND;
+
+	JS::Rooted<JS::IdVector> ids(rq.cx, JS::IdVector(rq.cx));
+	if (!JS_Enumerate(rq.cx, obj, &ids) || ids.length() > COMMAND_FIELDS.size())
+		return GENERIC_COMMAND;
+
+	fields.clear();
+	for (size_t i = 0; i < ids.length(); ++i)
+	{
+		JS::RootedId id(rq.cx, ids[i]);
+		if (!id.isString())
+			return GENERIC_COMMAND;
+
+		std::string name;
+		JS::RootedValue nameVal(rq.cx);
+		if (!JS_IdToValue(rq.cx, id, &nameVal) || !Script::FromJSVal(rq, nameVal, name))
+			return GENERIC_COMMAND;
+
+		const auto field = std::find_if(COMMAND_FIELDS.begin(), COMMAND_FIELDS.end(),
+			[&name](const SCommandField& field) { return name == field.name; });
+		const size_t fieldIndex = field - COMMAND_FIELDS.begin();
+		if (field == COMMAND_FIELDS.end() || !(schema->fields & FieldBit(fieldIndex)))
+			return GENERIC_COMMAND;
+
+		// Getters are rejected by the generic serializer, keep that behaviour.
+		JS::Rooted<mozilla::Maybe<JS::PropertyDescriptor>> desc(rq.cx);
+		if (!JS_GetOwnPropertyDescriptorById(rq.cx, obj, id, &desc) || desc.isNothing() ||
+		    desc->hasGetter() || desc->hasSetter())
+			return GENERIC_COMMAND;
+
+		JS::RootedValue value(rq.cx, desc->value());
+		if (!MatchesFieldKind(rq, field->kind, value))
+			return GENERIC_COMMAND;
+
+		fields.push_back(static_cast<u8>(fieldIndex));
+	}
+
+	return static_cast<u8>(schema - COMMAND_SCHEMAS.begin());
+}
+
+void SerializeVarUint(ISerializer& serializer, u32 value)
+{
+	while (value >= 0x80)
+	{
+		serializer.NumberU8_Unbounded("varint", static_cast<u8>(value | 0x80));
+		value >>= 7;
+	}
+	serializer.NumberU8_Unbounded("varint", static_cast<u8>(value));
+}
+
+u32 DeserializeVarUint(IDeserializer& deserializer)
+{
+	u32 value = 0;
+	for (u32 shift = 0; shift < 35; shift += 7)
+	{
+		u8 byte;
+		deserializer.NumberU8_Unbounded("varint", byte);
+		value |= static_cast<u32>(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+			return value;
+	}
+	throw PSERROR_Deserialize_OutOfBounds();
+}
+
+void SerializeCommand(const ScriptRequest& rq, ISerializer& serializer, JS::MutableHandleValue command)
+{
+	std::vector<u8> fields;
+	const u8 schema = MatchCommandSchema(rq, command, fields);
+	serializer.NumberU8_Unbounded("command schema", schema);
+	if (schema == GENERIC_COMMAND)
+	{
+		serializer.ScriptVal("command", command);
+		return;
+	}
+
+	serializer.NumberU8_Unbounded("num fields", static_cast<u8>(fields.size()));
+	for (const u8 field : fields)
+	{
+		serializer.NumberU8_Unbounded("field", field);
+
+		JS::RootedValue value(rq.cx);
+		Script::GetProperty(rq, command, COMMAND_FIELDS[field].name, &value);
+		switch (COMMAND_FIELDS[field].kind)
+		{
+		case ECommandFieldKind::TYPE:
+			break;
+		case ECommandFieldKind::ENTITY:
+			SerializeVarUint(serializer, value.toInt32());
+			break;
+		case ECommandFieldKind::NUMBER:
+			serializer.NumberDouble_Unbounded("number", value.toNumber());
+			break;
+		case ECommandFieldKind::BOOL:
+			serializer.Bool("bool", value.toBoolean());
+			break;
+		case ECommandFieldKind::STRING:
+		{
+			std::wstring str;
+			Script::FromJSVal(rq, value, str);
+			serializer.String("string", str, 0, UINT32_MAX);
+			break;
+		}
+		case ECommandFieldKind::ENTITY_LIST:
+		{
+			JS::RootedObject obj(rq.cx, &value.toObject());
+			u32 length;
+			JS::GetArrayLength(rq.cx, obj, &length);
+			SerializeVarUint(serializer, length);
+
+			// Zigzag-encoded deltas, so that unsorted lists stay small too.
+			i32 previous = 0;
+			JS::RootedValue entity(rq.cx);
+			for (u32 i = 0; i < length; ++i)
+			{
+				JS_GetElement(rq.cx, obj, i, &entity);
+				const i32 delta = entity.toInt32() - previous;
+				SerializeVarUint(serializer, (static_cast<u32>(delta) << 1) ^ static_cast<u32>(delta >> 31));
+				previous = entity.toInt32();
+			}
+			break;
+		}
+		}
+	}
+}
+
+void DeserializeCommand(const ScriptRequest& rq, IDeserializer& deserializer, JS::MutableHandleValue command)
+{
+	u8 schema;
+	deserializer.NumberU8("command schema", schema, 0, COMMAND_SCHEMAS.size() - 1);
+	if (schema == GENERIC_COMMAND)
+	{
+		deserializer.ScriptVal("command", command);
+		return;
+	}
+
+	Script::CreateObject(rq, command);
+
+	u8 numFields;
+	deserializer.NumberU8("num fields", numFields, 0, COMMAND_FIELDS.size());
+	for (u8 i = 0; i < numFields; ++i)
+	{
+		u8 field;
+		deserializer.NumberU8("field", field, 0, COMMAND_FIELDS.size() - 1);
+		if (!(COMMAND_SCHEMAS[schema].fields & FieldBit(field)))
+			throw PSERROR_Deserialize_OutOfBounds();
+
+		JS::RootedValue value(rq.cx);
+		switch (COMMAND_FIELDS[field].kind)
+		{
+		case ECommandFieldKind::TYPE:
+			Script::ToJSVal(rq, &value, COMMAND_SCHEMAS[schema].type);
+			break;
+		case ECommandFieldKind::ENTITY:
+			value.setInt32(static_cast<i32>(DeserializeVarUint(deserializer)));
+			break;
+		case ECommandFieldKind::NUMBER:
+		{
+			double number;
+			deserializer.NumberDouble_Unbounded("number", number);
+			value.setNumber(number);
+			break;
+		}
+		case ECommandFieldKind::BOOL:
+		{
+			bool b;
+			deserializer.Bool("bool", b);
+			value.setBoolean(b);
+			break;
+		}
+		case ECommandFieldKind::STRING:
+		{
+			std::wstring str;
+			deserializer.String("string", str, 0, UINT32_MAX);
+			Script::ToJSVal(rq, &value, str);
+			break;
+		}
+		case ECommandFieldKind::ENTITY_LIST:
+		{
+			const u32 length = DeserializeVarUint(deserializer);
+			Script::CreateArray(rq, &value, length);
+			i32 previous = 0;
+			for (u32 j = 0; j < length; ++j)
+			{
+				const u32 zigzag = DeserializeVarUint(deserializer);
+				previous += static_cast<i32>((zigzag >> 1) ^ (0u - (zigzag & 1)));
+				Script::SetPropertyInt(rq, value, j, previous);
+			}
+			break;
+		}
+		}
+		Script::SetProperty(rq, command, COMMAND_FIELDS[field].name, value);
+	}
+}
+} // anonymous namespace
+
 CSimulationMessage::CSimulationMessage(const ScriptInterface& scriptInterface) :
 	CNetMessage(NMT_SIMULATION_COMMAND), m_ScriptInterface(scriptInterface)
 {
@@ -139,28 +473,26 @@ CSimulationMessage::CSimulationMessage(const CSimulationMessage& orig) :
 u8* CSimulationMessage::Serialize(u8* pBuffer) const
 {
 	// TODO: ought to handle serialization exceptions
-	// TODO: ought to represent common commands more efficiently
 	u8* pos = CNetMessage::Serialize(pBuffer);
 	CBufferBinarySerializer serializer(m_ScriptInterface, pos);
 	serializer.NumberU32_Unbounded("client", m_Client);
 	serializer.NumberI32_Unbounded("player", m_Player);
 	serializer.NumberU32_Unbounded("turn", m_Turn);
 
-	serializer.ScriptVal("command", const_cast<JS::PersistentRootedValue*>(&m_Data));
+	SerializeCommand(ScriptRequest(m_ScriptInterface), serializer, const_cast<JS::PersistentRootedValue*>(&m_Data));
 	return serializer.GetBuffer();
 }
 
 const u8* CSimulationMessage::Deserialize(const u8* pStart, const u8* pEnd)
 {
 	// TODO: ought to handle serialization exceptions
-	// TODO: ought to represent common commands more efficiently
 	const u8* pos = CNetMessage::Deserialize(pStart, pEnd);
 	std::istringstream stream(std::string(pos, pEnd));
 	CStdDeserializer deserializer(m_ScriptInterface, stream);
 	deserializer.NumberU32_Unbounded("client", m_Client);
 	deserializer.NumberI32_Unbounded("player", m_Player);
 	deserializer.NumberU32_Unbounded("turn", m_Turn);
-	deserializer.ScriptVal("command", &m_Data);
+	DeserializeCommand(ScriptRequest(m_ScriptInterface), deserializer, &m_Data);
 	return pEnd;
 }
 
@@ -175,7 +507,7 @@ size_t CSimulationMessage::GetSerializedLength() const
 
 	// TODO: The cast can probably be removed if and when ScriptVal can take a JS::HandleValue instead of
 	// a JS::MutableHandleValue (relies on JSAPI change). Also search for other casts like this one in that case.
-	serializer.ScriptVal("command", const_cast<JS::PersistentRootedValue*>(&m_Data));
+	SerializeCommand(ScriptRequest(m_ScriptInterface), serializer, const_cast<JS::PersistentRootedValue*>(&m_Data));
 	return CNetMessage::GetSerializedLength() + serializer.GetLength();
 }
 
@@ -189,6 +521,99 @@ CStr CSimulationMessage::ToString() const
 }
 
 
+namespace
+{
+// These match the layout written by CBufferBinarySerializer for the header fields.
+void PutRelayHeaderField(u8*& buffer, const char* name, u32 value)
+{
+	#if DEBUG_SERIALIZER_ANNOTATE
+		const std::string tag = std::string("<") + name + ">";
+		memcpy(buffer, tag.c_str(), tag.length());
+		buffer += tag.length();
+	#else
+		UNUSED2(name);
+	#endif
+	value = to_le32(value);
+	memcpy(buffer, &value, sizeof(value));
+	buffer += sizeof(value);
+}
+
+bool GetRelayHeaderField(const u8*& buffer, const u8* end, const char* name, u32& value)
+{
+	#if DEBUG_SERIALIZER_ANNOTATE
+		buffer += strlen(name) + 2;
+	#else
+		UNUSED2(name);
+	#endif
+	if (buffer + sizeof(value) > end)
+		return false;
+	memcpy(&value, buffer, sizeof(value));
+	value = to_le32(value);
+	buffer += sizeof(value);
+	return true;
+}
+
+size_t GetRelayHeaderFieldLength(const char* name)
+{
+	#if DEBUG_SERIALIZER_ANNOTATE
+		return strlen(name) + 2 + sizeof(u32);
+	#else
+		UNUSED2(name);
+		return sizeof(u32);
+	#endif
+}
+} // anonymous namespace
+
+CSimulationRelayMessage::CSimulationRelayMessage() :
+	CNetMessage(NMT_SIMULATION_COMMAND), m_Client(0), m_Player(0), m_Turn(0)
+{
+}
+
+u8* CSimulationRelayMessage::Serialize(u8* pBuffer) const
+{
+	u8* pos = CNetMessage::Serialize(pBuffer);
+	PutRelayHeaderField(pos, "client", m_Client);
+	PutRelayHeaderField(pos, "player", static_cast<u32>(m_Player));
+	PutRelayHeaderField(pos, "turn", m_Turn);
+	memcpy(pos, m_Command.data(), m_Command.size());
+	return pos + m_Command.size();
+}
+
+const u8* CSimulationRelayMessage::Deserialize(const u8* pStart, const u8* pEnd)
+{
+	const u8* pos = CNetMessage::Deserialize(pStart, pEnd);
+	m_Command.clear();
+	u32 player;
+	if (!pos ||
+	    !GetRelayHeaderField(pos, pEnd, "client", m_Client) ||
+	    !GetRelayHeaderField(pos, pEnd, "player", player) ||
+	    !GetRelayHeaderField(pos, pEnd, "turn", m_Turn))
+	{
+		LOGERROR("CSimulationRelayMessage: Corrupt packet (header too short)");
+		return NULL;
+	}
+	m_Player = static_cast<i32>(player);
+	m_Command.assign(pos, pEnd);
+	return pEnd;
+}
+
+size_t CSimulationRelayMessage::GetSerializedLength() const
+{
+	return CNetMessage::GetSerializedLength() +
+		GetRelayHeaderFieldLength("client") +
+		GetRelayHeaderFieldLength("player") +
+		GetRelayHeaderFieldLength("turn") +
+		m_Command.size();
+}
+
+CStr CSimulationRelayMessage::ToString() const
+{
+	std::stringstream stream;
+	stream << "CSimulationRelayMessage { m_Client: " << m_Client << ", m_Player: " << m_Player << ", m_Turn: " << m_Turn << ", m_Command: " << m_Command.size() << " bytes }";
+	return CStr(stream.str());
+}
+
+
 CGameSetupMessage::CGameSetupMessage(const ScriptInterface& scriptInterface) :
 	CNetMessage(NMT_GAME_SETUP), m_ScriptInterface(scriptInterface)
 {
@@ -97,9 +97,10 @@ static CStr DebugName(CNetServerSession* session)
  * See https://gitea.wildfiregames.com/0ad/0ad/issues/654
  */
 
-CNetServerWorker::CNetServerWorker(const bool continueSavedGame, const bool useLobbyAuth) :
+CNetServerWorker::CNetServerWorker(const bool continueSavedGame, const bool useLobbyAuth, const bool isRelay) :
 	m_ContinuesSavedGame{continueSavedGame},
 	m_LobbyAuth(useLobbyAuth),
+	m_Relay(isRelay),
 	m_Shutdown(false),
 	m_ScriptInterface(NULL),
 	m_NextHostID(1), m_Host(NULL), m_ControllerGUID(), m_Stats(NULL),
@@ -109,6 +110,14 @@ CNetServerWorker::CNetServerWorker(const bool continueSavedGame, const bool useL
 
 	m_ServerTurnManager = NULL;
 
+	// Relays record upstream turns from the moment they are created, so
+	// they can send the commands following any later snapshot.
+	if (m_Relay)
+	{
+		m_ServerTurnManager = new CNetServerTurnManager(*this);
+		m_ServerTurnManager->EnableRelay();
+	}
+
 	m_ServerName = DEFAULT_SERVER_NAME;
 }
 
@@ -376,12 +385,25 @@ bool CNetServerWorker::Multicast(const CNetMessage* message,
 
 	bool ok = true;
 
-	// TODO: this does lots of repeated message serialisation if we have lots
-	// of remote peers; could do it more efficiently if that's a real problem
-
+	// Serialize the message once, ENet refcounts the packet across peers.
+	ENetPacket* packet = nullptr;
 	for (CNetServerSession* session : m_Sessions)
-		if (isReceiver(*session) && !session->SendMessage(message))
+	{
+		if (!isReceiver(*session))
+			continue;
+		if (!packet)
+		{
+			packet = CNetHost::CreatePacket(message);
+			if (!packet)
+				return false;
+		}
+		if (!CNetHost::SendPacket(packet, message, session->GetPeer(), DebugName(session).c_str()))
 			ok = false;
+	}
+
+	// Free the packet if no peer took a reference to it.
+	if (packet && packet->referenceCount == 0)
+		enet_packet_destroy(packet);
 
 	return ok;
 }
@@ -409,11 +431,18 @@ void CNetServerWorker::Run()
 			break;
 
 		// Update profiler stats
-		m_Stats->LatchHostState(m_Host);
+		std::vector<const CNetTurnStats*> turnStats(m_Host->peerCount, nullptr);
+		for (size_t i = 0; i < m_Host->peerCount; ++i)
+			if (const CNetServerSession* session = static_cast<const CNetServerSession*>(m_Host->peers[i].data))
+				turnStats[i] = &session->GetTurnStats();
+		m_Stats->LatchHostState(m_Host, turnStats);
+
+		m_MemoryUsage = JS_GetGCParameter(m_ScriptInterface->GetGeneralJSContext(), JSGC_BYTES) + m_SavedCommandsSize;
 	}
 
 	// Clear roots before deleting their context
 	m_SavedCommands.clear();
+	m_SavedCommandsSize = 0;
 
 	SAFE_DELETE(m_ScriptInterface);
 }
@@ -432,6 +461,10 @@ bool CNetServerWorker::RunStep()
 	std::vector<std::string> newGameAttributes;
 	std::vector<std::pair<CStr, CStr>> newLobbyAuths;
 	std::vector<u32> newTurnLength;
+	std::vector<std::vector<u8>> newRelayMessages;
+	std::vector<PlayerAssignmentMap> newRelayPlayerAssignments;
+	std::vector<std::string> newRelaySnapshots;
+	std::vector<std::string> newRelayStart;
 
 	{
 		std::lock_guard<std::mutex> lock(m_WorkerMutex);
@@ -443,6 +476,10 @@ bool CNetServerWorker::RunStep()
 		newGameAttributes.swap(m_InitAttributesQueue);
 		newLobbyAuths.swap(m_LobbyAuthQueue);
 		newTurnLength.swap(m_TurnLengthQueue);
+		newRelayMessages.swap(m_RelayMessageQueue);
+		newRelayPlayerAssignments.swap(m_RelayPlayerAssignmentsQueue);
+		newRelaySnapshots.swap(m_RelaySnapshotQueue);
+		newRelayStart.swap(m_RelayStartQueue);
 	}
 
 	if (!newGameAttributes.empty())
@@ -467,6 +504,18 @@ bool CNetServerWorker::RunStep()
 		newLobbyAuths.pop_back();
 	}
 
+	for (const std::vector<u8>& data : newRelayMessages)
+		HandleRelayedMessage(data);
+
+	if (!newRelayPlayerAssignments.empty())
+		SetRelayedPlayerAssignments(newRelayPlayerAssignments.back());
+
+	if (!newRelaySnapshots.empty())
+		m_JoinSyncFile = std::move(newRelaySnapshots.back());
+
+	if (!newRelayStart.empty())
+		StartRelay(newRelayStart.back());
+
 	// Perform file transfers
 	for (CNetServerSession* session : m_Sessions)
 		session->GetFileTransferer().Poll();
@@ -550,7 +599,8 @@ bool CNetServerWorker::RunStep()
 		if (session)
 		{
 			// Create message from raw data
-			CNetMessage* msg = CNetMessageFactory::CreateMessage(event.packet->data, event.packet->dataLength, GetScriptInterface());
+			// Simulation commands are relayed without deserializing them.
+			CNetMessage* msg = CNetMessageFactory::CreateMessage(event.packet->data, event.packet->dataLength, GetScriptInterface(), true);
 			if (msg)
 			{
 				LOGMESSAGE("Net server: Received message %s of size %lu from %s", msg->ToString().c_str(), (unsigned long)msg->GetSerializedLength(), DebugName(session).c_str());
@@ -587,6 +637,7 @@ void CNetServerWorker::CheckClientConnections()
 	{
 		u32 lastReceived = m_Sessions[i]->GetLastReceivedTime();
 		u32 meanRTT = m_Sessions[i]->GetMeanRTT();
+		m_Sessions[i]->GetTurnStats().rtt.Add(meanRTT);
 
 		CNetMessage* message = nullptr;
 
@@ -626,6 +677,33 @@ void CNetServerWorker::CheckClientConnections()
 
 		SAFE_DELETE(message);
 	}
+
+	UpdateAdaptiveTurnLength();
+}
+
+void CNetServerWorker::UpdateAdaptiveTurnLength()
+{
+	if (m_Relay || m_FixedTurnLength || !m_ServerTurnManager || !g_ConfigDB.Get("network.adaptiveturnlength", false))
+		return;
+
+	// Observers can't hold the game back, only wait for players.
+	u32 rtt = 0;
+	for (const CNetServerSession* session : m_Sessions)
+	{
+		PlayerAssignmentMap::const_iterator it = m_PlayerAssignments.find(session->GetGUID());
+		if (it != m_PlayerAssignments.end() && it->second.m_PlayerID != -1)
+			rtt = std::max(rtt, session->GetTurnStats().rtt.GetPercentile(0.95));
+	}
+
+	const int minTurnLength{std::max(1, g_ConfigDB.Get("network.minturnlength", static_cast<int>(DEFAULT_TURN_LENGTH)))};
+	const int maxTurnLength{g_ConfigDB.Get("network.maxturnlength", 500)};
+	const u32 turnLength = CNetServerTurnManager::ComputeAdaptiveTurnLength(rtt,
+		static_cast<u32>(minTurnLength), static_cast<u32>(std::max(minTurnLength, maxTurnLength)));
+
+	PROFILE2("adaptive turn length");
+	PROFILE2_ATTR("rtt: %u", rtt);
+	PROFILE2_ATTR("turn length: %u", turnLength);
+	m_ServerTurnManager->SetTurnLength(turnLength);
 }
 
 void CNetServerWorker::HandleMessageReceive(const CNetMessage* message, CNetServerSession* session)
@@ -750,7 +828,8 @@ void CNetServerWorker::AddPlayer(const CStr& guid, const CStrW& name)
 
 	i32 playerID = -1;
 
-	if (m_State != SERVER_STATE_UNCONNECTED && m_State != SERVER_STATE_PREGAME)
+	// Relays have no players of their own, only observers.
+	if (!m_Relay && m_State != SERVER_STATE_UNCONNECTED && m_State != SERVER_STATE_PREGAME)
 	{
 		// Try to match GUID first
 		for (PlayerAssignmentMap::iterator it = m_PlayerAssignments.begin(); it != m_PlayerAssignments.end(); ++it)
@@ -882,6 +961,7 @@ const ScriptInterface& CNetServerWorker::GetScriptInterface()
 
 void CNetServerWorker::SetTurnLength(u32 msecs)
 {
+	m_FixedTurnLength = true;
 	if (m_ServerTurnManager)
 		m_ServerTurnManager->SetTurnLength(msecs);
 }
@@ -971,6 +1051,14 @@ bool CNetServerWorker::OnAuthenticate(CNetServerSession* session, CFsmEvent* eve
 		return true;
 	}
 
+	// Relays only take observers once the relayed game is running
+	if (server.m_Relay && server.m_State != SERVER_STATE_INGAME)
+	{
+		LOGMESSAGE("Refused connection before the relayed game started");
+		session->Disconnect(NDR_SERVER_LOADING);
+		return true;
+	}
+
 	CAuthenticateMessage* message = (CAuthenticateMessage*)event->GetParamRef();
 	CStrW username = SanitisePlayerName(message->m_Name);
 	CStrW usernameWithoutRating(username.substr(0, username.find(L" (")));
@@ -1032,6 +1120,15 @@ bool CNetServerWorker::OnAuthenticate(CNetServerSession* session, CFsmEvent* eve
 		// Don't check for maxObservers in the gamesetup, as we don't know yet who will be assigned
 		serverFull = server.m_Sessions.size() >= MAX_CLIENTS;
 	}
+	else if (server.m_Relay)
+	{
+		// Everyone joining a relay is a late observer. They don't count
+		// towards the host's observer limit, so the relay has its own.
+		isRejoining = true;
+		serverFull =
+			static_cast<int>(server.m_Sessions.size()) > g_ConfigDB.Get("network.relayobserverlimit", 0) ||
+			server.m_Sessions.size() >= MAX_CLIENTS;
+	}
 	else
 	{
 		bool isObserver = true;
@@ -1115,7 +1212,8 @@ bool CNetServerWorker::OnAuthenticate(CNetServerSession* session, CFsmEvent* eve
 	authenticateResult.m_Message = L"Logged in";
 	authenticateResult.m_IsController = 0;
 
-	if (message->m_ControllerSecret == server.m_ControllerSecret)
+	// Nobody controls a relayed game from the relay.
+	if (!server.m_Relay && message->m_ControllerSecret == server.m_ControllerSecret)
 	{
 		if (server.m_ControllerGUID.empty())
 		{
@@ -1134,6 +1232,19 @@ bool CNetServerWorker::OnAuthenticate(CNetServerSession* session, CFsmEvent* eve
 
 	ENSURE(server.m_State != SERVER_STATE_UNCONNECTED && server.m_State != SERVER_STATE_PREGAME);
 
+	if (server.m_Relay)
+	{
+		// Relays serve their cached snapshot instead of requesting one, the
+		// commands since then are sent once the observer has loaded it.
+		CJoinSyncStartMessage joinSyncStart;
+		joinSyncStart.m_InitAttributes = Script::StringifyJSON(
+			ScriptRequest{server.GetScriptInterface()}, &server.m_InitAttributes);
+		session->SendMessage(&joinSyncStart);
+
+		session->SetNextState(NSS_JOIN_SYNCING);
+		return true;
+	}
+
 	// Request a copy of the current game state from an existing player, so we can send it on to the new
 	// player.
 
@@ -1183,35 +1294,38 @@ bool CNetServerWorker::OnSimulationCommand(CNetServerSession* session, CFsmEvent
 
 	CNetServerWorker& server = session->GetServer();
 
-	CSimulationMessage* message = (CSimulationMessage*)event->GetParamRef();
+	CSimulationRelayMessage* message = (CSimulationRelayMessage*)event->GetParamRef();
+
+	// Drop corrupt messages rather than relaying them to clients,
+	// and commands sent to a relay since its observers can't play.
+	if (message->m_Command.empty() || server.m_Relay)
+		return true;
 
 	// Ignore messages sent by one player on behalf of another player
 	// unless cheating is enabled
-	bool cheatsEnabled = false;
-	const ScriptInterface& scriptInterface = server.GetScriptInterface();
-	ScriptRequest rq(scriptInterface);
-	JS::RootedValue settings(rq.cx);
-	Script::GetProperty(rq, server.m_InitAttributes, "settings", &settings);
-	if (Script::HasProperty(rq, settings, "CheatsEnabled"))
-		Script::GetProperty(rq, settings, "CheatsEnabled", cheatsEnabled);
-
 	PlayerAssignmentMap::iterator it = server.m_PlayerAssignments.find(session->GetGUID());
 	// When cheating is disabled, fail if the player the message claims to
 	// represent does not exist or does not match the sender's player name
-	if (!cheatsEnabled && (it == server.m_PlayerAssignments.end() || it->second.m_PlayerID != message->m_Player))
+	if (!server.m_CheatsEnabled && (it == server.m_PlayerAssignments.end() || it->second.m_PlayerID != message->m_Player))
 		return true;
 
+	server.BroadcastSimulationCommand(std::move(*message));
+
+	// TODO: we shouldn't send the message back to the client that first sent it
+	return true;
+}
+
+void CNetServerWorker::BroadcastSimulationCommand(CSimulationRelayMessage&& message)
+{
 	// Send it back to all clients that have finished
 	// the loading screen (and the synchronization when rejoining)
-	server.Multicast(message, { NSS_INGAME });
+	Multicast(&message, { NSS_INGAME });
 
 	// Save all the received commands
-	if (server.m_SavedCommands.size() < message->m_Turn + 1)
-		server.m_SavedCommands.resize(message->m_Turn + 1);
-	server.m_SavedCommands[message->m_Turn].push_back(*message);
-
-	// TODO: we shouldn't send the message back to the client that first sent it
-	return true;
+	if (m_SavedCommands.size() < message.m_Turn + 1)
+		m_SavedCommands.resize(message.m_Turn + 1);
+	m_SavedCommandsSize += message.GetSerializedLength();
+	m_SavedCommands[message.m_Turn].push_back(std::move(message));
 }
 
 bool CNetServerWorker::OnFlare(CNetServerSession* session, CFsmEvent* event)
@@ -1234,6 +1348,10 @@ bool CNetServerWorker::OnSyncCheck(CNetServerSession* session, CFsmEvent* event)
 
 	CSyncCheckMessage* message = (CSyncCheckMessage*)event->GetParamRef();
 
+	// How many turns the client could have simulated but didn't yet.
+	const u32 readyTurn = server.m_ServerTurnManager->GetReadyTurn();
+	session->GetTurnStats().simulationLag.Add(readyTurn > message->m_Turn ? readyTurn - message->m_Turn : 0);
+
 	server.m_ServerTurnManager->NotifyFinishedClientUpdate(*session, message->m_Turn, message->m_Hash);
 	return true;
 }
@@ -1595,7 +1713,14 @@ void CNetServerWorker::PreStartGame(const CStr& initAttribs)
 	SendPlayerAssignments();
 
 	// Update init attributes. They should no longer change.
-	Script::ParseJSON(ScriptRequest(m_ScriptInterface), initAttribs, &m_InitAttributes);
+	ScriptRequest rq(m_ScriptInterface);
+	Script::ParseJSON(rq, initAttribs, &m_InitAttributes);
+
+	m_CheatsEnabled = false;
+	JS::RootedValue settings(rq.cx);
+	Script::GetProperty(rq, m_InitAttributes, "settings", &settings);
+	if (Script::HasProperty(rq, settings, "CheatsEnabled"))
+		Script::GetProperty(rq, settings, "CheatsEnabled", m_CheatsEnabled);
 }
 
 void CNetServerWorker::StartGame(const CStr& initAttribs)
@@ -1616,6 +1741,56 @@ void CNetServerWorker::StartSavedGame(const CStr& initAttribs)
 	Multicast(&gameSavedStart, { NSS_PREGAME });
 }
 
+void CNetServerWorker::StartRelay(const CStr& initAttribs)
+{
+	ENSURE(m_Relay);
+
+	ScriptRequest rq(m_ScriptInterface);
+	Script::ParseJSON(rq, initAttribs, &m_InitAttributes);
+
+	m_State = SERVER_STATE_INGAME;
+}
+
+void CNetServerWorker::HandleRelayedMessage(const std::vector<u8>& data)
+{
+	ENSURE(m_Relay);
+
+	CNetMessage* message = CNetMessageFactory::CreateMessage(data.data(), data.size(), GetScriptInterface(), true);
+	if (!message)
+		return;
+
+	if (message->GetType() == NMT_SIMULATION_COMMAND)
+	{
+		CSimulationRelayMessage* command = static_cast<CSimulationRelayMessage*>(message);
+		if (!command->m_Command.empty())
+			BroadcastSimulationCommand(std::move(*command));
+	}
+	else if (message->GetType() == NMT_END_COMMAND_BATCH)
+	{
+		const CEndCommandBatchMessage* endMessage = static_cast<const CEndCommandBatchMessage*>(message);
+		m_ServerTurnManager->OnRelayedCommandBatch(endMessage->m_Turn, endMessage->m_TurnLength);
+	}
+
+	delete message;
+}
+
+void CNetServerWorker::SetRelayedPlayerAssignments(const PlayerAssignmentMap& playerAssignments)
+{
+	ENSURE(m_Relay);
+
+	// Keep the assignments of our own observers, they are unknown upstream.
+	PlayerAssignmentMap newPlayerAssignments = playerAssignments;
+	for (const CNetServerSession* session : m_Sessions)
+	{
+		PlayerAssignmentMap::const_iterator it = m_PlayerAssignments.find(session->GetGUID());
+		if (it != m_PlayerAssignments.end())
+			newPlayerAssignments[it->first] = it->second;
+	}
+	m_PlayerAssignments.swap(newPlayerAssignments);
+
+	SendPlayerAssignments();
+}
+
 CStrW CNetServerWorker::SanitisePlayerName(const CStrW& original)
 {
 	const size_t MAX_LENGTH = 32;
@@ -1672,8 +1847,8 @@ void CNetServerWorker::SendHolePunchingMessage(const CStr& ipStr, u16 port)
 
 
 
-CNetServer::CNetServer(const bool continueSavedGame, const bool useLobbyAuth) :
-	m_Worker{new CNetServerWorker{continueSavedGame, useLobbyAuth}},
+CNetServer::CNetServer(const bool continueSavedGame, const bool useLobbyAuth, const bool isRelay) :
+	m_Worker{new CNetServerWorker{continueSavedGame, useLobbyAuth, isRelay}},
 	m_LobbyAuth(useLobbyAuth), m_PublicIp(""), m_PublicPort(20595), m_Password()
 {
 }
@@ -1754,6 +1929,39 @@ void CNetServer::SetControllerSecret(const std::string& secret)
 	m_Worker->SetControllerSecret(secret);
 }
 
+size_t CNetServer::GetMemoryUsage() const
+{
+	return m_Worker->m_MemoryUsage;
+}
+
+void CNetServer::RelayMessage(const CNetMessage* message)
+{
+	std::vector<u8> data(message->GetSerializedLength());
+	message->Serialize(data.data());
+
+	std::lock_guard<std::mutex> lock(m_Worker->m_WorkerMutex);
+	m_Worker->m_RelayMessageQueue.emplace_back(std::move(data));
+}
+
+void CNetServer::RelayPlayerAssignments(const PlayerAssignmentMap& playerAssignments)
+{
+	std::lock_guard<std::mutex> lock(m_Worker->m_WorkerMutex);
+	m_Worker->m_RelayPlayerAssignmentsQueue.push_back(playerAssignments);
+}
+
+void CNetServer::UpdateRelaySnapshot(std::string joinSyncFile)
+{
+	std::lock_guard<std::mutex> lock(m_Worker->m_WorkerMutex);
+	m_Worker->m_RelaySnapshotQueue.emplace_back(std::move(joinSyncFile));
+}
+
+void CNetServer::StartRelay(const CStr& initAttribs, std::string joinSyncFile)
+{
+	std::lock_guard<std::mutex> lock(m_Worker->m_WorkerMutex);
+	m_Worker->m_RelaySnapshotQueue.emplace_back(std::move(joinSyncFile));
+	m_Worker->m_RelayStartQueue.push_back(initAttribs);
+}
+
 void CNetServer::StartGame()
 {
 	std::lock_guard<std::mutex> lock(m_Worker->m_WorkerMutex);
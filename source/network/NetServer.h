@@ -24,6 +24,7 @@
 #include "lib/types.h"
 #include "scriptinterface/ScriptTypes.h"
 
+#include <atomic>
 #include <ctime>
 #include <mutex>
 #include <optional>
@@ -38,7 +39,7 @@ class CNetServerTurnManager;
 class CFsmEvent;
 class CPlayerAssignmentMessage;
 class CNetStatsTable;
-class CSimulationMessage;
+class CSimulationRelayMessage;
 class ScriptInterface;
 class ScriptRequest;
 
@@ -109,7 +110,11 @@ class CNetServer
 {
 	NONCOPYABLE(CNetServer);
 public:
-	CNetServer(const bool isSavedGame, const bool useLobbyAuth = false);
+	/**
+	 * @param isRelay whether this server re-serves a game hosted elsewhere to
+	 * its own observers, @see StartRelay.
+	 */
+	CNetServer(const bool isSavedGame, const bool useLobbyAuth = false, const bool isRelay = false);
 	~CNetServer();
 
 	/**
@@ -180,6 +185,37 @@ public:
 
 	void SetControllerSecret(const std::string& secret);
 
+	/**
+	 * @return approximate memory used by the game hosted on this server, in bytes:
+	 * the script heap of the worker and the saved simulation commands.
+	 * Updated by the worker thread, may lag slightly behind.
+	 */
+	size_t GetMemoryUsage() const;
+
+	/**
+	 * Relay servers only: forward a simulation command or end of command
+	 * batch received from the upstream server to the observers of this relay.
+	 * Must be called for every such message, even before StartRelay.
+	 */
+	void RelayMessage(const CNetMessage* message);
+
+	/**
+	 * Relay servers only: forward the player assignments of the upstream game.
+	 */
+	void RelayPlayerAssignments(const PlayerAssignmentMap& playerAssignments);
+
+	/**
+	 * Relay servers only: replace the cached game state sent to joining
+	 * observers. @param joinSyncFile is in the format sent to rejoining clients.
+	 */
+	void UpdateRelaySnapshot(std::string joinSyncFile);
+
+	/**
+	 * Relay servers only: start accepting observers once the relaying client
+	 * is in game. Observers are refused before that.
+	 */
+	void StartRelay(const CStr& initAttribs, std::string joinSyncFile);
+
 private:
 	CNetServerWorker* m_Worker;
 	const bool m_LobbyAuth;
@@ -226,8 +262,9 @@ public:
 
 private:
 	friend class CNetServer;
+	friend class TestNetServerTurnManager;
 
-	CNetServerWorker(const bool continuesSavedGame, const bool useLobbyAuth);
+	CNetServerWorker(const bool continuesSavedGame, const bool useLobbyAuth, const bool isRelay);
 	~CNetServerWorker();
 
 	bool CheckPassword(const std::string& password, const std::string& salt) const;
@@ -264,6 +301,27 @@ private:
 	 */
 	void StartSavedGame(const CStr& initAttribs);
 
+	/**
+	 * Switch a relay in game mode, new observers will be sent the given state.
+	 */
+	void StartRelay(const CStr& initAttribs);
+
+	/**
+	 * Handle a simulation command or end of command batch forwarded by the
+	 * relaying client.
+	 */
+	void HandleRelayedMessage(const std::vector<u8>& data);
+
+	/**
+	 * Replace the upstream player assignments, keeping those of our own observers.
+	 */
+	void SetRelayedPlayerAssignments(const PlayerAssignmentMap& playerAssignments);
+
+	/**
+	 * Send a simulation command to all clients in game and save it for rejoins.
+	 */
+	void BroadcastSimulationCommand(CSimulationRelayMessage&& message);
+
 	/**
 	 * Make a player name 'nicer' by limiting the length and removing forbidden characters etc.
 	 */
@@ -335,13 +393,18 @@ private:
 	 */
 	void CheckClientConnections();
 
+	/**
+	 * Adapt the turn length to the latency of the players, if enabled and
+	 * the host hasn't set a fixed turn length.
+	 */
+	void UpdateAdaptiveTurnLength();
+
 	void SendHolePunchingMessage(const CStr& ip, u16 port);
 
 	/**
 	 * Internal script context for (de)serializing script messages,
 	 * and for storing init attributes.
-	 * (TODO: we shouldn't bother deserializing (except for debug printing of messages),
-	 * we should just forward messages blindly and efficiently.)
+	 * Simulation commands are forwarded without deserializing them.
 	 */
 	ScriptInterface* m_ScriptInterface;
 
@@ -354,6 +417,11 @@ private:
 	 */
 	JS::PersistentRootedValue m_InitAttributes;
 
+	/**
+	 * Whether the init attributes enable cheats, cached when the game starts.
+	 */
+	bool m_CheatsEnabled = false;
+
 	/**
 	 * Whether this match continues a saved game.
 	 */
@@ -364,6 +432,13 @@ private:
 	 */
 	const bool m_LobbyAuth;
 
+	/**
+	 * Whether this server re-serves a game hosted elsewhere. Relays only take
+	 * observers, and turns are decided by the upstream server, so a slow
+	 * observer never holds back the players.
+	 */
+	const bool m_Relay;
+
 	ENetHost* m_Host;
 	std::vector<CNetServerSession*> m_Sessions;
 
@@ -387,6 +462,12 @@ private:
 
 	CNetServerTurnManager* m_ServerTurnManager;
 
+	/**
+	 * Whether the host has set the turn length, which then isn't adapted
+	 * to the latency of the players anymore.
+	 */
+	bool m_FixedTurnLength = false;
+
 	/**
 	 * The GUID of the client in control of the game (the 'host' from the players' perspective).
 	 */
@@ -402,11 +483,17 @@ private:
 	 * turn number, to simplify support for rejoining etc.
 	 * TODO: verify this doesn't use too much RAM.
 	 */
-	std::vector<std::vector<CSimulationMessage>> m_SavedCommands;
+	std::vector<std::vector<CSimulationRelayMessage>> m_SavedCommands;
+
+	/**
+	 * Total serialized size of m_SavedCommands.
+	 */
+	size_t m_SavedCommandsSize = 0;
 
 	/**
 	 * The latest copy of the simulation state, received from an existing
 	 * client when a new client has asked to rejoin the game.
+	 * Relays keep a periodically refreshed snapshot here instead.
 	 */
 	std::string m_JoinSyncFile;
 
@@ -438,6 +525,9 @@ private:
 	std::thread m_WorkerThread;
 	std::mutex m_WorkerMutex;
 
+	// Written by the worker thread, read by CNetServer::GetMemoryUsage.
+	std::atomic<size_t> m_MemoryUsage{0};
+
 	// protected by m_WorkerMutex
 	bool m_Shutdown;
 
@@ -446,6 +536,10 @@ private:
 	std::vector<std::string> m_InitAttributesQueue;
 	std::vector<std::pair<CStr, CStr>> m_LobbyAuthQueue;
 	std::vector<u32> m_TurnLengthQueue;
+	std::vector<std::vector<u8>> m_RelayMessageQueue;
+	std::vector<PlayerAssignmentMap> m_RelayPlayerAssignmentsQueue;
+	std::vector<std::string> m_RelaySnapshotQueue;
+	std::vector<std::string> m_RelayStartQueue;
 };
 
 /// Global network server for the standard game
@@ -27,6 +27,8 @@
 #include "ps/ConfigDB.h"
 #include "simulation2/system/TurnManager.h"
 
+#include <algorithm>
+
 #if 0
 #include "ps/Util.h"
 #define NETSERVERTURN_LOG(...) debug_printf(__VA_ARGS__)
@@ -74,6 +76,10 @@ void CNetServerTurnManager::NotifyFinishedClientCommands(CNetServerSession& sess
 
 void CNetServerTurnManager::CheckClientsReady()
 {
+	// Relayed turns advance when the upstream server says so.
+	if (m_Relay)
+		return;
+
 	int max_observer_lag{g_ConfigDB.Get("network.observermaxlag", -1)};
 	// Clamp to 0-10000 turns, below/above that is no limit.
 	max_observer_lag = max_observer_lag < 0 ? -1 : max_observer_lag > 10000 ? -1 : max_observer_lag;
@@ -221,6 +227,37 @@ void CNetServerTurnManager::SetTurnLength(u32 msecs)
 	m_TurnLength = msecs;
 }
 
+void CNetServerTurnManager::OnRelayedCommandBatch(u32 turn, u32 turnLength)
+{
+	ENSURE(m_Relay);
+
+	if (turn <= m_ReadyTurn)
+		return;
+
+	// The relay may have joined in the middle of the game, the lengths of
+	// earlier turns are unknown but those turns are never sent to clients
+	// since they start from a snapshot taken later.
+	m_SavedTurnLengths.resize(turn, m_TurnLength);
+	m_SavedTurnLengths.push_back(turnLength);
+	m_ReadyTurn = turn;
+
+	CEndCommandBatchMessage msg;
+	msg.m_TurnLength = turnLength;
+	msg.m_Turn = turn;
+	m_NetServer.Multicast(&msg, { NSS_INGAME });
+}
+
+u32 CNetServerTurnManager::ComputeAdaptiveTurnLength(u32 rtt, u32 minTurnLength, u32 maxTurnLength)
+{
+	// A command issued during turn T is executed at T + COMMAND_DELAY_MP,
+	// the round trip has to fit in the turns before that. Keep a margin for
+	// jitter, and round so that small RTT changes don't change the turn length.
+	constexpr u32 TURN_LENGTH_STEP = 50;
+	const u32 needed = rtt * 5 / 4 / (COMMAND_DELAY_MP - 1);
+	const u32 rounded = (needed + TURN_LENGTH_STEP - 1) / TURN_LENGTH_STEP * TURN_LENGTH_STEP;
+	return std::clamp(rounded, minTurnLength, std::max(minTurnLength, maxTurnLength));
+}
+
 u32 CNetServerTurnManager::GetSavedTurnLength(u32 turn)
 {
 	ENSURE(turn <= m_ReadyTurn);
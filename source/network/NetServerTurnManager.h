@@ -1,4 +1,4 @@
-/* Copyright (C) 2021 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -57,6 +57,24 @@ public:
 
 	void SetTurnLength(u32 msecs);
 
+	/**
+	 * Pick the shortest turn length with which commands can go through the
+	 * server and back within the command delay, for the given round trip
+	 * time in milliseconds.
+	 */
+	static u32 ComputeAdaptiveTurnLength(u32 rtt, u32 minTurnLength, u32 maxTurnLength);
+
+	/**
+	 * Stop deciding turns locally, they are forwarded from another server
+	 * through OnRelayedCommandBatch. Clients can then never hold a turn back.
+	 */
+	void EnableRelay() { m_Relay = true; }
+
+	/**
+	 * Record a turn ended by the upstream server and tell all clients.
+	 */
+	void OnRelayedCommandBatch(u32 turn, u32 turnLength);
+
 	/**
 	 * Returns the latest turn for which all clients are ready;
 	 * they will have already been told to execute this turn.
@@ -85,6 +103,9 @@ private:
 
 	std::unordered_map<int, Client> m_ClientsData;
 
+	// Whether turns are forwarded from an upstream server.
+	bool m_Relay = false;
+
 	// Cached value - is any client OOS? This is reset when the OOS client leaves.
 	bool m_HasSyncError = false;
 
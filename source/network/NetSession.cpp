@@ -1,4 +1,4 @@
-/* Copyright (C) 2023 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -244,6 +244,12 @@ u32 CNetServerSession::GetIPAddress() const
 	return m_Peer->address.host;
 }
 
+void CNetClientSession::LatchTurnStats(const CNetTurnStats& turnStats)
+{
+	if (m_Stats)
+		m_Stats->LatchTurnStats(turnStats);
+}
+
 u32 CNetServerSession::GetLastReceivedTime() const
 {
 	if (!m_Peer)
@@ -1,4 +1,4 @@
-/* Copyright (C) 2024 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -22,6 +22,7 @@
 #include "network/FSM.h"
 #include "network/NetFileTransfer.h"
 #include "network/NetHost.h"
+#include "network/NetStats.h"
 #include "ps/CStr.h"
 
 #include <boost/lockfree/queue.hpp>
@@ -36,8 +37,6 @@ inline constexpr u32 NETWORK_WARNING_TIMEOUT = 2000;
 class CNetClient;
 class CNetServerWorker;
 
-class CNetStatsTable;
-
 typedef struct _ENetHost ENetHost;
 
 /**
@@ -105,6 +104,11 @@ public:
 	 */
 	u32 GetMeanRTT() const;
 
+	/**
+	 * Show the turn latency of this client in the profiler.
+	 */
+	void LatchTurnStats(const CNetTurnStats& turnStats);
+
 	CNetFileTransferer& GetFileTransferer() { return m_FileTransferer; }
 private:
 	/**
@@ -204,8 +208,16 @@ public:
 	 */
 	virtual bool SendMessage(const CNetMessage* message);
 
+	ENetPeer* GetPeer() const { return m_Peer; }
+
 	CNetFileTransferer& GetFileTransferer() { return m_FileTransferer; }
 
+	/**
+	 * Turn latency of the client, as measured by the server.
+	 */
+	CNetTurnStats& GetTurnStats() { return m_TurnStats; }
+	const CNetTurnStats& GetTurnStats() const { return m_TurnStats; }
+
 private:
 	CNetServerWorker& m_Server;
 
@@ -217,6 +229,8 @@ private:
 	CStrW m_UserName;
 	u32 m_HostID;
 	CStr m_Password;
+
+	CNetTurnStats m_TurnStats;
 };
 
 #endif	// NETSESSION_H
@@ -1,4 +1,4 @@
-/* Copyright (C) 2019 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -34,9 +34,66 @@ enum
 	Row_RTT,
 	Row_MTU,
 	Row_ReliableInTransit,
+	Row_RTTHistogram,
+	Row_CommandDelay,
+	Row_SimulationLag,
 	NumberRows
 };
 
+// The histogram rows aren't ENet peer members.
+constexpr size_t NumberPeerRows = Row_RTTHistogram;
+
+CNetLatencyHistogram::CNetLatencyHistogram(u32 window)
+	: m_Window(window)
+{
+}
+
+void CNetLatencyHistogram::Add(u32 value)
+{
+	// Halve everything once the window is full, so recent samples weigh more.
+	if (m_Count >= m_Window)
+	{
+		m_Count = 0;
+		for (u32& bucket : m_Buckets)
+		{
+			bucket /= 2;
+			m_Count += bucket;
+		}
+	}
+
+	size_t bucket = 0;
+	while (value >> bucket && bucket + 1 < NUMBER_OF_BUCKETS)
+		++bucket;
+
+	++m_Buckets[bucket];
+	++m_Count;
+	m_Max = std::max(m_Max, value);
+}
+
+u32 CNetLatencyHistogram::GetPercentile(double fraction) const
+{
+	const double target = fraction * m_Count;
+	u32 seen = 0;
+	for (size_t bucket = 0; bucket < NUMBER_OF_BUCKETS; ++bucket)
+	{
+		seen += m_Buckets[bucket];
+		if (seen == 0 || seen < target)
+			continue;
+		if (bucket == 0)
+			return 0;
+		return bucket + 1 == NUMBER_OF_BUCKETS ? m_Max : std::min(m_Max, (1u << bucket) - 1);
+	}
+	return m_Max;
+}
+
+CStr CNetLatencyHistogram::ToString() const
+{
+	if (!m_Count)
+		return "-";
+	return CStr::FromUInt(GetPercentile(0.5)) + " / " + CStr::FromUInt(GetPercentile(0.95)) +
+		" / " + CStr::FromUInt(m_Max);
+}
+
 CNetStatsTable::CNetStatsTable(const ENetPeer* peer)
 	: m_Peer(peer)
 {
@@ -90,6 +147,8 @@ CStr CNetStatsTable::GetCellText(size_t row, size_t col)
 		std::lock_guard<std::mutex> lock(m_Mutex);
 		if (col > 0 && m_LatchedData.size() > col-1 && m_LatchedData[col-1].size() > row)
 			return m_LatchedData[col-1][row];
+		if (col > 0 && m_Peer && row >= NumberPeerRows && m_LatchedTurnStats.size() > row - NumberPeerRows)
+			return m_LatchedTurnStats[row - NumberPeerRows];
 	}
 
 	#define ROW(id, title, member) \
@@ -112,6 +171,16 @@ CStr CNetStatsTable::GetCellText(size_t row, size_t col)
 	ROW(Row_MTU, "MTU", mtu);
 	ROW(Row_ReliableInTransit, "reliable data in transit", reliableDataInTransit);
 
+	case Row_RTTHistogram:
+		if (col == 0) return "RTT p50/p95/max (ms)";
+		return "-";
+	case Row_CommandDelay:
+		if (col == 0) return "command delay p50/p95/max (ms)";
+		return "-";
+	case Row_SimulationLag:
+		if (col == 0) return "simulation lag p50/p95/max (turns)";
+		return "-";
+
 	default:
 		return "???";
 	}
@@ -124,7 +193,7 @@ AbstractProfileTable* CNetStatsTable::GetChild(size_t UNUSED(row))
 	return 0;
 }
 
-void CNetStatsTable::LatchHostState(const ENetHost* host)
+void CNetStatsTable::LatchHostState(const ENetHost* host, const std::vector<const CNetTurnStats*>& turnStats)
 {
 	std::lock_guard<std::mutex> lock(m_Mutex);
 
@@ -147,6 +216,22 @@ void CNetStatsTable::LatchHostState(const ENetHost* host)
 		ROW(Row_RTT, "mean RTT", roundTripTime);
 		ROW(Row_MTU, "MTU", mtu);
 		ROW(Row_ReliableInTransit, "reliable data in transit", reliableDataInTransit);
+
+		const CNetTurnStats* stats = i < turnStats.size() ? turnStats[i] : nullptr;
+		m_LatchedData[i].push_back(stats ? stats->rtt.ToString() : "-");
+		m_LatchedData[i].push_back(stats ? stats->commandDelay.ToString() : "-");
+		m_LatchedData[i].push_back(stats ? stats->simulationLag.ToString() : "-");
 	}
 #undef ROW
 }
+
+void CNetStatsTable::LatchTurnStats(const CNetTurnStats& turnStats)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	m_LatchedTurnStats = {
+		turnStats.rtt.ToString(),
+		turnStats.commandDelay.ToString(),
+		turnStats.simulationLag.ToString()
+	};
+}
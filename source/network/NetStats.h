@@ -1,4 +1,4 @@
-/* Copyright (C) 2023 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -20,12 +20,64 @@
 
 #include "ps/ProfileViewer.h"
 
+#include <array>
 #include <mutex>
 #include <vector>
 
 typedef struct _ENetPeer ENetPeer;
 typedef struct _ENetHost ENetHost;
 
+/**
+ * Distribution of a latency-like value (milliseconds or turns), in power of
+ * two buckets. Old samples are progressively forgotten so the distribution
+ * follows changing network conditions.
+ */
+class CNetLatencyHistogram
+{
+public:
+	/**
+	 * @param window approximate number of recent samples that are kept.
+	 */
+	CNetLatencyHistogram(u32 window = 256);
+
+	void Add(u32 value);
+
+	u32 GetCount() const { return m_Count; }
+
+	/**
+	 * @return an upper bound of the given fraction of the samples,
+	 * or 0 if there are none.
+	 */
+	u32 GetPercentile(double fraction) const;
+
+	/**
+	 * @return "p50 / p95 / max" for display.
+	 */
+	CStr ToString() const;
+
+private:
+	// Bucket 0 counts zeros, bucket i counts values in [2^(i-1), 2^i).
+	static constexpr size_t NUMBER_OF_BUCKETS = 18;
+	std::array<u32, NUMBER_OF_BUCKETS> m_Buckets{};
+	u32 m_Window;
+	u32 m_Count = 0;
+	u32 m_Max = 0;
+};
+
+/**
+ * Turn-stream latency of a single client.
+ */
+struct CNetTurnStats
+{
+	// Round trip time to the server, in milliseconds.
+	CNetLatencyHistogram rtt;
+	// Time between issuing a command and executing it, in milliseconds.
+	// Only known by the issuing client.
+	CNetLatencyHistogram commandDelay;
+	// Number of turns which were ready but not simulated yet.
+	CNetLatencyHistogram simulationLag;
+};
+
 /**
  * ENet connection statistics profiler table.
  *
@@ -49,7 +101,16 @@ public:
 	CStr GetCellText(size_t row, size_t col) override;
 	AbstractProfileTable* GetChild(size_t row) override;
 
-	void LatchHostState(const ENetHost* host);
+	/**
+	 * @param turnStats latency of the client behind each peer of the host,
+	 * or nullptr if unknown.
+	 */
+	void LatchHostState(const ENetHost* host, const std::vector<const CNetTurnStats*>& turnStats);
+
+	/**
+	 * Update the turn latency rows of a client table.
+	 */
+	void LatchTurnStats(const CNetTurnStats& turnStats);
 
 private:
 	const ENetPeer* m_Peer;
@@ -57,6 +118,7 @@ private:
 
 	std::mutex m_Mutex;
 	std::vector<std::vector<CStr>> m_LatchedData; // protected by m_Mutex
+	std::vector<CStr> m_LatchedTurnStats; // protected by m_Mutex, client only
 };
 
 #endif // INCLUDED_NETSTATS
@@ -156,6 +156,37 @@ void StartNetworkJoin(const ScriptRequest& rq, const CStrW& playerName, const CS
 	}
 }
 
+/**
+ * Join a game as an observer and re-serve it on relayPort, so that other
+ * observers can watch without adding to the host's upload.
+ */
+void StartNetworkRelay(const ScriptRequest& rq, const CStrW& playerName, const CStr& serverAddress, u16 serverPort, u16 relayPort, bool storeReplay)
+{
+	ENSURE(!g_NetClient);
+	ENSURE(!g_NetServer);
+	ENSURE(!g_Game);
+
+	g_Game = new CGame(storeReplay);
+	g_NetClient = new CNetClient(g_Game);
+	g_NetClient->SetUserName(playerName);
+	g_NetClient->SetupServerData(serverAddress, serverPort);
+
+	if (!g_NetClient->SetupRelay(relayPort))
+	{
+		ScriptException::Raise(rq, "Failed to start relay");
+		SAFE_DELETE(g_NetClient);
+		SAFE_DELETE(g_Game);
+		return;
+	}
+
+	if (!g_NetClient->SetupConnection(nullptr))
+	{
+		ScriptException::Raise(rq, "Failed to connect to server");
+		SAFE_DELETE(g_NetClient);
+		SAFE_DELETE(g_Game);
+	}
+}
+
 /**
  * Requires XmppClient to send iq request to the server to get server's ip and port based on passed password.
  * This is needed to not force server to share it's public ip with all potential clients in the lobby.
@@ -334,6 +365,7 @@ void RegisterScriptFunctions(const ScriptRequest& rq)
 	ScriptFunction::Register<&StartNetworkHost>(rq, "StartNetworkHost");
 	ScriptFunction::Register<&StartNetworkJoin>(rq, "StartNetworkJoin");
 	ScriptFunction::Register<&StartNetworkJoinLobby>(rq, "StartNetworkJoinLobby");
+	ScriptFunction::Register<&StartNetworkRelay>(rq, "StartNetworkRelay");
 	ScriptFunction::Register<&DisconnectNetworkGame>(rq, "DisconnectNetworkGame");
 	ScriptFunction::Register<&GetPlayerGUID>(rq, "GetPlayerGUID");
 	ScriptFunction::Register<&PollNetworkClient>(rq, "PollNetworkClient");
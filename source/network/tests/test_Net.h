@@ -18,9 +18,11 @@
 #include "lib/self_test.h"
 
 #include "graphics/TerrainTextureManager.h"
+#include "lib/alignment.h"
 #include "lib/external_libraries/enet.h"
 #include "lib/external_libraries/libsdl.h"
 #include "lib/tex/tex.h"
+#include "network/DedicatedServer.h"
 #include "network/NetServer.h"
 #include "network/NetClient.h"
 #include "network/NetMessage.h"
@@ -34,6 +36,7 @@
 #include "simulation2/Simulation2.h"
 #include "simulation2/system/TurnManager.h"
 
+#include <memory>
 #include <optional>
 
 class TestNetComms : public CxxTest::TestSuite
@@ -381,4 +384,62 @@ public:
 			wait(clients, 100);
 		}
 	}
+
+	void DISABLED_test_dedicated_server_soak()
+	{
+		// Hosts several games in one process and keeps scripted clients
+		// chatting on each of them for a while, printing the memory used by every game.
+
+		TestStdoutLogger logger;
+
+		const std::vector<u16> ports{ PS_DEFAULT_PORT, PS_DEFAULT_PORT + 1, PS_DEFAULT_PORT + 2 };
+		const std::string secret = "soak";
+		CDedicatedServer server(ports, secret);
+		TS_ASSERT_EQUALS(server.GetNumberOfGames(), ports.size());
+
+		std::vector<std::unique_ptr<CGame>> games;
+		std::vector<std::unique_ptr<CNetClient>> netClients;
+		std::vector<CNetClient*> clients;
+		for (const u16 port : ports)
+			for (size_t i = 0; i < 4; ++i)
+			{
+				games.emplace_back(std::make_unique<CGame>(false));
+				netClients.emplace_back(std::make_unique<CNetClient>(games.back().get()));
+				CNetClient& client = *netClients.back();
+				client.SetUserName(L"player" + std::to_wstring(clients.size()));
+				// The first client of every game controls it.
+				if (i == 0)
+					client.SetControllerSecret(secret);
+				client.SetupServerData("127.0.0.1", port);
+				TS_ASSERT(client.SetupConnection(nullptr));
+				clients.push_back(&client);
+			}
+
+		for (size_t i = 0; !clients_are_all(clients, NCS_PREGAME); ++i)
+		{
+			for (CNetClient* client : clients)
+				client->Poll();
+
+			if (i > 100)
+			{
+				TS_FAIL("connection timeout");
+				return;
+			}
+
+			SDL_Delay(100);
+		}
+
+		for (size_t round = 0; round < 100; ++round)
+		{
+			for (CNetClient* client : clients)
+				client->SendChatMessage(L"soak", std::nullopt);
+			wait(clients, 50);
+		}
+
+		for (size_t game = 0; game < server.GetNumberOfGames(); ++game)
+		{
+			TS_ASSERT_LESS_THAN(0u, server.GetGameMemoryUsage(game));
+			debug_printf("Game on port %u uses %zu KiB\n", server.GetGamePort(game), server.GetGameMemoryUsage(game) / KiB);
+		}
+	}
 };
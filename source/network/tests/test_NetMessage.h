@@ -1,4 +1,4 @@
-/* Copyright (C) 2021 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -18,10 +18,15 @@
 #include "lib/self_test.h"
 
 #include "network/NetMessage.h"
+#include "ps/CLogger.h"
 
 #include "scriptinterface/ScriptInterface.h"
 #include "scriptinterface/Object.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 class TestNetMessage : public CxxTest::TestSuite
 {
 public:
@@ -49,4 +54,93 @@ public:
 		delete msg2;
 		delete[] buf;
 	}
+
+	size_t RoundTrip(const ScriptInterface& script, JS::HandleValue val)
+	{
+		CSimulationMessage msg(script, 1, 2, 3, val);
+		const size_t len = msg.GetSerializedLength();
+		std::vector<u8> buf(len);
+		TS_ASSERT_EQUALS(msg.Serialize(buf.data()) - buf.data(), static_cast<ptrdiff_t>(len));
+
+		std::unique_ptr<CNetMessage> msg2(CNetMessageFactory::CreateMessage(buf.data(), len, script));
+		TS_ASSERT_STR_EQUALS(static_cast<CSimulationMessage*>(msg2.get())->ToString(), msg.ToString());
+		return len;
+	}
+
+	void test_sim_compact_commands()
+	{
+		ScriptInterface script("Test", "Test", g_ScriptContext);
+		ScriptRequest rq(script);
+
+		const std::vector<i32> entities{ 200, 201, 203, 150, 151, 152 };
+
+		JS::RootedValue walk(rq.cx);
+		Script::CreateObject(rq, &walk, "type", "walk", "entities", entities, "x", 512.25, "z", 128,
+			"queued", false, "pushFront", true);
+		const size_t compactLength = RoundTrip(script, walk);
+
+		// Same command under an unknown type uses the generic encoding.
+		JS::RootedValue custom(rq.cx);
+		Script::CreateObject(rq, &custom, "type", "walk-custom", "entities", entities, "x", 512.25, "z", 128,
+			"queued", false, "pushFront", true);
+		TS_ASSERT_LESS_THAN(compactLength, RoundTrip(script, custom));
+
+		// Property order is kept.
+		JS::RootedValue stance(rq.cx);
+		Script::CreateObject(rq, &stance, "entities", entities, "name", "violent", "type", "stance");
+		RoundTrip(script, stance);
+
+		JS::RootedValue train(rq.cx);
+		Script::CreateObject(rq, &train, "type", "train", "entities", std::vector<i32>{ 5 },
+			"template", std::string("units/athen/infantry_spearman_b"), "count", 5, "pushFront", false);
+		RoundTrip(script, train);
+
+		// Values of an unexpected kind or unknown properties fall back to the generic encoding.
+		JS::RootedValue formation(rq.cx);
+		Script::CreateObject(rq, &formation, "type", "formation", "entities", entities, "formation", JS::NullHandleValue);
+		RoundTrip(script, formation);
+
+		JS::RootedValue attack(rq.cx);
+		Script::CreateObject(rq, &attack, "type", "attack", "entities", entities, "target", 42,
+			"allowCapture", true, "targetClasses", "Unit");
+		RoundTrip(script, attack);
+
+		JS::RootedValue gather(rq.cx);
+		Script::CreateObject(rq, &gather, "type", "gather", "entities", std::vector<i32>{ 1, -1 }, "target", 42);
+		RoundTrip(script, gather);
+	}
+
+	void test_sim_relay()
+	{
+		ScriptInterface script("Test", "Test", g_ScriptContext);
+		ScriptRequest rq(script);
+
+		JS::RootedValue val(rq.cx);
+		Script::CreateObject(rq, &val, "type", "stance", "entities", std::vector<i32>{ 10, 11 }, "name", "violent");
+
+		CSimulationMessage msg(script, 1, -1, 3, val);
+		std::vector<u8> buf(msg.GetSerializedLength());
+		msg.Serialize(buf.data());
+
+		std::unique_ptr<CNetMessage> relayed(CNetMessageFactory::CreateMessage(buf.data(), buf.size(), script, true));
+		CSimulationRelayMessage* relay = static_cast<CSimulationRelayMessage*>(relayed.get());
+		TS_ASSERT_EQUALS(relay->m_Client, 1u);
+		TS_ASSERT_EQUALS(relay->m_Player, -1);
+		TS_ASSERT_EQUALS(relay->m_Turn, 3u);
+		TS_ASSERT(!relay->m_Command.empty());
+
+		// The relayed message is written back unchanged.
+		TS_ASSERT_EQUALS(relay->GetSerializedLength(), buf.size());
+		std::vector<u8> relayBuf(relay->GetSerializedLength());
+		TS_ASSERT_EQUALS(relay->Serialize(relayBuf.data()) - relayBuf.data(), static_cast<ptrdiff_t>(relayBuf.size()));
+		TS_ASSERT(relayBuf == buf);
+
+		// A truncated header doesn't produce a command.
+		buf.resize(8);
+		buf[1] = 0;
+		buf[2] = 8;
+		TestLogger nolog;
+		std::unique_ptr<CNetMessage> corrupt(CNetMessageFactory::CreateMessage(buf.data(), buf.size(), script, true));
+		TS_ASSERT(static_cast<CSimulationRelayMessage*>(corrupt.get())->m_Command.empty());
+	}
 };
@@ -0,0 +1,98 @@
+/* Copyright (C) 2025 Wildfire Games.
+ * This file is part of 0 A.D.
+ *
+ * 0 A.D. is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * 0 A.D. is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 0 A.D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lib/self_test.h"
+
+#include "lib/external_libraries/enet.h"
+#include "network/NetServer.h"
+#include "network/NetServerTurnManager.h"
+#include "simulation2/system/TurnManager.h"
+
+class TestNetServerTurnManager : public CxxTest::TestSuite
+{
+	/**
+	 * A relay server which isn't listening. Batches are multicast to its
+	 * (nonexistent) sessions through an unbound host.
+	 */
+	CNetServerWorker* CreateRelayWorker()
+	{
+		CNetServerWorker* worker = new CNetServerWorker(false, false, true);
+		worker->m_Host = enet_host_create(nullptr, 1, 1, 0, 0);
+		TS_ASSERT(worker->m_Host);
+		return worker;
+	}
+
+public:
+	void setUp()
+	{
+		enet_initialize();
+	}
+
+	void tearDown()
+	{
+		enet_deinitialize();
+	}
+
+	void test_relayed_command_batches()
+	{
+		CNetServerWorker* worker = CreateRelayWorker();
+		CNetServerTurnManager& turnManager = *worker->m_ServerTurnManager;
+
+		TS_ASSERT_EQUALS(turnManager.GetReadyTurn(), COMMAND_DELAY_MP - 1);
+
+		turnManager.OnRelayedCommandBatch(COMMAND_DELAY_MP, 300);
+		TS_ASSERT_EQUALS(turnManager.GetReadyTurn(), COMMAND_DELAY_MP);
+		TS_ASSERT_EQUALS(turnManager.GetSavedTurnLength(COMMAND_DELAY_MP), 300u);
+
+		// Batches arriving again or out of order are ignored.
+		turnManager.OnRelayedCommandBatch(COMMAND_DELAY_MP, 500);
+		turnManager.OnRelayedCommandBatch(COMMAND_DELAY_MP - 1, 500);
+		TS_ASSERT_EQUALS(turnManager.GetReadyTurn(), COMMAND_DELAY_MP);
+		TS_ASSERT_EQUALS(turnManager.GetSavedTurnLength(COMMAND_DELAY_MP), 300u);
+
+		// A relay joining in the middle of a game only knows the turns it was sent.
+		turnManager.OnRelayedCommandBatch(20, 400);
+		TS_ASSERT_EQUALS(turnManager.GetReadyTurn(), 20u);
+		TS_ASSERT_EQUALS(turnManager.GetSavedTurnLength(20), 400u);
+		TS_ASSERT_EQUALS(turnManager.GetSavedTurnLength(19), DEFAULT_TURN_LENGTH);
+		TS_ASSERT_EQUALS(turnManager.GetSavedTurnLength(COMMAND_DELAY_MP), 300u);
+
+		delete worker;
+	}
+
+	void test_relay_clients_dont_hold_turns()
+	{
+		CNetServerWorker* worker = CreateRelayWorker();
+		CNetServerTurnManager& turnManager = *worker->m_ServerTurnManager;
+
+		// Neither a lagging observer nor one leaving the game changes the
+		// ready turn, only upstream batches do.
+		turnManager.InitialiseClient(1, 0, true);
+		turnManager.InitialiseClient(2, 0, true);
+		turnManager.UninitialiseClient(2);
+		TS_ASSERT_EQUALS(turnManager.GetReadyTurn(), COMMAND_DELAY_MP - 1);
+
+		for (u32 turn = COMMAND_DELAY_MP; turn < COMMAND_DELAY_MP + 10; ++turn)
+			turnManager.OnRelayedCommandBatch(turn, DEFAULT_TURN_LENGTH);
+		TS_ASSERT_EQUALS(turnManager.GetReadyTurn(), COMMAND_DELAY_MP + 9);
+
+		turnManager.UninitialiseClient(1);
+		TS_ASSERT_EQUALS(turnManager.GetReadyTurn(), COMMAND_DELAY_MP + 9);
+
+		delete worker;
+	}
+};
@@ -0,0 +1,93 @@
+/* Copyright (C) 2025 Wildfire Games.
+ * This file is part of 0 A.D.
+ *
+ * 0 A.D. is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * 0 A.D. is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 0 A.D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lib/self_test.h"
+
+#include "network/NetServerTurnManager.h"
+#include "network/NetStats.h"
+#include "simulation2/system/TurnManager.h"
+
+class TestNetStats : public CxxTest::TestSuite
+{
+	/**
+	 * Feed the histogram with the RTT of a link with the given base latency,
+	 * and an occasional spike every @p spikePeriod samples.
+	 */
+	void SimulateLink(CNetLatencyHistogram& histogram, u32 samples, u32 latency, u32 spike, u32 spikePeriod)
+	{
+		for (u32 i = 0; i < samples; ++i)
+			histogram.Add(latency + (i % 7) * 3 + (i % spikePeriod == 0 ? spike : 0));
+	}
+
+public:
+	void test_histogram()
+	{
+		CNetLatencyHistogram histogram;
+		TS_ASSERT_EQUALS(histogram.GetCount(), 0u);
+		TS_ASSERT_EQUALS(histogram.GetPercentile(0.5), 0u);
+		TS_ASSERT_EQUALS(histogram.ToString(), "-");
+
+		for (u32 i = 0; i < 90; ++i)
+			histogram.Add(10);
+		for (u32 i = 0; i < 10; ++i)
+			histogram.Add(1000);
+
+		TS_ASSERT_EQUALS(histogram.GetCount(), 100u);
+		// Percentiles are the upper bound of their power of two bucket.
+		TS_ASSERT_EQUALS(histogram.GetPercentile(0.5), 15u);
+		TS_ASSERT_EQUALS(histogram.GetPercentile(0.95), 1000u);
+		TS_ASSERT_EQUALS(histogram.ToString(), "15 / 1000 / 1000");
+
+		histogram.Add(0);
+		TS_ASSERT_EQUALS(histogram.GetPercentile(0.0), 0u);
+	}
+
+	void test_histogram_window()
+	{
+		CNetLatencyHistogram histogram(64);
+		SimulateLink(histogram, 64, 400, 0, 1000);
+		TS_ASSERT_LESS_THAN_EQUALS(400u, histogram.GetPercentile(0.5));
+
+		// Once the link improves, old samples fade out.
+		SimulateLink(histogram, 256, 20, 0, 1000);
+		TS_ASSERT_LESS_THAN_EQUALS(histogram.GetCount(), 64u);
+		TS_ASSERT_LESS_THAN(histogram.GetPercentile(0.95), 64u);
+	}
+
+	void test_adaptive_turn_length()
+	{
+		// LAN: stay at the minimum.
+		CNetLatencyHistogram lan;
+		SimulateLink(lan, 200, 2, 5, 50);
+		TS_ASSERT_EQUALS(CNetServerTurnManager::ComputeAdaptiveTurnLength(lan.GetPercentile(0.95), 200, 500), 200u);
+
+		// Far away player, with spikes too rare to matter.
+		CNetLatencyHistogram far;
+		SimulateLink(far, 200, 560, 400, 50);
+		const u32 farTurnLength = CNetServerTurnManager::ComputeAdaptiveTurnLength(far.GetPercentile(0.95), 200, 500);
+		TS_ASSERT_LESS_THAN(200u, farTurnLength);
+		TS_ASSERT_LESS_THAN(farTurnLength, 500u);
+		TS_ASSERT_EQUALS(farTurnLength % 50, 0u);
+		// The round trip fits in the command delay.
+		TS_ASSERT_LESS_THAN_EQUALS(far.GetPercentile(0.95), farTurnLength * (COMMAND_DELAY_MP - 1));
+
+		// Unplayable links are capped.
+		TS_ASSERT_EQUALS(CNetServerTurnManager::ComputeAdaptiveTurnLength(5000, 200, 500), 500u);
+		// Bad bounds don't go below the minimum.
+		TS_ASSERT_EQUALS(CNetServerTurnManager::ComputeAdaptiveTurnLength(5000, 200, 100), 200u);
+	}
+};
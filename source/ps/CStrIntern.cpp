@@ -1,4 +1,4 @@
-/* Copyright (C) 2024 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -20,90 +20,92 @@
 #include "CStrIntern.h"
 
 #include "lib/fnv_hash.h"
-#include "ps/CLogger.h"
-#include "ps/ThreadUtil.h"
 
+#include <array>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
 #include <unordered_map>
 
 class CStrInternInternals
 {
 public:
-	CStrInternInternals(const char* str, size_t len)
-		: data(str, str+len), hash(fnv_hash(str, len))
+	CStrInternInternals(const char* str, size_t len, u32 hash)
+		: data(str, str+len), hash(hash)
 	{
-// 		LOGWARNING("New interned string '%s'", data.c_str());
 	}
 
-	CStrInternInternals(const CStrInternInternals& b) = default;
-
-	bool operator==(const CStrInternInternals& b) const
-	{
-		// Compare hash first for quick rejection of inequal strings
-		return (hash == b.hash && data == b.data);
-	}
+	CStrInternInternals(const CStrInternInternals&) = delete;
+	CStrInternInternals& operator=(const CStrInternInternals&) = delete;
 
 	const std::string data;
 	const u32 hash; // fnv_hash of data
-
-private:
-	CStrInternInternals& operator=(const CStrInternInternals&);
 };
 
-// Interned strings are stored in a hash table, indexed by string:
-
-using StringsKey = std::string;
-
-struct StringsKeyHash
+namespace
 {
-	size_t operator()(const StringsKey& key) const
-	{
-		return fnv_hash(key.c_str(), key.length());
-	}
-};
+// Interned strings are stored in hash tables indexed by a view of the string
+// and its hash, so lookups hash the string only once and don't need to
+// allocate a std::string. The views point into the (never moved) internals.
 
-// To avoid std::string memory allocations when GetString does lookups in the
-// hash table of interned strings, we make use of std::unordered_map's ability
-// to do lookups with a functionally equivalent proxy object:
-
-struct StringsKeyProxy
+struct StringsKey
 {
-	const char* str;
-	size_t len;
-};
+	std::string_view str;
+	u32 hash;
 
-struct StringsKeyProxyHash
-{
-	size_t operator()(const StringsKeyProxy& key) const
+	bool operator==(const StringsKey& other) const
 	{
-		return fnv_hash(key.str, key.len);
+		// Compare hash first for quick rejection of inequal strings
+		return hash == other.hash && str == other.str;
 	}
 };
 
-struct StringsKeyProxyEq
+struct StringsKeyHash
 {
-	bool operator()(const StringsKeyProxy& proxy, const StringsKey& key) const
+	size_t operator()(const StringsKey& key) const
 	{
-		return (proxy.len == key.length() && memcmp(proxy.str, key.c_str(), proxy.len) == 0);
+		return key.hash;
 	}
 };
 
-namespace
+// The strings are split into shards by their hash, each with its own lock,
+// so threads interning different strings rarely wait for each other.
+// Lookups of existing strings (by far the most common case) only need a
+// shared lock.
+constexpr size_t STRINGS_SHARD_BITS = 4;
+
+struct StringsShard
 {
-std::unordered_map<StringsKey, CStrInternInternals, StringsKeyHash> g_Strings;
+	std::shared_mutex mutex;
+	std::unordered_map<StringsKey, std::unique_ptr<CStrInternInternals>, StringsKeyHash> strings;
+};
+
+std::array<StringsShard, 1 << STRINGS_SHARD_BITS> g_Strings;
 
 CStrInternInternals* GetString(const char* str, size_t len)
 {
-	// g_Strings is not thread-safe, so complain if anyone is using this
-	// type in non-main threads. (If that's desired, g_Strings should be changed
-	// to be thread-safe, preferably without sacrificing performance.)
-	ENSURE(Threading::IsMainThread());
+	const StringsKey key{std::string_view{str, len}, fnv_hash(str, len)};
+	// The low bits of the hash select the bucket inside the shard.
+	StringsShard& shard = g_Strings[key.hash >> (32 - STRINGS_SHARD_BITS)];
 
-	const auto it = g_Strings.find(str);
+	{
+		std::shared_lock<std::shared_mutex> lock(shard.mutex);
+		const auto it = shard.strings.find(key);
+		if (it != shard.strings.end())
+			return it->second.get();
+	}
 
-	if (it != g_Strings.end())
-		return &it->second;
+	std::lock_guard<std::shared_mutex> lock(shard.mutex);
+	// Another thread might have added the string in the meantime.
+	const auto it = shard.strings.find(key);
+	if (it != shard.strings.end())
+		return it->second.get();
 
-	return &g_Strings.insert({str, {str, len}}).first->second;
+	std::unique_ptr<CStrInternInternals> internals{std::make_unique<CStrInternInternals>(str, len, key.hash)};
+	CStrInternInternals* ret = internals.get();
+	shard.strings.emplace(StringsKey{std::string_view{ret->data}, key.hash}, std::move(internals));
+	return ret;
 }
 }
 
@@ -1,4 +1,4 @@
-/* Copyright (C) 2021 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -32,7 +32,10 @@ class CStrInternInternals;
  * unbounded numbers of strings (e.g. text rendered by gameplay scripts) -
  * it's intended for a small number of short frequently-used strings.
  *
- * Not thread-safe - only allocate these strings from the main thread.
+ * Thread-safe: strings can be interned from any thread. The table is sharded
+ * and lookups of existing strings only take a shared lock, but interning is
+ * still much slower than copying, so keep CStrInterns around rather than
+ * constructing them from strings repeatedly.
  */
 class CStrIntern
 {
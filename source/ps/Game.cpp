@@ -49,6 +49,7 @@
 #include "simulation2/Simulation2.h"
 #include "simulation2/components/ICmpPlayer.h"
 #include "simulation2/components/ICmpPlayerManager.h"
+#include "simulation2/components/ICmpSoundManager.h"
 #include "simulation2/system/ReplayTurnManager.h"
 #include "soundmanager/ISoundManager.h"
 #include "tools/atlas/GameInterface/GameLoop.h"
@@ -343,6 +344,11 @@ PSRETURN CGame::ReallyStartGame()
 	if (CRenderer::IsInitialised())
 		g_Renderer.PreloadResourcesBeforeNextFrame();
 
+	// Decode the sounds of the map in the background to avoid stalls on their first play.
+	CmpPtr<ICmpSoundManager> cmpSoundManager(*m_Simulation2, SYSTEM_ENTITY);
+	if (cmpSoundManager)
+		cmpSoundManager->PrefetchSoundGroups();
+
 	if (g_NetClient)
 		g_NetClient->LoadFinished();
 
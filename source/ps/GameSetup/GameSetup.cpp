@@ -140,17 +140,32 @@ void MountMods(const Paths& paths, const std::vector<CStr>& mods)
 
 	size_t userFlags = VFS_MOUNT_WATCH|VFS_MOUNT_ARCHIVABLE;
 	size_t baseFlags = userFlags|VFS_MOUNT_MUST_EXIST;
+	// Installed mods aren't edited while the game runs, so large files can be mapped.
+	if (!InDevelopmentCopy())
+		baseFlags |= VFS_MOUNT_MAP_FILES;
+	// Only mount mods from the user path if they don't exist in the 'rdata' path.
+	std::vector<std::pair<OsPath, size_t>> mounts;
+	for (const CStr& mod : mods)
+	{
+		const OsPath modName(mod);
+		if (DirectoryExists(modPath / modName / ""))
+			mounts.emplace_back(modPath / modName / "", baseFlags);
+		else
+			mounts.emplace_back(modUserPath / modName / "", userFlags);
+	}
+
+	// Each mod is populated right after mounting it (see the config lookup
+	// below), so start reading the archives of all of them first.
+	for (const std::pair<OsPath, size_t>& mount : mounts)
+		if (DirectoryExists(mount.first))
+			g_VFS->PrefetchArchives(mount.first);
+
 	size_t priority = 0;
 	for (size_t i = 0; i < mods.size(); ++i)
 	{
 		priority = i + 1; // Mods are higher priority than regular mountings, which default to priority 0
 
-		OsPath modName(mods[i]);
-		// Only mount mods from the user path if they don't exist in the 'rdata' path.
-		if (DirectoryExists(modPath / modName / ""))
-			g_VFS->Mount(L"", modPath / modName / "", baseFlags, priority);
-		else
-			g_VFS->Mount(L"", modUserPath / modName / "", userFlags, priority);
+		g_VFS->Mount(L"", mounts[i].first, mounts[i].second, priority);
 
 		// If mod have a config/<modName>.cfg, load the configuration.
 		VfsPath modConfigPath{fmt::format("config/{}.cfg", mods[i].c_str())};
@@ -596,7 +611,7 @@ bool Init(const CmdLineArgs& args, int flags)
 	CNetHost::Initialize();
 
 #if CONFIG2_AUDIO
-	if (!args.Has("autostart-nonvisual") && !g_DisableAudio)
+	if (!args.Has("autostart-nonvisual") && !args.Has("dedicated-server") && !g_DisableAudio)
 		ISoundManager::CreateSoundManager();
 #endif
 
@@ -607,6 +622,10 @@ bool Init(const CmdLineArgs& args, int flags)
 	if (g_ConfigDB.Get("profiler2.autoenable", false))
 		g_Profiler2.EnableHTTP();
 
+	// Optionally write all profiler items to a trace file
+	if (args.Has("profiler2-trace") || g_ConfigDB.Get("profiler2.trace", false))
+		g_Profiler2.EnableTrace();
+
 	// Initialise everything except Win32 sockets (because our networking
 	// system already inits those)
 	curl_global_init(CURL_GLOBAL_ALL & ~CURL_GLOBAL_WIN32);
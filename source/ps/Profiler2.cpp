@@ -33,6 +33,8 @@
 #include "ps/Pyrogenesis.h"
 #include "third_party/mongoose/mongoose.h"
 
+#include <chrono>
+#include <condition_variable>
 #include <fmt/format.h>
 #include <fstream>
 #include <iomanip>
@@ -54,7 +56,7 @@ const u8 CProfiler2::RESYNC_MAGIC[8] = {0x11, 0x22, 0x33, 0x44, 0xf4, 0x93, 0xbe
 thread_local CProfiler2::ThreadStorage* CProfiler2::m_CurrentStorage = nullptr;
 
 CProfiler2::CProfiler2() :
-	m_Initialised(false), m_FrameNumber(0), m_MgContext(NULL), m_GPU(NULL)
+	m_Initialised(false), m_FrameNumber(0), m_MgContext(NULL), m_GPU(NULL), m_Trace(NULL)
 {
 }
 
@@ -244,6 +246,8 @@ void CProfiler2::Shutdown()
 
 	ENSURE(!m_GPU); // must shutdown GPU before profiler
 
+	ShutdownTrace();
+
 	if (m_MgContext)
 	{
 		mg_stop(m_MgContext);
@@ -309,6 +313,9 @@ void CProfiler2::RemoveThreadStorage(ThreadStorage* storage)
 CProfiler2::ThreadStorage::ThreadStorage(CProfiler2& profiler, const std::string& name) :
 m_Profiler(profiler), m_Name(name), m_BufferPos0(0), m_BufferPos1(0), m_LastTime(timer_Time())
 {
+	// Buffer positions wrap around at 2^32 (see m_BufferPos0)
+	static_assert((u64(1) << 32) % BUFFER_SIZE == 0, "BUFFER_SIZE must divide 2^32");
+
 	m_Buffer = new u8[BUFFER_SIZE];
 	memset(m_Buffer, ITEM_NOP, BUFFER_SIZE);
 }
@@ -323,22 +330,25 @@ void CProfiler2::ThreadStorage::Write(EItem type, const void* item, u32 itemSize
 	// See m_BufferPos0 etc for comments on synchronisation
 
 	u32 size = 1 + itemSize;
-	u32 start = m_BufferPos0;
+	u32 pos = m_BufferPos0;
+	u32 start = pos % BUFFER_SIZE;
 	if (start + size > BUFFER_SIZE)
 	{
 		// The remainder of the buffer is too small - fill the rest
 		// with NOPs then start from offset 0, so we don't have to
 		// bother splitting the real item across the end of the buffer
 
-		m_BufferPos0 = size;
+		const u32 padding = BUFFER_SIZE - start;
+		pos += padding;
+		m_BufferPos0 = pos + size;
 		COMPILER_FENCE; // must write m_BufferPos0 before m_Buffer
 
-		memset(m_Buffer + start, 0, BUFFER_SIZE - start);
+		memset(m_Buffer + start, 0, padding);
 		start = 0;
 	}
 	else
 	{
-		m_BufferPos0 = start + size;
+		m_BufferPos0 = pos + size;
 		COMPILER_FENCE; // must write m_BufferPos0 before m_Buffer
 	}
 
@@ -346,7 +356,7 @@ void CProfiler2::ThreadStorage::Write(EItem type, const void* item, u32 itemSize
 	memcpy(&m_Buffer[start + 1], item, itemSize);
 
 	COMPILER_FENCE; // must write m_BufferPos1 after m_Buffer
-	m_BufferPos1 = start + size;
+	m_BufferPos1 = pos + size;
 }
 
 std::string CProfiler2::ThreadStorage::GetBuffer()
@@ -357,13 +367,13 @@ std::string CProfiler2::ThreadStorage::GetBuffer()
 
 	std::shared_ptr<u8> buffer(new u8[BUFFER_SIZE], ArrayDeleter());
 
-	u32 pos1 = m_BufferPos1;
+	u32 pos1 = m_BufferPos1 % BUFFER_SIZE;
 	COMPILER_FENCE; // must read m_BufferPos1 before m_Buffer
 
 	memcpy(buffer.get(), m_Buffer, BUFFER_SIZE);
 
 	COMPILER_FENCE; // must read m_BufferPos0 after m_Buffer
-	u32 pos0 = m_BufferPos0;
+	u32 pos0 = m_BufferPos0 % BUFFER_SIZE;
 
 	// The range [pos1, pos0) modulo BUFFER_SIZE is invalid, so concatenate the rest of the buffer
 
@@ -373,6 +383,40 @@ std::string CProfiler2::ThreadStorage::GetBuffer()
 		return std::string(buffer.get()+pos0, buffer.get()+pos1);
 }
 
+std::string CProfiler2::ThreadStorage::GetBufferSince(u32& pos, bool& complete)
+{
+	// Called from an arbitrary thread (not the one writing to the buffer).
+	//
+	// See comments on m_BufferPos0 etc.
+
+	u32 pos1 = m_BufferPos1;
+	COMPILER_FENCE; // must read m_BufferPos1 before m_Buffer
+
+	// Anything more than BUFFER_SIZE behind has been overwritten already
+	u32 start = pos1 - pos > BUFFER_SIZE ? pos1 - (u32)BUFFER_SIZE : pos;
+
+	std::string buffer(pos1 - start, '\0');
+	const u32 offset = start % BUFFER_SIZE;
+	const size_t firstPart = std::min(buffer.size(), BUFFER_SIZE - offset);
+	memcpy(&buffer[0], m_Buffer + offset, firstPart);
+	memcpy(&buffer[0] + firstPart, m_Buffer, buffer.size() - firstPart);
+
+	COMPILER_FENCE; // must read m_BufferPos0 after m_Buffer
+	u32 pos0 = m_BufferPos0;
+
+	// The writer may have overwritten the start of the copy in the meantime
+	if (pos0 - start > BUFFER_SIZE)
+	{
+		const size_t overwritten = std::min<size_t>(pos0 - start - BUFFER_SIZE, buffer.size());
+		buffer.erase(0, overwritten);
+		start += (u32)overwritten;
+	}
+
+	complete = start == pos;
+	pos = pos1;
+	return buffer;
+}
+
 void CProfiler2::ThreadStorage::RecordAttribute(const char* fmt, va_list argp)
 {
 	char buffer[MAX_ATTRIBUTE_LENGTH + 4] = {0}; // first 4 bytes are used for storing length
@@ -655,35 +699,31 @@ void CProfiler2::ConstructJSONOverview(std::ostream& stream)
  * Given a buffer and a visitor class (with functions OnEvent, OnEnter, OnLeave, OnAttribute),
  * calls the visitor for every item in the buffer.
  */
-template<typename V>
-void RunBufferVisitor(const std::string& buffer, V& visitor)
+/**
+ * Returns the position of the first sync marker in the buffer, or (u32)-1.
+ */
+static u32 FindSyncMarker(const std::string& buffer)
 {
-	TIMER(L"profile2 visitor");
-
-	// The buffer doesn't necessarily start at the beginning of an item
-	// (we just grabbed it from some arbitrary point in the middle),
-	// so scan forwards until we find a sync marker.
 	// (This is probably pretty inefficient.)
-
-	u32 realStart = (u32)-1; // the start point decided by the scan algorithm
-
 	for (u32 start = 0; start + 1 + sizeof(CProfiler2::RESYNC_MAGIC) <= buffer.length(); ++start)
 	{
 		if (buffer[start] == CProfiler2::ITEM_SYNC
 			&& memcmp(buffer.c_str() + start + 1, &CProfiler2::RESYNC_MAGIC, sizeof(CProfiler2::RESYNC_MAGIC)) == 0)
-		{
-			realStart = start;
-			break;
-		}
+			return start;
 	}
+	return (u32)-1;
+}
 
-	ENSURE(realStart != (u32)-1); // we should have found a sync point somewhere in the buffer
-
-	u32 pos = realStart; // the position as we step through the buffer
-
-	double lastTime = -1;
-		// set to non-negative by EVENT_SYNC; we ignore all items before that
-		// since we can't compute their absolute times
+/**
+ * Passes the items from @p pos onwards to the visitor. @p lastTime is the time
+ * of the previous sync marker, or negative if it's unknown.
+ * @return the time of the last sync marker, or -1 if an invalid item was found.
+ */
+template<typename V>
+double RunBufferItems(const std::string& buffer, u32 pos, double lastTime, V& visitor)
+{
+	// lastTime is set to non-negative by EVENT_SYNC; we ignore all items
+	// before that since we can't compute their absolute times
 
 	while (pos < buffer.length())
 	{
@@ -759,10 +799,24 @@ void RunBufferVisitor(const std::string& buffer, V& visitor)
 		}
 		default:
 			debug_warn(L"Invalid profiler item when parsing buffer");
-			return;
+			return -1;
 		}
 	}
-};
+	return lastTime;
+}
+
+template<typename V>
+void RunBufferVisitor(const std::string& buffer, V& visitor)
+{
+	// The buffer doesn't necessarily start at the beginning of an item
+	// (we just grabbed it from some arbitrary point in the middle),
+	// so scan forwards until we find a sync marker.
+	const u32 realStart = FindSyncMarker(buffer);
+
+	ENSURE(realStart != (u32)-1); // we should have found a sync point somewhere in the buffer
+
+	RunBufferItems(buffer, realStart, -1, visitor);
+}
 
 /**
  * Visitor class that dumps events as JSON.
@@ -833,8 +887,12 @@ const char* CProfiler2::ConstructJSONResponse(std::ostream& stream, const std::s
 		buffer = (*it)->GetBuffer();
 	}
 
-	BufferVisitor_Dump visitor(stream);
-	RunBufferVisitor(buffer, visitor);
+	{
+		TIMER(L"profile2 visitor");
+
+		BufferVisitor_Dump visitor(stream);
+		RunBufferVisitor(buffer, visitor);
+	}
 
 	stream << "null]\n]}";
 
@@ -863,3 +921,323 @@ void CProfiler2::SaveToFile()
 	}
 	stream << "\n]});\n";
 }
+
+/**
+ * Binary trace format (profile2.trace):
+ *
+ * The file starts with TRACE_MAGIC, followed by a sequence of records, each
+ * consisting of a record type byte and its fields. All integers are unsigned
+ * LEB128 varints.
+ *
+ *   TRACE_THREAD  thread index, name length, name
+ *   TRACE_STRING  string index, length, string (an interned region/event name)
+ *   TRACE_CHUNK   thread index, payload length, payload
+ *
+ * A chunk payload is a sequence of items (using the EItem values):
+ *   ITEM_EVENT, ITEM_ENTER  time, string index
+ *   ITEM_LEAVE              time
+ *   ITEM_ATTRIBUTE          length, attribute (belongs to the previous event or enter
+ *                           of the thread, which may be in an earlier chunk)
+ * Times are in nanoseconds, stored as the zigzag-encoded difference to the
+ * previous item's time in the same thread (starting from 0).
+ *
+ * Strings and threads are always defined before the first chunk using them.
+ */
+class CProfiler2Trace
+{
+	NONCOPYABLE(CProfiler2Trace);
+public:
+	static constexpr char TRACE_MAGIC[8] = { 'P', 'S', '2', 'T', 'R', 'A', 'C', '1' };
+
+	enum ERecord
+	{
+		TRACE_THREAD = 1,
+		TRACE_STRING = 2,
+		TRACE_CHUNK = 3
+	};
+
+	CProfiler2Trace(CProfiler2& profiler, const OsPath& path) :
+		m_Profiler(profiler), m_Stream(OsString(path), std::ofstream::out | std::ofstream::trunc | std::ofstream::binary)
+	{
+		ENSURE(m_Stream.good());
+		m_Stream.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+		m_WorkerThread = std::thread(&CProfiler2Trace::Run, this);
+	}
+
+	~CProfiler2Trace()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_WorkerMutex);
+			m_Shutdown = true;
+		}
+		m_WorkerCV.notify_one();
+		m_WorkerThread.join();
+
+		debug_printf("Profiler2 trace: %zu flushes, %.3f ms on average, %.3f ms at most, items lost %zu times\n",
+			m_FlushCount, m_FlushCount ? m_FlushTime * 1000.0 / m_FlushCount : 0.0, m_MaxFlushTime * 1000.0, m_LostBuffers);
+	}
+
+private:
+	static void WriteVarint(std::string& out, u64 value)
+	{
+		while (value >= 0x80)
+		{
+			out += (char)(u8)(value | 0x80);
+			value >>= 7;
+		}
+		out += (char)(u8)value;
+	}
+
+	/**
+	 * Each flush copies what has been written since the previous one, so
+	 * this must be short enough that no thread writes more than BUFFER_SIZE
+	 * bytes in the meantime, or the oldest of them are lost.
+	 */
+	static constexpr std::chrono::milliseconds FLUSH_INTERVAL{250};
+
+	struct ThreadState
+	{
+		std::string name;
+		u64 index = 0;
+		// Position in the thread's buffer up to which items have been written.
+		u32 bufferPos = 0;
+		// Time of the last sync marker before bufferPos, or negative if it's
+		// unknown (in which case items are skipped until the next one).
+		double syncTime = -1;
+		i64 lastNanoseconds = 0;
+		bool seen = false;
+	};
+
+	/**
+	 * Visitor class that encodes the items of a buffer.
+	 */
+	struct BufferVisitor_Trace
+	{
+		NONCOPYABLE(BufferVisitor_Trace);
+	public:
+		BufferVisitor_Trace(CProfiler2Trace& trace, ThreadState& state) :
+			m_Trace(trace), m_State(state)
+		{
+		}
+
+		void OnSync(double UNUSED(time))
+		{
+		}
+
+		void OnEvent(double time, const char* id)
+		{
+			WriteItem(CProfiler2::ITEM_EVENT, time, id);
+		}
+
+		void OnEnter(double time, const char* id)
+		{
+			WriteItem(CProfiler2::ITEM_ENTER, time, id);
+		}
+
+		void OnLeave(double time)
+		{
+			m_Payload += (char)CProfiler2::ITEM_LEAVE;
+			WriteTime(time);
+		}
+
+		// Attributes are written even if their event or enter was in a
+		// previous chunk, the reader keeps track of that per thread.
+		void OnAttribute(const std::string& attr)
+		{
+			m_Payload += (char)CProfiler2::ITEM_ATTRIBUTE;
+			WriteVarint(m_Payload, attr.size());
+			m_Payload += attr;
+		}
+
+		std::string m_Payload;
+
+	private:
+		void WriteItem(CProfiler2::EItem type, double time, const char* id)
+		{
+			m_Payload += (char)type;
+			WriteTime(time);
+			WriteVarint(m_Payload, m_Trace.InternString(id));
+		}
+
+		void WriteTime(double time)
+		{
+			const i64 nanoseconds = (i64)(time * 1e9);
+			const i64 delta = nanoseconds - m_State.lastNanoseconds;
+			m_State.lastNanoseconds = nanoseconds;
+			WriteVarint(m_Payload, ((u64)delta << 1) ^ (u64)(delta >> 63));
+		}
+
+		CProfiler2Trace& m_Trace;
+		ThreadState& m_State;
+	};
+
+	void Run()
+	{
+		debug_SetThreadName("profiler2 trace");
+		// So that the cost of flushing shows up in the trace itself.
+		m_Profiler.RegisterCurrentThread("profiler2 trace");
+
+		std::unique_lock<std::mutex> lock(m_WorkerMutex);
+		while (true)
+		{
+			m_WorkerCV.wait_for(lock, FLUSH_INTERVAL, [this]{ return m_Shutdown; });
+			const bool shutdown = m_Shutdown;
+
+			lock.unlock();
+			Flush();
+			lock.lock();
+
+			if (shutdown)
+				break;
+		}
+	}
+
+	void Flush()
+	{
+		PROFILE2("profiler2 trace flush");
+		const double startTime = timer_Time();
+
+		struct NewItems
+		{
+			ThreadState* state;
+			bool isNewThread;
+			bool complete;
+			std::string buffer;
+		};
+		std::vector<NewItems> threads;
+
+		for (std::pair<const CProfiler2::ThreadStorage* const, ThreadState>& thread : m_Threads)
+			thread.second.seen = false;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Profiler.m_Mutex);
+			for (std::unique_ptr<CProfiler2::ThreadStorage>& storage : m_Profiler.m_Threads)
+			{
+				ThreadState& state = m_Threads[storage.get()];
+				state.seen = true;
+				// (A new thread may reuse the storage of an unregistered one)
+				const bool isNewThread = state.index == 0 || state.name != storage->GetName();
+				if (isNewThread)
+				{
+					state = ThreadState();
+					state.name = storage->GetName();
+					state.index = ++m_NumThreads;
+					state.seen = true;
+				}
+
+				threads.push_back({ &state, isNewThread, true, std::string() });
+				threads.back().buffer = storage->GetBufferSince(state.bufferPos, threads.back().complete);
+			}
+		}
+
+		size_t bytes = 0;
+		std::string record;
+		for (NewItems& thread : threads)
+		{
+			ThreadState& state = *thread.state;
+			if (thread.isNewThread)
+			{
+				record.clear();
+				record += (char)TRACE_THREAD;
+				WriteVarint(record, state.index);
+				WriteVarint(record, state.name.size());
+				m_Stream << record << state.name;
+			}
+
+			// Items have been lost, continue from the next sync marker.
+			u32 start = 0;
+			if (!thread.complete)
+			{
+				start = FindSyncMarker(thread.buffer);
+				state.syncTime = -1;
+				++m_LostBuffers;
+			}
+			if (start == (u32)-1)
+				continue;
+
+			BufferVisitor_Trace visitor(*this, state);
+			state.syncTime = RunBufferItems(thread.buffer, start, state.syncTime, visitor);
+			bytes += thread.buffer.size() - start;
+			if (visitor.m_Payload.empty())
+				continue;
+
+			record.clear();
+			record += (char)TRACE_CHUNK;
+			WriteVarint(record, state.index);
+			WriteVarint(record, visitor.m_Payload.size());
+			m_Stream << record << visitor.m_Payload;
+		}
+
+		// Forget threads that have been unregistered
+		for (std::map<const CProfiler2::ThreadStorage*, ThreadState>::iterator it = m_Threads.begin(); it != m_Threads.end();)
+			if (it->second.seen)
+				++it;
+			else
+				it = m_Threads.erase(it);
+
+		m_Stream.flush();
+
+		const double time = timer_Time() - startTime;
+		PROFILE2_ATTR("parsed: %zu bytes", bytes);
+		PROFILE2_ATTR("time: %.3f ms", time * 1000.0);
+		++m_FlushCount;
+		m_FlushTime += time;
+		m_MaxFlushTime = std::max(m_MaxFlushTime, time);
+	}
+
+	u64 InternString(const char* id)
+	{
+		std::unordered_map<const char*, u64>::iterator it = m_Strings.find(id);
+		if (it != m_Strings.end())
+			return it->second;
+
+		const u64 index = m_Strings.size();
+		m_Strings.emplace(id, index);
+
+		const size_t length = strlen(id);
+		std::string record;
+		record += (char)TRACE_STRING;
+		WriteVarint(record, index);
+		WriteVarint(record, length);
+		m_Stream << record;
+		m_Stream.write(id, length);
+		return index;
+	}
+
+	CProfiler2& m_Profiler;
+
+	std::thread m_WorkerThread;
+	std::mutex m_WorkerMutex;
+	std::condition_variable m_WorkerCV;
+	bool m_Shutdown = false; // protected by m_WorkerMutex
+
+	// Only used by the worker thread:
+	std::ofstream m_Stream;
+	std::map<const CProfiler2::ThreadStorage*, ThreadState> m_Threads;
+	u64 m_NumThreads = 0;
+	size_t m_LostBuffers = 0;
+	size_t m_FlushCount = 0;
+	double m_FlushTime = 0;
+	double m_MaxFlushTime = 0;
+	// Region and event names must remain valid forever (see PROFILE2),
+	// so interning by pointer is enough.
+	std::unordered_map<const char*, u64> m_Strings;
+};
+
+void CProfiler2::EnableTrace()
+{
+	ENSURE(m_Initialised);
+
+	// Ignore multiple enablings
+	if (m_Trace)
+		return;
+
+	OsPath path = psLogDir()/"profile2.trace";
+	LOGMESSAGERENDER("Writing profile trace to %s", path.string8().c_str());
+	m_Trace = new CProfiler2Trace(*this, path);
+}
+
+void CProfiler2::ShutdownTrace()
+{
+	SAFE_DELETE(m_Trace);
+}
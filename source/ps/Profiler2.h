@@ -63,6 +63,12 @@
  * a copy of a thread's buffer, then parse the items and return them in JSON
  * format. The profiler2.html requests and processes and visualises this data.
  *
+ * Alternatively, EnableTrace starts a background thread that periodically
+ * appends the new items of every buffer to a compact binary file, so that
+ * long runs (e.g. replays) are captured completely rather than only their
+ * last BUFFER_SIZE bytes. source/tools/profiler2/trace_to_chrome.py converts
+ * it to the trace event format read by Chrome's and Perfetto's viewers.
+ *
  * The RecordSyncMarker calls are necessary to correct for time drift and to
  * let the buffer parser accurately detect the start of an item in the byte stream.
  *
@@ -100,10 +106,12 @@ struct mg_context;
 // minimise performance overhead.
 
 class CProfiler2GPU;
+class CProfiler2Trace;
 
 class CProfiler2
 {
 	friend class CProfiler2GPUImpl;
+	friend class CProfiler2Trace;
 public:
 	// Items stored in the buffers:
 
@@ -206,6 +214,16 @@ private:
 		 */
 		std::string GetBuffer();
 
+		/**
+		 * Returns a copy of the items written since @p pos, which must be 0
+		 * or the value it was set to by the previous call, and sets it to the
+		 * current end. If some of those items have been overwritten already,
+		 * @p complete is set to false and the copy isn't guaranteed to start
+		 * on an item boundary.
+		 * May be called by any thread.
+		 */
+		std::string GetBufferSince(u32& pos, bool& complete);
+
 	private:
 		/**
 		 * Store an item into the buffer.
@@ -229,6 +247,9 @@ private:
 		// outside the range Pos1 <= x < Pos0 are safe to use. (Any in that range might
 		// be half-written and corrupted.) (All ranges are modulo BUFFER_SIZE.)
 		// Outside of Write(), these will always be equal.
+		// They count all bytes written (wrapping around at 2^32) rather than
+		// being offsets into m_Buffer, so GetBufferSince can tell how much has
+		// been written since its last call.
 		//
 		// TODO: does this attempt at synchronisation (plus use of COMPILER_FENCE etc)
 		// actually work in practice?
@@ -270,6 +291,18 @@ public:
 	 */
 	void ShutDownHTTP();
 
+	/**
+	 * Call in main thread to start writing the items of all threads to
+	 * profile2.trace in the logs directory, until ShutdownTrace is called.
+	 */
+	void EnableTrace();
+
+	/**
+	 * Call in main thread to stop writing the trace, after writing the
+	 * remaining items.
+	 */
+	void ShutdownTrace();
+
 	/**
 	 * Call in main thread to enable/disable the profiler
 	 */
@@ -394,6 +427,8 @@ private:
 
 	CProfiler2GPU* m_GPU;
 
+	CProfiler2Trace* m_Trace;
+
 	std::mutex m_Mutex;
 
 	static thread_local ThreadStorage* m_CurrentStorage;
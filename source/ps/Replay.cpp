@@ -187,7 +187,7 @@ void CheckReplayMods(const std::vector<Mod::ModData>& replayMods)
 }
 } // anonymous namespace
 
-void CReplayPlayer::Replay(const bool serializationtest, const int rejointestturn, const bool ooslog, const bool testHashFull, const bool testHashQuick)
+void CReplayPlayer::Replay(const bool serializationtest, const int rejointestturn, const bool ooslog, const bool testHashFull, const bool testHashQuick, const bool messageProfile)
 {
 	ENSURE(m_Stream);
 
@@ -252,6 +252,8 @@ void CReplayPlayer::Replay(const bool serializationtest, const int rejointesttur
 				g_Game->GetSimulation2()->EnableRejoinTest(rejointestturn);
 			if (ooslog)
 				g_Game->GetSimulation2()->EnableOOSLog();
+			if (messageProfile)
+				g_Game->GetSimulation2()->EnableMessageProfile();
 
 			ScriptRequest rq(g_Game->GetSimulation2()->GetScriptInterface());
 			JS::RootedValue attribs(rq.cx);
@@ -109,7 +109,7 @@ public:
 	~CReplayPlayer();
 
 	void Load(const OsPath& path);
-	void Replay(const bool serializationtest, const int rejointestturn, const bool ooslog, const bool testHashFull, const bool testHashQuick);
+	void Replay(const bool serializationtest, const int rejointestturn, const bool ooslog, const bool testHashFull, const bool testHashQuick, const bool messageProfile);
 
 private:
 	std::istream* m_Stream;
@@ -0,0 +1,118 @@
+/* Copyright (C) 2025 Wildfire Games.
+ * This file is part of 0 A.D.
+ *
+ * 0 A.D. is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * 0 A.D. is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 0 A.D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lib/self_test.h"
+
+#include "lib/fnv_hash.h"
+#include "lib/timer.h"
+#include "ps/CStrIntern.h"
+#include "ps/CStrInternStatic.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+class TestCStrIntern : public CxxTest::TestSuite
+{
+public:
+	void test_basic()
+	{
+		const CStrIntern a{"test_basic"};
+		const CStrIntern b{std::string{"test_basic"}};
+		const CStrIntern c{"test_basic2"};
+
+		TS_ASSERT_EQUALS(a, b);
+		TS_ASSERT_EQUALS(a.c_str(), b.c_str());
+		TS_ASSERT_DIFFERS(a, c);
+		TS_ASSERT_STR_EQUALS(a.string(), "test_basic");
+		TS_ASSERT_EQUALS(a.length(), 10u);
+		TS_ASSERT_EQUALS(a.GetHash(), fnv_hash("test_basic", 10));
+
+		TS_ASSERT(CStrIntern{}.empty());
+		TS_ASSERT_EQUALS(CStrIntern{}, str__emptystring);
+		TS_ASSERT_EQUALS(CStrIntern{"RENDER_DEBUG_MODE"}, str_RENDER_DEBUG_MODE);
+	}
+
+	void test_embedded_null()
+	{
+		const CStrIntern a{std::string{"a\0b", 3}};
+		const CStrIntern b{std::string{"a\0c", 3}};
+		TS_ASSERT_DIFFERS(a, b);
+		TS_ASSERT_EQUALS(a.length(), 3u);
+		TS_ASSERT_EQUALS(a, CStrIntern{std::string{"a\0b", 3}});
+	}
+
+	void test_threads()
+	{
+		constexpr size_t numberOfThreads = 4;
+		constexpr size_t numberOfStrings = 1009;
+
+		// Every thread interns the same strings in a different order, so
+		// they race to add each of them. (The number of strings is prime, so
+		// every order is a permutation.)
+		std::vector<std::vector<CStrIntern>> results(numberOfThreads);
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < numberOfThreads; ++t)
+			threads.emplace_back([t, &result = results[t]]
+			{
+				result.resize(numberOfStrings);
+				for (size_t i = 0; i < numberOfStrings; ++i)
+				{
+					const size_t index = (i * (t * 2 + 1)) % numberOfStrings;
+					result[index] = CStrIntern{"test_threads_" + std::to_string(index)};
+				}
+			});
+		for (std::thread& thread : threads)
+			thread.join();
+
+		for (size_t i = 0; i < numberOfStrings; ++i)
+		{
+			TS_ASSERT_STR_EQUALS(results[0][i].string(), "test_threads_" + std::to_string(i));
+			for (size_t t = 1; t < numberOfThreads; ++t)
+				TS_ASSERT_EQUALS(results[0][i], results[t][i]);
+		}
+	}
+
+	void DISABLE_test_perf()
+	{
+		constexpr size_t numberOfStrings = 10000;
+		constexpr size_t iterations = 100;
+
+		std::vector<std::string> strings;
+		for (size_t i = 0; i < numberOfStrings; ++i)
+			strings.push_back("test_perf_" + std::to_string(i));
+
+		for (const size_t numberOfThreads : { 1, 2, 4, 8 })
+		{
+			const double start = timer_Time();
+			std::vector<std::thread> threads;
+			for (size_t t = 0; t < numberOfThreads; ++t)
+				threads.emplace_back([&strings]
+				{
+					for (size_t i = 0; i < iterations; ++i)
+						for (const std::string& str : strings)
+							CStrIntern{str};
+				});
+			for (std::thread& thread : threads)
+				thread.join();
+			const double elapsed = timer_Time() - start;
+
+			debug_printf("%zu threads: %.1f M interns/s\n", numberOfThreads,
+				numberOfThreads * iterations * numberOfStrings / elapsed / 1e6);
+		}
+	}
+};
@@ -1,4 +1,4 @@
-/* Copyright (C) 2024 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -123,9 +123,9 @@ void CDecalRData::RenderDecals(
 	PROFILE3("render terrain decals");
 	GPU_SCOPED_LABEL(deviceCommandContext, "Render terrain decals");
 
-	using Arena = Allocators::DynamicArena<256 * KiB>;
+	using Arena = CRenderer::FrameArena;
 
-	Arena arena;
+	Arena& arena = g_Renderer.GetFrameArena();
 
 	using Batches = std::vector<SDecalBatch, ProxyAllocator<SDecalBatch, Arena>>;
 	Batches batches((Batches::allocator_type(arena)));
@@ -0,0 +1,136 @@
+/* Copyright (C) 2025 Wildfire Games.
+ * This file is part of 0 A.D.
+ *
+ * 0 A.D. is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * 0 A.D. is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 0 A.D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "precompiled.h"
+
+#include "FrameGraph.h"
+
+#include "lib/timer.h"
+#include "ps/Profile.h"
+
+#include <algorithm>
+
+CFrameGraph::ResourceHandle CFrameGraph::DeclareResource(const char* name)
+{
+	ENSURE(!m_Compiled);
+	m_Resources.push_back({name, false});
+	return static_cast<ResourceHandle>(m_Resources.size() - 1);
+}
+
+void CFrameGraph::MarkOutput(const ResourceHandle resource)
+{
+	ENSURE(resource < m_Resources.size());
+	m_Resources[resource].output = true;
+}
+
+void CFrameGraph::AddPass(
+	const char* name, std::vector<ResourceHandle> reads,
+	std::vector<ResourceHandle> writes, RecordCallback record)
+{
+	ENSURE(!m_Compiled);
+	for (const ResourceHandle resource : reads)
+		ENSURE(resource < m_Resources.size());
+	for (const ResourceHandle resource : writes)
+		ENSURE(resource < m_Resources.size());
+
+	Pass pass;
+	pass.name = name;
+	pass.reads = std::move(reads);
+	pass.writes = std::move(writes);
+	pass.record = std::move(record);
+	m_Passes.emplace_back(std::move(pass));
+}
+
+void CFrameGraph::Compile()
+{
+	ENSURE(!m_Compiled);
+
+	// Walk passes backwards starting from outputs. A pass is alive if it
+	// writes a resource needed by an output or by a later alive pass.
+	std::vector<bool> needed(m_Resources.size());
+	for (size_t resource = 0; resource < m_Resources.size(); ++resource)
+		needed[resource] = m_Resources[resource].output;
+	for (size_t index = m_Passes.size(); index > 0; --index)
+	{
+		Pass& pass = m_Passes[index - 1];
+		pass.culled = std::none_of(pass.writes.begin(), pass.writes.end(),
+			[&needed](const ResourceHandle resource) { return needed[resource]; });
+		if (pass.culled)
+			continue;
+		for (const ResourceHandle resource : pass.reads)
+			needed[resource] = true;
+	}
+
+	// Walk passes forward and assign levels: a pass has to be after the
+	// last writer of everything it touches (read-after-write and
+	// write-after-write) and after the readers of everything it writes
+	// (write-after-read).
+	constexpr size_t NO_LEVEL = 0;
+	std::vector<size_t> lastWriteLevel(m_Resources.size(), NO_LEVEL);
+	std::vector<size_t> lastReadLevel(m_Resources.size(), NO_LEVEL);
+	m_ExecutionOrder.clear();
+	m_NumberOfLevels = 0;
+	for (size_t index = 0; index < m_Passes.size(); ++index)
+	{
+		Pass& pass = m_Passes[index];
+		if (pass.culled)
+		{
+			pass.level = INVALID_LEVEL;
+			continue;
+		}
+		// Levels are stored as level + 1 to keep 0 meaning "untouched".
+		size_t level = NO_LEVEL;
+		for (const ResourceHandle resource : pass.reads)
+			level = std::max(level, lastWriteLevel[resource]);
+		for (const ResourceHandle resource : pass.writes)
+			level = std::max({level, lastWriteLevel[resource], lastReadLevel[resource]});
+		pass.level = level;
+
+		for (const ResourceHandle resource : pass.reads)
+			lastReadLevel[resource] = std::max(lastReadLevel[resource], level + 1);
+		for (const ResourceHandle resource : pass.writes)
+			lastWriteLevel[resource] = level + 1;
+
+		m_NumberOfLevels = std::max(m_NumberOfLevels, level + 1);
+		m_ExecutionOrder.push_back(index);
+	}
+
+	m_Compiled = true;
+}
+
+void CFrameGraph::Execute(Renderer::Backend::IDeviceCommandContext* deviceCommandContext)
+{
+	ENSURE(m_Compiled);
+	for (const size_t index : m_ExecutionOrder)
+	{
+		Pass& pass = m_Passes[index];
+		// Passes like the water ones are GPU bound, so time them there too.
+		PROFILE3_GPU(deviceCommandContext, pass.name);
+		const double startTime = timer_Time();
+		pass.record(deviceCommandContext);
+		pass.recordTime = timer_Time() - startTime;
+	}
+}
+
+void CFrameGraph::Reset()
+{
+	m_Resources.clear();
+	m_Passes.clear();
+	m_ExecutionOrder.clear();
+	m_NumberOfLevels = 0;
+	m_Compiled = false;
+}
@@ -0,0 +1,128 @@
+/* Copyright (C) 2025 Wildfire Games.
+ * This file is part of 0 A.D.
+ *
+ * 0 A.D. is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * 0 A.D. is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 0 A.D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDED_RENDERER_FRAMEGRAPH
+#define INCLUDED_RENDERER_FRAMEGRAPH
+
+#include "renderer/backend/IDeviceCommandContext.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * A lightweight per-frame graph of render passes. Each pass declares which
+ * resources (framebuffers, textures) it reads and writes, the graph derives
+ * dependencies from that, culls passes which don't contribute to any output
+ * and groups the remaining passes into dependency levels. Passes inside the
+ * same level don't depend on each other, so they are candidates for being
+ * recorded independently.
+ *
+ * Passes are currently recorded sequentially into a single command context
+ * in declaration order, which is always a valid topological order.
+ */
+class CFrameGraph
+{
+public:
+	using ResourceHandle = uint32_t;
+	using RecordCallback =
+		std::function<void(Renderer::Backend::IDeviceCommandContext*)>;
+
+	static constexpr size_t INVALID_LEVEL = static_cast<size_t>(-1);
+
+	/**
+	 * Declares a resource which can be read or written by passes.
+	 * @param name must be a literal or live as long as the graph.
+	 */
+	ResourceHandle DeclareResource(const char* name);
+
+	/**
+	 * Marks the resource as consumed outside of the graph. Passes which
+	 * (indirectly) contribute to an output are never culled.
+	 */
+	void MarkOutput(const ResourceHandle resource);
+
+	/**
+	 * Adds a pass to the graph.
+	 * @param name must be a literal, it's used for profiling and GPU labels.
+	 */
+	void AddPass(
+		const char* name, std::vector<ResourceHandle> reads,
+		std::vector<ResourceHandle> writes, RecordCallback record);
+
+	/**
+	 * Computes dependencies, culls unused passes and assigns levels.
+	 * Must be called after all passes are added and before Execute.
+	 */
+	void Compile();
+
+	/**
+	 * Records all non-culled passes into the command context.
+	 */
+	void Execute(Renderer::Backend::IDeviceCommandContext* deviceCommandContext);
+
+	/**
+	 * Removes all passes and resources, the graph is rebuilt each frame.
+	 */
+	void Reset();
+
+	size_t GetNumberOfPasses() const { return m_Passes.size(); }
+	size_t GetNumberOfLevels() const { return m_NumberOfLevels; }
+
+	const char* GetPassName(const size_t pass) const { return m_Passes[pass].name; }
+	bool IsPassCulled(const size_t pass) const { return m_Passes[pass].culled; }
+	/**
+	 * @return the dependency level of the pass or INVALID_LEVEL if culled.
+	 */
+	size_t GetPassLevel(const size_t pass) const { return m_Passes[pass].level; }
+	/**
+	 * @return CPU time spent recording the pass during the last Execute.
+	 */
+	double GetPassRecordTime(const size_t pass) const { return m_Passes[pass].recordTime; }
+
+	/**
+	 * @return indices of passes in the order they're recorded.
+	 */
+	const std::vector<size_t>& GetExecutionOrder() const { return m_ExecutionOrder; }
+
+private:
+	struct Resource
+	{
+		const char* name = nullptr;
+		bool output = false;
+	};
+
+	struct Pass
+	{
+		const char* name = nullptr;
+		std::vector<ResourceHandle> reads;
+		std::vector<ResourceHandle> writes;
+		RecordCallback record;
+
+		bool culled = false;
+		size_t level = INVALID_LEVEL;
+		double recordTime = 0.0;
+	};
+
+	std::vector<Resource> m_Resources;
+	std::vector<Pass> m_Passes;
+	std::vector<size_t> m_ExecutionOrder;
+	size_t m_NumberOfLevels = 0;
+	bool m_Compiled = false;
+};
+
+#endif // INCLUDED_RENDERER_FRAMEGRAPH
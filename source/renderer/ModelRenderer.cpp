@@ -420,9 +420,9 @@ void ShaderModelRenderer::Render(
 	 * list in each, rebinding the GL state whenever it changes.
 	 */
 
-	using Arena = Allocators::DynamicArena<256 * KiB>;
+	using Arena = CRenderer::FrameArena;
 
-	Arena arena;
+	Arena& arena = g_Renderer.GetFrameArena();
 	using ModelListAllocator = ProxyAllocator<CModel*, Arena>;
 	using ModelList_t = std::vector<CModel*, ModelListAllocator>;
 	using MaterialBuckets_t = std::unordered_map<
@@ -647,6 +647,10 @@ void ShaderModelRenderer::Render(
 						if (flags && !(model->GetFlags() & flags))
 							continue;
 
+						// Consecutive models which don't need any state to be
+						// rebound form a batch.
+						bool newBatch = false;
+
 						const CMaterial::SamplersVector& samplers = model->GetMaterial().GetSamplers();
 						size_t samplersNum = samplers.size();
 
@@ -685,6 +689,7 @@ void ShaderModelRenderer::Render(
 								deviceCommandContext->SetTexture(
 									texBindings[s], newTex->GetBackendTexture());
 								currentTexs[s] = newTex;
+								newBatch = true;
 							}
 						}
 
@@ -694,16 +699,21 @@ void ShaderModelRenderer::Render(
 						{
 							currentModeldef = newModeldef;
 							m->vertexRenderer->PrepareModelDef(deviceCommandContext, *currentModeldef);
+							newBatch = true;
 						}
 
 						// Bind all uniforms when any change
-						CShaderUniforms newStaticUniforms = model->GetMaterial().GetStaticUniforms();
+						const CShaderUniforms& newStaticUniforms = model->GetMaterial().GetStaticUniforms();
 						if (newStaticUniforms != currentStaticUniforms)
 						{
 							currentStaticUniforms = newStaticUniforms;
 							currentStaticUniforms.BindUniforms(deviceCommandContext, shader);
+							newBatch = true;
 						}
 
+						if (newBatch)
+							++g_Renderer.m_Stats.m_ModelBatches;
+
 						const CShaderRenderQueries& renderQueries = model->GetMaterial().GetRenderQueries();
 
 						for (size_t q = 0; q < renderQueries.GetSize(); ++q)
@@ -1,4 +1,4 @@
-/* Copyright (C) 2024 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -814,10 +814,10 @@ void CPatchRData::Update(CSimulation2* simulation)
 }
 
 // To minimise the cost of memory allocations, everything used for computing
-// batches uses a arena allocator. (All allocations are short-lived so we can
+// batches uses the frame arena. (All allocations are short-lived so we can
 // just throw away the whole arena at the end of each frame.)
 
-using Arena = Allocators::DynamicArena<1 * MiB>;
+using Arena = CRenderer::FrameArena;
 
 // std::map types with appropriate arena allocators and default comparison operator
 template<class Key, class Value>
@@ -866,7 +866,7 @@ void CPatchRData::RenderBases(
 	PROFILE3("render terrain bases");
 	GPU_SCOPED_LABEL(deviceCommandContext, "Render terrain bases");
 
-	Arena arena;
+	Arena& arena = g_Renderer.GetFrameArena();
 
 	ShaderTechniqueBatches batches(ShaderTechniqueBatches::key_compare(), (ShaderTechniqueBatches::allocator_type(arena)));
 
@@ -1026,7 +1026,7 @@ void CPatchRData::RenderBlends(
 	PROFILE3("render terrain blends");
 	GPU_SCOPED_LABEL(deviceCommandContext, "Render terrain blends");
 
-	Arena arena;
+	Arena& arena = g_Renderer.GetFrameArena();
 
 	using BatchesStack = std::vector<SBlendBatch, ProxyAllocator<SBlendBatch, Arena>>;
 	BatchesStack batches((BatchesStack::allocator_type(arena)));
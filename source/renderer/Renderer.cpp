@@ -106,9 +106,12 @@ private:
 		Row_TerrainTris,
 		Row_WaterTris,
 		Row_ModelTris,
+		Row_ModelBatches,
 		Row_OverlayTris,
 		Row_BlendSplats,
 		Row_Particles,
+		Row_FrameArenaUsed,
+		Row_FrameArenaBlocks,
 		Row_VBReserved,
 		Row_VBAllocated,
 		Row_TextureMemory,
@@ -178,6 +181,12 @@ CStr CRendererStatsTable::GetCellText(size_t row, size_t col)
 		sprintf_s(buf, sizeof(buf), "%lu", (unsigned long)Stats.m_ModelTris);
 		return buf;
 
+	case Row_ModelBatches:
+		if (col == 0)
+			return "# model batches";
+		sprintf_s(buf, sizeof(buf), "%lu", (unsigned long)Stats.m_ModelBatches);
+		return buf;
+
 	case Row_OverlayTris:
 		if (col == 0)
 			return "# overlay tris";
@@ -196,6 +205,18 @@ CStr CRendererStatsTable::GetCellText(size_t row, size_t col)
 		sprintf_s(buf, sizeof(buf), "%lu", (unsigned long)Stats.m_Particles);
 		return buf;
 
+	case Row_FrameArenaUsed:
+		if (col == 0)
+			return "frame arena used";
+		sprintf_s(buf, sizeof(buf), "%lu kB", static_cast<unsigned long>(Stats.m_FrameArenaUsed / 1024));
+		return buf;
+
+	case Row_FrameArenaBlocks:
+		if (col == 0)
+			return "frame arena blocks";
+		sprintf_s(buf, sizeof(buf), "%lu", static_cast<unsigned long>(Stats.m_FrameArenaBlocks));
+		return buf;
+
 	case Row_VBReserved:
 		if (col == 0)
 			return "VB reserved";
@@ -276,6 +297,8 @@ public:
 
 	CFontManager fontManager;
 
+	FrameArena frameArena;
+
 	struct VertexAttributesHash
 	{
 		size_t operator()(const std::vector<Renderer::Backend::SVertexAttributeFormat>& attributes) const;
@@ -590,6 +613,11 @@ void CRenderer::RenderFrameImpl(const bool renderGUI, const bool renderLogger)
 		g_AtlasGameLoop->view->DrawCinemaPathTool();
 	}
 
+	// The profile table is drawn by the 2D pass, so the scene's usage has to
+	// be recorded before it.
+	m_Stats.m_FrameArenaUsed = m->frameArena.GetUsedSize();
+	m_Stats.m_FrameArenaBlocks = m->frameArena.GetNumberOfBlocks();
+
 	RenderFrame2D(renderGUI, renderLogger);
 
 	m->deviceCommandContext->EndFramebufferPass();
@@ -601,6 +629,7 @@ void CRenderer::RenderFrameImpl(const bool renderGUI, const bool renderLogger)
 	PROFILE2_ATTR("terrain tris: %zu", stats.m_TerrainTris);
 	PROFILE2_ATTR("water tris: %zu", stats.m_WaterTris);
 	PROFILE2_ATTR("model tris: %zu", stats.m_ModelTris);
+	PROFILE2_ATTR("model batches: %zu", stats.m_ModelBatches);
 	PROFILE2_ATTR("overlay tris: %zu", stats.m_OverlayTris);
 	PROFILE2_ATTR("blend splats: %zu", stats.m_BlendSplats);
 	PROFILE2_ATTR("particles: %zu", stats.m_Particles);
@@ -830,6 +859,9 @@ void CRenderer::BeginFrame()
 	// Zero out all the per-frame stats.
 	m_Stats.Reset();
 
+	// Nothing allocated during the previous frame may be used anymore.
+	m->frameArena.reset();
+
 	if (m->ShadersDirty)
 		ReloadShaders();
 
@@ -884,6 +916,11 @@ CDebugRenderer& CRenderer::GetDebugRenderer()
 	return m->debugRenderer;
 }
 
+CRenderer::FrameArena& CRenderer::GetFrameArena()
+{
+	return m->frameArena;
+}
+
 CFontManager& CRenderer::GetFontManager()
 {
 	return m->fontManager;
@@ -1,4 +1,4 @@
-/* Copyright (C) 2024 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -21,6 +21,7 @@
 #include "graphics/Camera.h"
 #include "graphics/ShaderDefines.h"
 #include "graphics/ShaderProgramPtr.h"
+#include "lib/allocators/DynamicArena.h"
 #include "ps/containers/Span.h"
 #include "ps/Singleton.h"
 #include "renderer/backend/IDeviceCommandContext.h"
@@ -62,14 +63,26 @@ public:
 		size_t m_WaterTris;
 		// number of (non-transparent) model triangles drawn
 		size_t m_ModelTris;
+		// number of model batches, i.e. runs of model draws sharing mesh and material state
+		size_t m_ModelBatches;
 		// number of overlay triangles drawn
 		size_t m_OverlayTris;
 		// number of splat passes for alphamapping
 		size_t m_BlendSplats;
 		// number of particles
 		size_t m_Particles;
+		// bytes used from the frame arena
+		size_t m_FrameArenaUsed;
+		// number of blocks owned by the frame arena
+		size_t m_FrameArenaBlocks;
 	};
 
+	/**
+	 * Arena for scratch data that is only needed during a frame, for use
+	 * with ProxyAllocator.
+	 */
+	using FrameArena = Allocators::DynamicArena<1 * MiB>;
+
 	enum class ScreenShotType
 	{
 		NONE,
@@ -121,6 +134,13 @@ public:
 
 	CDebugRenderer& GetDebugRenderer();
 
+	/**
+	 * Returns the frame arena. It's reset at the beginning of each frame but
+	 * keeps its memory, so allocating from it doesn't reach the heap once it
+	 * has grown to the peak usage of a frame. Main thread only.
+	 */
+	FrameArena& GetFrameArena();
+
 	/**
 	 * Performs a complete frame without presenting to force loading all needed
 	 * resources. It's used for the first frame on a game start.
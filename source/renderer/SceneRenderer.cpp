@@ -46,6 +46,7 @@
 #include "renderer/backend/IDevice.h"
 #include "renderer/CPUSkinnedModelRenderer.h"
 #include "renderer/DebugRenderer.h"
+#include "renderer/FrameGraph.h"
 #include "renderer/GPUSkinnedModelRenderer.h"
 #include "renderer/InstancingModelRenderer.h"
 #include "renderer/ModelRenderer.h"
@@ -109,6 +110,9 @@ public:
 
 	SilhouetteRenderer silhouetteRenderer;
 
+	/// Graph of offscreen passes, rebuilt each frame
+	CFrameGraph frameGraph;
+
 	/// Various model renderers
 	struct Models
 	{
@@ -813,9 +817,26 @@ void CSceneRenderer::PrepareSubmissions(
 
 	m->particleRenderer.Upload(deviceCommandContext);
 
+	// Offscreen passes are consumed by the main scene pass, so all their
+	// targets are outputs of the graph.
+	CFrameGraph& frameGraph = m->frameGraph;
+	frameGraph.Reset();
+	const CFrameGraph::ResourceHandle shadowMap = frameGraph.DeclareResource("shadow map");
+	const CFrameGraph::ResourceHandle reflectionTexture = frameGraph.DeclareResource("reflection texture");
+	const CFrameGraph::ResourceHandle refractionTexture = frameGraph.DeclareResource("refraction texture");
+	const CFrameGraph::ResourceHandle foamOccluders = frameGraph.DeclareResource("water foam occluders");
+	frameGraph.MarkOutput(shadowMap);
+	frameGraph.MarkOutput(reflectionTexture);
+	frameGraph.MarkOutput(refractionTexture);
+	frameGraph.MarkOutput(foamOccluders);
+
 	if (g_RenderingOptions.GetShadows())
 	{
-		RenderShadowMap(deviceCommandContext, context);
+		frameGraph.AddPass("shadow pass", {}, {shadowMap},
+			[this, &context](Renderer::Backend::IDeviceCommandContext* passCommandContext)
+			{
+				RenderShadowMap(passCommandContext, context);
+			});
 	}
 
 	if (m->waterManager.m_RenderWater)
@@ -824,17 +845,40 @@ void CSceneRenderer::PrepareSubmissions(
 		{
 			m->waterManager.UpdateQuality();
 
-			PROFILE3_GPU(deviceCommandContext, "water scissor");
+			// Reflections and refractions temporarily replace the view
+			// camera, so both write it to stay ordered against each other.
+			const CFrameGraph::ResourceHandle viewCamera = frameGraph.DeclareResource("view camera");
 			if (g_RenderingOptions.GetWaterReflection())
-				RenderReflections(deviceCommandContext, context, waterScissor);
+			{
+				frameGraph.AddPass("water reflections pass", {shadowMap}, {reflectionTexture, viewCamera},
+					[this, &context, &waterScissor](Renderer::Backend::IDeviceCommandContext* passCommandContext)
+					{
+						RenderReflections(passCommandContext, context, waterScissor);
+					});
+			}
 
 			if (g_RenderingOptions.GetWaterRefraction())
-				RenderRefractions(deviceCommandContext, context, waterScissor);
+			{
+				frameGraph.AddPass("water refractions pass", {shadowMap}, {refractionTexture, viewCamera},
+					[this, &context, &waterScissor](Renderer::Backend::IDeviceCommandContext* passCommandContext)
+					{
+						RenderRefractions(passCommandContext, context, waterScissor);
+					});
+			}
 
 			if (g_RenderingOptions.GetWaterFancyEffects())
-				m->terrainRenderer.RenderWaterFoamOccluders(deviceCommandContext, CULL_DEFAULT);
+			{
+				frameGraph.AddPass("water foam occluders pass", {}, {foamOccluders},
+					[this](Renderer::Backend::IDeviceCommandContext* passCommandContext)
+					{
+						m->terrainRenderer.RenderWaterFoamOccluders(passCommandContext, CULL_DEFAULT);
+					});
+			}
 		}
 	}
+
+	frameGraph.Compile();
+	frameGraph.Execute(deviceCommandContext);
 }
 
 void CSceneRenderer::RenderSubmissions(
@@ -0,0 +1,101 @@
+/* Copyright (C) 2025 Wildfire Games.
+ * This file is part of 0 A.D.
+ *
+ * 0 A.D. is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * 0 A.D. is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 0 A.D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lib/self_test.h"
+
+#include "renderer/backend/dummy/Device.h"
+#include "renderer/FrameGraph.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class TestFrameGraph : public CxxTest::TestSuite
+{
+public:
+	void test_order_and_levels()
+	{
+		Renderer::Backend::Dummy::CDevice device;
+		std::unique_ptr<Renderer::Backend::IDeviceCommandContext> deviceCommandContext =
+			device.CreateCommandContext();
+
+		std::vector<std::string> recorded;
+		const auto recordName = [&recorded](const char* name)
+		{
+			return [&recorded, name](Renderer::Backend::IDeviceCommandContext* context)
+			{
+				TS_ASSERT(context);
+				recorded.emplace_back(name);
+			};
+		};
+
+		CFrameGraph frameGraph;
+		const CFrameGraph::ResourceHandle shadow = frameGraph.DeclareResource("shadow");
+		const CFrameGraph::ResourceHandle reflection = frameGraph.DeclareResource("reflection");
+		const CFrameGraph::ResourceHandle refraction = frameGraph.DeclareResource("refraction");
+		const CFrameGraph::ResourceHandle unused = frameGraph.DeclareResource("unused");
+		const CFrameGraph::ResourceHandle backbuffer = frameGraph.DeclareResource("backbuffer");
+		frameGraph.MarkOutput(backbuffer);
+
+		frameGraph.AddPass("shadow", {}, {shadow}, recordName("shadow"));
+		frameGraph.AddPass("reflection", {shadow}, {reflection}, recordName("reflection"));
+		frameGraph.AddPass("refraction", {shadow}, {refraction}, recordName("refraction"));
+		frameGraph.AddPass("debug", {}, {unused}, recordName("debug"));
+		frameGraph.AddPass("scene", {shadow, reflection, refraction}, {backbuffer}, recordName("scene"));
+		frameGraph.AddPass("overlays", {}, {backbuffer}, recordName("overlays"));
+		frameGraph.Compile();
+
+		TS_ASSERT_EQUALS(frameGraph.GetNumberOfPasses(), 6u);
+		TS_ASSERT(frameGraph.IsPassCulled(3));
+		TS_ASSERT_EQUALS(frameGraph.GetPassLevel(3), CFrameGraph::INVALID_LEVEL);
+
+		TS_ASSERT_EQUALS(frameGraph.GetPassLevel(0), 0u);
+		// Reflection and refraction only share a read, so they're independent.
+		TS_ASSERT_EQUALS(frameGraph.GetPassLevel(1), 1u);
+		TS_ASSERT_EQUALS(frameGraph.GetPassLevel(2), 1u);
+		TS_ASSERT_EQUALS(frameGraph.GetPassLevel(4), 2u);
+		TS_ASSERT_EQUALS(frameGraph.GetPassLevel(5), 3u);
+		TS_ASSERT_EQUALS(frameGraph.GetNumberOfLevels(), 4u);
+
+		frameGraph.Execute(deviceCommandContext.get());
+		const std::vector<std::string> expected{"shadow", "reflection", "refraction", "scene", "overlays"};
+		TS_ASSERT_EQUALS(recorded, expected);
+		for (const size_t pass : frameGraph.GetExecutionOrder())
+			TS_ASSERT_LESS_THAN_EQUALS(0.0, frameGraph.GetPassRecordTime(pass));
+	}
+
+	void test_write_after_read()
+	{
+		CFrameGraph frameGraph;
+		const CFrameGraph::ResourceHandle texture = frameGraph.DeclareResource("texture");
+		const CFrameGraph::ResourceHandle first = frameGraph.DeclareResource("first");
+		const CFrameGraph::ResourceHandle second = frameGraph.DeclareResource("second");
+		frameGraph.MarkOutput(first);
+		frameGraph.MarkOutput(second);
+
+		frameGraph.AddPass("read", {texture}, {first}, [](Renderer::Backend::IDeviceCommandContext*) {});
+		frameGraph.AddPass("overwrite", {}, {texture, second}, [](Renderer::Backend::IDeviceCommandContext*) {});
+		frameGraph.Compile();
+
+		TS_ASSERT_EQUALS(frameGraph.GetPassLevel(0), 0u);
+		TS_ASSERT_EQUALS(frameGraph.GetPassLevel(1), 1u);
+
+		frameGraph.Reset();
+		TS_ASSERT_EQUALS(frameGraph.GetNumberOfPasses(), 0u);
+		TS_ASSERT_EQUALS(frameGraph.GetNumberOfLevels(), 0u);
+	}
+};
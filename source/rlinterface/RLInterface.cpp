@@ -1,4 +1,4 @@
-/* Copyright (C) 2024 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -22,24 +22,63 @@
 #include "rlinterface/RLInterface.h"
 
 #include "gui/GUIManager.h"
+#include "lib/byte_order.h"
 #include "ps/CLogger.h"
 #include "ps/Game.h"
 #include "ps/GameSetup/GameSetup.h"
 #include "ps/Loader.h"
+#include "ps/Profile.h"
+#include "scriptinterface/FunctionWrapper.h"
 #include "scriptinterface/Object.h"
 #include "scriptinterface/ScriptInterface.h"
 #include "scriptinterface/JSON.h"
 #include "simulation2/Simulation2.h"
 #include "simulation2/components/ICmpAIInterface.h"
+#include "simulation2/components/ICmpOwnership.h"
+#include "simulation2/components/ICmpPosition.h"
 #include "simulation2/components/ICmpTemplateManager.h"
 #include "simulation2/system/LocalTurnManager.h"
 
+#include <cstring>
 #include <queue>
 #include <sstream>
 #include <tuple>
 
 namespace RL
 {
+namespace
+{
+ObservationFormat GetObservationFormat(const struct mg_request_info* request_info)
+{
+	const char* query_string = request_info->query_string;
+	if (query_string == nullptr)
+		return ObservationFormat::JSON;
+
+	char format[16];
+	const int len = mg_get_var(query_string, std::strlen(query_string), "format", format, sizeof(format));
+	if (len != -1 && std::strcmp(format, "packed") == 0)
+		return ObservationFormat::Packed;
+	return ObservationFormat::JSON;
+}
+
+/**
+ * Appends 32 bit values in little-endian byte order, whatever the native one is.
+ */
+template<typename T>
+void AppendPacked(std::string& out, const std::vector<T>& values)
+{
+	static_assert(sizeof(T) == sizeof(u32), "Only 32 bit values can be packed");
+	const size_t start = out.size();
+	out.resize(start + values.size() * sizeof(u32));
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		u32 bits;
+		std::memcpy(&bits, &values[i], sizeof(bits));
+		write_le32(&out[start + i * sizeof(u32)], bits);
+	}
+}
+} // anonymous namespace
+
 Interface::Interface(const char* server_address)
 {
 	LOGMESSAGERENDER("Starting RL interface HTTP server");
@@ -70,17 +109,17 @@ std::string Interface::SendGameMessage(GameMessage&& msg)
 	return m_ReturnValue;
 }
 
-std::string Interface::Step(std::vector<GameCommand>&& commands)
+std::string Interface::Step(std::vector<GameCommand>&& commands, ObservationFormat format)
 {
 	std::lock_guard<std::mutex> lock(m_Lock);
-	return SendGameMessage({ GameMessageType::Commands, std::move(commands) });
+	return SendGameMessage({ GameMessageType::Commands, std::move(commands), format });
 }
 
-std::string Interface::Reset(ScenarioConfig&& scenario)
+std::string Interface::Reset(ScenarioConfig&& scenario, ObservationFormat format)
 {
 	std::lock_guard<std::mutex> lock(m_Lock);
 	m_ScenarioConfig = std::move(scenario);
-	return SendGameMessage({ GameMessageType::Reset });
+	return SendGameMessage({ GameMessageType::Reset, {}, format });
 }
 
 std::string Interface::Evaluate(std::string&& code)
@@ -120,6 +159,11 @@ void* Interface::MgCallback(mg_event event, struct mg_connection *conn, const st
 		"Access-Control-Allow-Origin: *\r\n"
 		"Content-Type: text/plain; charset=utf-8\r\n\r\n";
 
+	const char* header200Packed =
+		"HTTP/1.1 200 OK\r\n"
+		"Access-Control-Allow-Origin: *\r\n"
+		"Content-Type: application/octet-stream\r\n\r\n";
+
 	const char* header404 =
 		"HTTP/1.1 404 Not Found\r\n"
 		"Content-Type: text/plain; charset=utf-8\r\n\r\n"
@@ -142,6 +186,7 @@ void* Interface::MgCallback(mg_event event, struct mg_connection *conn, const st
 		std::stringstream stream;
 
 		const std::string uri = request_info->uri;
+		const ObservationFormat format = GetObservationFormat(request_info);
 
 		if (uri == "/reset")
 		{
@@ -157,8 +202,8 @@ void* Interface::MgCallback(mg_event event, struct mg_connection *conn, const st
 			{
 				const std::string qs(query_string);
 				scenario.saveReplay = qs.find("saveReplay") != std::string::npos;
+				scenario.useSnapshot = qs.find("useSnapshot") != std::string::npos;
 
-				scenario.playerID = 1;
 				char playerID[1];
 				const int len = mg_get_var(query_string, qs.length(), "playerID", playerID, 1);
 				if (len != -1)
@@ -167,9 +212,9 @@ void* Interface::MgCallback(mg_event event, struct mg_connection *conn, const st
 
 			scenario.content = std::move(data);
 
-			const std::string gameState = interface->Reset(std::move(scenario));
+			const std::string gameState = interface->Reset(std::move(scenario), format);
 
-			stream << gameState.c_str();
+			stream << gameState;
 		}
 		else if (uri == "/step")
 		{
@@ -195,14 +240,14 @@ void* Interface::MgCallback(mg_event event, struct mg_connection *conn, const st
 				cmd.json_cmd = line.substr(splitPos + 1);
 				commands.push_back(std::move(cmd));
 			}
-			const std::string gameState = interface->Step(std::move(commands));
+			const std::string gameState = interface->Step(std::move(commands), format);
 			if (gameState.empty())
 			{
 				mg_printf(conn, "%s", notRunningResponse);
 				return handled;
 			}
 			else
-				stream << gameState.c_str();
+				stream << gameState;
 		}
 		else if (uri == "/evaluate")
 		{
@@ -256,7 +301,8 @@ void* Interface::MgCallback(mg_event event, struct mg_connection *conn, const st
 			return handled;
 		}
 
-		mg_printf(conn, "%s", header200);
+		const bool packed = format == ObservationFormat::Packed && (uri == "/reset" || uri == "/step");
+		mg_printf(conn, "%s", packed ? header200Packed : header200);
 		const std::string str = stream.str();
 		mg_write(conn, str.c_str(), str.length());
 		return handled;
@@ -310,7 +356,8 @@ void Interface::TryApplyMessage()
 	const bool isGameStarted = g_Game && g_Game->IsGameStarted();
 	if (m_NeedsGameState && isGameStarted)
 	{
-		m_ReturnValue = GetGameState();
+		UpdateSnapshot();
+		m_ReturnValue = GetObservation();
 		m_MsgApplied.notify_one();
 		m_MsgLock.unlock();
 		m_NeedsGameState = false;
@@ -334,10 +381,19 @@ void Interface::ApplyMessage(const GameMessage& msg)
 	const static std::string EMPTY_STATE;
 	const bool nonVisual = !g_GUI;
 	const bool isGameStarted = g_Game && g_Game->IsGameStarted();
+	m_ObservationFormat = msg.format;
 	switch (msg.type)
 	{
 		case GameMessageType::Reset:
 		{
+			if (isGameStarted && TryRestoreSnapshot())
+			{
+				m_ReturnValue = GetObservation();
+				m_MsgApplied.notify_one();
+				m_MsgLock.unlock();
+				break;
+			}
+
 			if (isGameStarted)
 				EndGame();
 
@@ -354,7 +410,8 @@ void Interface::ApplyMessage(const GameMessage& msg)
 			{
 				LDR_NonprogressiveLoad();
 				ENSURE(g_Game->ReallyStartGame() == PSRETURN_OK);
-				m_ReturnValue = GetGameState();
+				UpdateSnapshot();
+				m_ReturnValue = GetObservation();
 				m_MsgApplied.notify_one();
 				m_MsgLock.unlock();
 			}
@@ -404,7 +461,7 @@ void Interface::ApplyMessage(const GameMessage& msg)
 			else
 				g_Game->Update(deltaRealTime);
 
-			m_ReturnValue = GetGameState();
+			m_ReturnValue = GetObservation();
 			m_MsgApplied.notify_one();
 			m_MsgLock.unlock();
 			break;
@@ -432,6 +489,102 @@ void Interface::ApplyMessage(const GameMessage& msg)
 	}
 }
 
+bool Interface::TryRestoreSnapshot()
+{
+	// Replays record the commands from the start of the game, so they need a fresh game.
+	if (!m_ScenarioConfig.useSnapshot || m_ScenarioConfig.saveReplay || m_Snapshot.empty())
+		return false;
+
+	if (m_ScenarioConfig.playerID != m_SnapshotPlayerID || m_ScenarioConfig.content != m_SnapshotScenario)
+		return false;
+
+	PROFILE3("rl restore snapshot");
+	std::stringstream stream(m_Snapshot);
+	if (!g_Game->GetSimulation2()->DeserializeState(stream))
+	{
+		LOGERROR("RL interface: failed to restore the simulation snapshot, reloading the scenario");
+		m_Snapshot.clear();
+		return false;
+	}
+	g_Game->GetTurnManager()->ResetState(m_SnapshotTurn, m_SnapshotTurn);
+	return true;
+}
+
+void Interface::UpdateSnapshot()
+{
+	m_Snapshot.clear();
+	if (!m_ScenarioConfig.useSnapshot || m_ScenarioConfig.saveReplay)
+		return;
+
+	PROFILE3("rl serialize snapshot");
+	std::stringstream stream;
+	if (!g_Game->GetSimulation2()->SerializeState(stream))
+	{
+		LOGERROR("RL interface: failed to serialize the simulation snapshot");
+		return;
+	}
+	m_Snapshot = stream.str();
+	m_SnapshotScenario = m_ScenarioConfig.content;
+	m_SnapshotPlayerID = m_ScenarioConfig.playerID;
+	m_SnapshotTurn = g_Game->GetTurnManager()->GetCurrentTurn();
+}
+
+std::string Interface::GetObservation() const
+{
+	return m_ObservationFormat == ObservationFormat::Packed ? GetPackedGameState() : GetGameState();
+}
+
+std::string Interface::GetPackedGameState() const
+{
+	CSimulation2& simulation = *g_Game->GetSimulation2();
+	const ScriptInterface& scriptInterface = simulation.GetScriptInterface();
+	ScriptRequest rq(scriptInterface);
+
+	// Health is implemented in JS, so look up its interface id from the simulation scripts.
+	int iidHealth = -1;
+	JS::RootedValue iidValue(rq.cx);
+	if (ScriptInterface::GetGlobalProperty(rq, "IID_Health", &iidValue))
+		Script::FromJSVal(rq, iidValue, iidHealth);
+
+	std::vector<u32> ids;
+	std::vector<i32> owners;
+	std::vector<float> xs;
+	std::vector<float> zs;
+	std::vector<float> hitpoints;
+
+	for (const std::pair<entity_id_t, IComponent*>& ownership : simulation.GetEntitiesWithInterface(IID_Ownership))
+	{
+		const entity_id_t ent = ownership.first;
+		CmpPtr<ICmpPosition> cmpPosition(simulation, ent);
+		if (!cmpPosition || !cmpPosition->IsInWorld())
+			continue;
+
+		const CFixedVector2D position = cmpPosition->GetPosition2D();
+		ids.push_back(ent);
+		owners.push_back(static_cast<ICmpOwnership*>(ownership.second)->GetOwner());
+		xs.push_back(position.X.ToFloat());
+		zs.push_back(position.Y.ToFloat());
+
+		float hp = -1.f;
+		IComponent* cmpHealth = iidHealth == -1 ? nullptr : simulation.QueryInterface(ent, iidHealth);
+		if (cmpHealth)
+			ScriptFunction::Call(rq, cmpHealth->GetJSInstance(), "GetHitpoints", hp);
+		hitpoints.push_back(hp);
+	}
+
+	const u32 count = static_cast<u32>(ids.size());
+	std::string packed;
+	packed.reserve(sizeof(count) + count * (sizeof(u32) + sizeof(i32) + 3 * sizeof(float)));
+	packed.resize(sizeof(count));
+	write_le32(&packed[0], count);
+	AppendPacked(packed, ids);
+	AppendPacked(packed, owners);
+	AppendPacked(packed, xs);
+	AppendPacked(packed, zs);
+	AppendPacked(packed, hitpoints);
+	return packed;
+}
+
 std::string Interface::GetGameState() const
 {
 	const ScriptInterface& scriptInterface = g_Game->GetSimulation2()->GetScriptInterface();
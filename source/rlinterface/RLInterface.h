@@ -1,4 +1,4 @@
-/* Copyright (C) 2024 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -29,11 +29,27 @@ namespace RL
 {
 struct ScenarioConfig
 {
-	bool saveReplay;
-	player_id_t playerID;
+	bool saveReplay = false;
+	bool useSnapshot = false;
+	player_id_t playerID = 1;
 	std::string content;
 };
 
+/**
+ * Format of the gamestate returned after Reset and Step.
+ */
+enum class ObservationFormat
+{
+	/**
+	 * The full AI representation stringified as JSON.
+	 */
+	JSON,
+	/**
+	 * Entity ids, owners, positions and hitpoints as packed arrays, see GetPackedGameState.
+	 */
+	Packed,
+};
+
 struct GameCommand
 {
 	int playerID;
@@ -55,6 +71,7 @@ struct GameMessage
 {
 	GameMessageType type;
 	std::vector<GameCommand> commands;
+	ObservationFormat format = ObservationFormat::JSON;
 };
 
 /**
@@ -66,6 +83,9 @@ struct GameMessage
  * also supports querying unit templates to provide information about max health and other
  * potentially relevant game state information.
  *
+ * Resets may restore a serialized snapshot of the simulation taken right after the same
+ * scenario was last loaded instead of reloading the map, which is much cheaper.
+ *
  * See source/tools/rlclient/ for the external client code.
  *
  * The HTTP server is threaded.
@@ -100,13 +120,13 @@ private:
 	 * Process commands, update the simulation by one turn.
 	 * @return the gamestate after processing commands.
 	 */
-	std::string Step(std::vector<GameCommand>&& commands);
+	std::string Step(std::vector<GameCommand>&& commands, ObservationFormat format);
 
 	/**
 	 * Reset the game state according to scenario, cleaning up existing games if required.
 	 * @return the gamestate after resetting.
 	 */
-	std::string Reset(ScenarioConfig&& scenario);
+	std::string Reset(ScenarioConfig&& scenario, ObservationFormat format);
 
 	/**
 	 * Evaluate JS code in the engine such as applying arbitrary modifiers.
@@ -143,17 +163,49 @@ private:
 	 */
 	void ApplyMessage(const GameMessage& msg);
 
+	/**
+	 * Restore the simulation from m_Snapshot if it was taken for the current scenario.
+	 * @return true if the snapshot was restored, false if a full reset is required.
+	 */
+	bool TryRestoreSnapshot();
+
+	/**
+	 * Serialize the freshly loaded simulation into m_Snapshot, if requested by the scenario.
+	 */
+	void UpdateSnapshot();
+
 	/**
 	 * @return the full gamestate as a JSON strong.
 	 * This uses the AI representation since it is readily available in the JS Engine.
 	 */
 	std::string GetGameState() const;
 
+	/**
+	 * @return the gamestate of all owned entities in the world as packed little-endian arrays:
+	 * u32 count, u32 ids[count], i32 owners[count], f32 x[count], f32 z[count], f32 hitpoints[count].
+	 * Entities without health have -1 hitpoints.
+	 */
+	std::string GetPackedGameState() const;
+
+	/**
+	 * @return the gamestate in m_ObservationFormat.
+	 */
+	std::string GetObservation() const;
+
 private:
 	GameMessage m_GameMessage{GameMessageType::None};
 	ScenarioConfig m_ScenarioConfig;
 	std::string m_ReturnValue;
 	bool m_NeedsGameState = false;
+	ObservationFormat m_ObservationFormat = ObservationFormat::JSON;
+
+	/**
+	 * Serialized simulation state right after loading m_SnapshotScenario.
+	 */
+	std::string m_Snapshot;
+	std::string m_SnapshotScenario;
+	player_id_t m_SnapshotPlayerID = INVALID_PLAYER;
+	u32 m_SnapshotTurn = 0;
 
 	mutable std::mutex m_Lock;
 	std::mutex m_MsgLock;
@@ -98,6 +98,46 @@ private:
 	///////////////////////////////////////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////
 
+	/**
+	 * Fast path for the common primitive argument types: if @a v already has the
+	 * representation FromJSVal would produce, read it directly instead of going through the
+	 * out-of-line conversion. Anything else (doubles passed for ints, strings, ...) falls back
+	 * to FromJSVal, so the results are the same.
+	 * @return true if @a ret was set.
+	 */
+	template<typename T>
+	static bool TryFastConvertFromJS(JS::HandleValue v, T& ret)
+	{
+		if constexpr (std::is_same_v<T, bool>)
+		{
+			if (!v.isBoolean())
+				return false;
+			ret = v.toBoolean();
+			return true;
+		}
+		else if constexpr (std::is_same_v<T, i32> || std::is_same_v<T, u32>)
+		{
+			// ToUint32 of an int32 is its two's complement reinterpretation.
+			if (!v.isInt32())
+				return false;
+			ret = static_cast<T>(v.toInt32());
+			return true;
+		}
+		else if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>)
+		{
+			if (!v.isNumber())
+				return false;
+			ret = static_cast<T>(v.toNumber());
+			return true;
+		}
+		else
+		{
+			// GCC (at least < 9) & VS17 prints warnings if arguments are not used in some constexpr branch.
+			UNUSED2(v); UNUSED2(ret);
+			return false;
+		}
+	}
+
 	/**
 	 * DoConvertFromJS takes a type, a JS argument, and converts.
 	 * The type T must be default constructible (except for HandleValue, which is handled specially).
@@ -130,7 +170,8 @@ private:
 			else
 			{
 				T ret;
-				wentOk &= Script::FromJSVal<T>(rq, args[idx], ret);
+				if (!TryFastConvertFromJS<T>(args[idx], ret))
+					wentOk &= Script::FromJSVal<T>(rq, args[idx], ret);
 				return ret;
 			}
 		}
@@ -330,10 +371,15 @@ public:
 		 * For now we check for pending JS exceptions, but it would probably be nicer
 		 * to standardise on something, or perhaps provide an "errorHandler" here.
 		 */
-		if constexpr (std::is_same_v<void, typename args_info<decltype(callable)>::return_type>)
+		using ReturnType = typename args_info<decltype(callable)>::return_type;
+		if constexpr (std::is_same_v<void, ReturnType>)
 			call<callable>(obj, outs);
-		else if constexpr (std::is_same_v<JS::Value, typename args_info<decltype(callable)>::return_type>)
+		else if constexpr (std::is_same_v<JS::Value, ReturnType>)
 			args.rval().set(call<callable>(obj, outs));
+		else if constexpr (std::is_same_v<bool, ReturnType>)
+			args.rval().setBoolean(call<callable>(obj, outs));
+		else if constexpr (Script::IsPlainNumber<ReturnType>)
+			args.rval().set(JS::NumberValue(call<callable>(obj, outs)));
 		else
 			Script::ToJSVal(rq, args.rval(), call<callable>(obj, outs));
 
@@ -110,23 +110,53 @@ template<typename T> inline bool FromJSProperty(const ScriptRequest& rq, const J
 	return FromJSVal(rq, value, ret);
 }
 
+/**
+ * Types whose ToJSVal is a plain JS::NumberValue, so that hot paths can inline the conversion.
+ */
+template<typename T>
+constexpr bool IsPlainNumber = std::is_same_v<T, i32> || std::is_same_v<T, u32> || std::is_same_v<T, u16> ||
+	std::is_same_v<T, u8> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
 template<typename T> inline void ToJSVal_vector(const ScriptRequest& rq, JS::MutableHandleValue ret, const std::vector<T>& val)
 {
-	JS::RootedObject obj(rq.cx, JS::NewArrayObject(rq.cx, 0));
-	if (!obj)
+	ENSURE(val.size() <= std::numeric_limits<u32>::max());
+
+	if constexpr (IsPlainNumber<T>)
 	{
-		ret.setUndefined();
-		return;
+		// Lists of numbers (most often entity IDs) are built in one go as a dense array,
+		// instead of growing the array one JS_SetElement at a time.
+		JS::RootedValueVector elements(rq.cx);
+		if (!elements.reserve(val.size()))
+		{
+			ret.setUndefined();
+			return;
+		}
+		for (const T& el : val)
+			elements.infallibleAppend(JS::NumberValue(el));
+
+		JS::RootedObject obj(rq.cx, JS::NewArrayObject(rq.cx, elements));
+		if (!obj)
+			ret.setUndefined();
+		else
+			ret.setObject(*obj);
 	}
-
-	ENSURE(val.size() <= std::numeric_limits<u32>::max());
-	for (u32 i = 0; i < val.size(); ++i)
+	else
 	{
-		JS::RootedValue el(rq.cx);
-		Script::ToJSVal<T>(rq, &el, val[i]);
-		JS_SetElement(rq.cx, obj, i, el);
+		JS::RootedObject obj(rq.cx, JS::NewArrayObject(rq.cx, 0));
+		if (!obj)
+		{
+			ret.setUndefined();
+			return;
+		}
+
+		for (u32 i = 0; i < val.size(); ++i)
+		{
+			JS::RootedValue el(rq.cx);
+			Script::ToJSVal<T>(rq, &el, val[i]);
+			JS_SetElement(rq.cx, obj, i, el);
+		}
+		ret.setObject(*obj);
 	}
-	ret.setObject(*obj);
 }
 
 #define FAIL(msg) STMT(ScriptException::Raise(rq, msg); return false)
@@ -17,6 +17,7 @@
 
 #include "lib/self_test.h"
 
+#include "lib/timer.h"
 #include "scriptinterface/FunctionWrapper.h"
 #include "scriptinterface/ScriptContext.h"
 #include "scriptinterface/ScriptInterface.h"
@@ -111,6 +112,88 @@ public:
 		}
 	}
 
+	static u32 _u32_r(u32 a) { return a; };
+	static double _double_r(double a) { return a; };
+	static bool _bool_r(bool a) { return a; };
+	static std::vector<u32> _vector_r(u32 n)
+	{
+		std::vector<u32> ret(n);
+		for (u32 i = 0; i < n; ++i)
+			ret[i] = i + 1;
+		return ret;
+	};
+
+	void test_primitive_conversions()
+	{
+		ScriptInterface script("Test", "Test", g_ScriptContext);
+		ScriptRequest rq(script);
+
+		ScriptFunction::Register<&TestFunctionWrapper::_3p_r>(script, "_3p_r");
+		ScriptFunction::Register<&TestFunctionWrapper::_u32_r>(script, "_u32_r");
+		ScriptFunction::Register<&TestFunctionWrapper::_double_r>(script, "_double_r");
+		ScriptFunction::Register<&TestFunctionWrapper::_bool_r>(script, "_bool_r");
+		ScriptFunction::Register<&TestFunctionWrapper::_vector_r>(script, "_vector_r");
+
+		// Values that don't have the exact representation go through the generic conversion.
+		int ret = 0;
+		TS_ASSERT(script.Eval("Test._3p_r(4.7, false, 'test');", ret));
+		TS_ASSERT_EQUALS(ret, 4);
+
+		u32 retU32 = 0;
+		TS_ASSERT(script.Eval("Test._u32_r(-1);", retU32));
+		TS_ASSERT_EQUALS(retU32, 0xFFFFFFFFu);
+		TS_ASSERT(script.Eval("Test._u32_r(4294967295);", retU32));
+		TS_ASSERT_EQUALS(retU32, 0xFFFFFFFFu);
+
+		double retDouble = 0;
+		TS_ASSERT(script.Eval("Test._double_r(3);", retDouble));
+		TS_ASSERT_EQUALS(retDouble, 3.0);
+		TS_ASSERT(script.Eval("Test._double_r(0.5);", retDouble));
+		TS_ASSERT_EQUALS(retDouble, 0.5);
+
+		bool retBool = false;
+		TS_ASSERT(script.Eval("Test._bool_r(true);", retBool));
+		TS_ASSERT(retBool);
+
+		std::string retString;
+		TS_ASSERT(script.Eval("JSON.stringify(Test._vector_r(4));", retString));
+		TS_ASSERT_STR_EQUALS(retString, "[1,2,3,4]");
+		TS_ASSERT(script.Eval("Array.isArray(Test._vector_r(0)) && Test._vector_r(0).length === 0;", retBool));
+		TS_ASSERT(retBool);
+	}
+
+	/**
+	 * Measures the overhead of JS->C++ calls through ScriptFunction.
+	 * Enable it by hand when working on FunctionWrapper.h or the conversions.
+	 */
+	void DISABLE_test_perf()
+	{
+		ScriptInterface script("Test", "Test", g_ScriptContext);
+		ScriptRequest rq(script);
+
+		ScriptFunction::Register<&TestFunctionWrapper::_0p_v>(script, "_0p_v");
+		ScriptFunction::Register<&TestFunctionWrapper::_3p_r>(script, "_3p_r");
+		ScriptFunction::Register<&TestFunctionWrapper::_u32_r>(script, "_u32_r");
+		ScriptFunction::Register<&TestFunctionWrapper::_double_r>(script, "_double_r");
+		ScriptFunction::Register<&TestFunctionWrapper::_vector_r>(script, "_vector_r");
+
+		const auto measure = [&](const char* name, const char* call, int reps)
+		{
+			const std::string input = fmt::format("for (let i = 0; i < {}; ++i) {};", reps, call);
+			double t = timer_Time();
+			TS_ASSERT(script.Eval(input.c_str()));
+			t = timer_Time() - t;
+			printf("%s: %lfus per call\n", name, t / reps * 1e6);
+		};
+
+		printf("Testing performance of ScriptFunction calls\n");
+		measure("no arguments", "Test._0p_v()", 1000000);
+		measure("int, bool, string", "Test._3p_r(i, true, 'test')", 1000000);
+		measure("u32", "Test._u32_r(i)", 1000000);
+		measure("double", "Test._double_r(i * 0.5)", 1000000);
+		measure("vector of 1000 u32", "Test._vector_r(1000)", 10000);
+	}
+
 	void test_statefull()
 	{
 		ScriptInterface script{"Test", "Test", g_ScriptContext};
@@ -111,6 +111,7 @@ public:
 	void Interpolate(float simFrameLength, float frameOffset, float realFrameLength);
 
 	void DumpState();
+	void WriteMessageProfile();
 
 	CSimContext m_SimContext;
 	CComponentManager m_ComponentManager;
@@ -128,6 +129,8 @@ public:
 	bool m_EnableOOSLog{false};
 	OsPath m_OOSLogPath;
 
+	std::unique_ptr<std::ofstream> m_MessageProfileStream;
+
 	// Functions and data for the serialization test mode: (see Update() for relevant comments)
 
 	bool m_EnableSerializationTest{false};
@@ -491,6 +494,9 @@ void CSimulation2Impl::Update(int turnLength, const std::vector<SimulationComman
 	if (m_EnableOOSLog)
 		DumpState();
 
+	if (m_MessageProfileStream)
+		WriteMessageProfile();
+
 	++m_TurnNumber;
 }
 
@@ -616,6 +622,24 @@ void CSimulation2Impl::DumpState()
 	m_ComponentManager.SerializeState(binfile);
 }
 
+void CSimulation2Impl::WriteMessageProfile()
+{
+	PROFILE("WriteMessageProfile");
+
+	std::ofstream& stream = *m_MessageProfileStream;
+	for (const CComponentManager::MessageProfile::value_type& entry : m_ComponentManager.TakeMessageProfile())
+	{
+		if (entry.second.calls == 0)
+			continue;
+		stream << m_TurnNumber << ","
+			<< m_ComponentManager.LookupComponentTypeName(entry.first.first) << ","
+			<< m_ComponentManager.LookupMessageTypeName(entry.first.second) << ","
+			<< entry.second.calls << ","
+			<< std::fixed << std::setprecision(3) << entry.second.time * 1000.0 << "\n";
+	}
+	stream.flush();
+}
+
 ////////////////////////////////////////////////////////////////
 
 CSimulation2::CSimulation2(CUnitManager* unitManager, ScriptContext& cx, CTerrain* terrain) :
@@ -648,6 +672,19 @@ void CSimulation2::EnableOOSLog()
 	debug_printf("Writing ooslogs to %s\n", m->m_OOSLogPath.string8().c_str());
 }
 
+void CSimulation2::EnableMessageProfile()
+{
+	if (m->m_MessageProfileStream)
+		return;
+
+	const OsPath path = psLogDir() / "sim_message_profile.csv";
+	m->m_MessageProfileStream = std::make_unique<std::ofstream>(OsString(path), std::ofstream::out | std::ofstream::trunc);
+	*m->m_MessageProfileStream << "turn,component,message,calls,time_ms\n";
+	m->m_ComponentManager.SetMessageProfileEnabled(true);
+
+	debug_printf("Writing simulation message profile to %s\n", path.string8().c_str());
+}
+
 entity_id_t CSimulation2::AddEntity(const std::wstring& templateName)
 {
 	return m->m_ComponentManager.AddEntity(templateName, m->m_ComponentManager.AllocateNewEntity());
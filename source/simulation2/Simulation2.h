@@ -1,4 +1,4 @@
-/* Copyright (C) 2024 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -58,6 +58,12 @@ public:
 	void EnableRejoinTest(int rejoinTestTurn);
 	void EnableOOSLog();
 
+	/**
+	 * Writes the time spent handling each message type, per component type,
+	 * to sim_message_profile.csv in the logs directory after every turn.
+	 */
+	void EnableMessageProfile();
+
 	/**
 	 * Load all scripts in the specified directory (non-recursively),
 	 * so they can register new component types and functions. This
@@ -226,6 +226,11 @@ public:
 
 	~CAIWorker()
 	{
+		{
+			ScriptRequest rq(m_ScriptInterface);
+			ReleaseGridView(rq, &m_PassabilityMapBuffer);
+			ReleaseGridView(rq, &m_TerritoryMapBuffer);
+		}
 		// Init will always be called.
 		JS_RemoveExtraGCRootsTracer(m_ScriptInterface->GetGeneralJSContext(), Trace, this);
 	}
@@ -241,7 +246,9 @@ public:
 		m_EntityTemplates.init(rq.cx);
 		m_SharedAIObj.init(rq.cx);
 		m_PassabilityMapVal.init(rq.cx);
+		m_PassabilityMapBuffer.init(rq.cx);
 		m_TerritoryMapVal.init(rq.cx);
+		m_TerritoryMapBuffer.init(rq.cx);
 
 
 		m_ScriptInterface->ReplaceNondeterministicRNG(m_RNG);
@@ -498,10 +505,14 @@ public:
 
 		JS::RootedValue state(rq.cx);
 		Script::ReadStructuredClone(rq, gameState, &state);
-		Script::ToJSVal(rq, &m_PassabilityMapVal, passabilityMap);
-		Script::ToJSVal(rq, &m_TerritoryMapVal, territoryMap);
 
+		ReleaseGridView(rq, &m_PassabilityMapBuffer);
+		ReleaseGridView(rq, &m_TerritoryMapBuffer);
 		m_PassabilityMap = passabilityMap;
+		m_TerritoryMap = territoryMap;
+		CreateGridView(rq, &m_PassabilityMapVal, &m_PassabilityMapBuffer, m_PassabilityMap);
+		CreateGridView(rq, &m_TerritoryMapVal, &m_TerritoryMapBuffer, m_TerritoryMap);
+
 		m_NonPathfindingPassClasses = nonPathfindingPassClassMasks;
 		m_PathfindingPassClasses = pathfindingPassClassMasks;
 
@@ -531,14 +542,20 @@ public:
 		m_GameState.init(ScriptRequest(m_ScriptInterface).cx, gameState);
 	}
 
-	void UpdatePathfinder(const Grid<NavcellData>& passabilityMap, bool globallyDirty, const Grid<u8>& dirtinessGrid, bool justDeserialized,
+	void UpdatePathfinder(const Grid<NavcellData>& passabilityMap, const GridUpdateInformation& dirtinessInfos, bool justDeserialized,
 		const std::map<std::string, pass_class_t>& nonPathfindingPassClassMasks, const std::map<std::string, pass_class_t>& pathfindingPassClassMasks)
 	{
 		ENSURE(m_CommandsComputed);
 		bool dimensionChange = m_PassabilityMap.m_W != passabilityMap.m_W || m_PassabilityMap.m_H != passabilityMap.m_H;
 
+		ScriptRequest rq(m_ScriptInterface);
+		// The scripts see m_PassabilityMap through a view, so copying the grid in place is enough
+		// to update them. Only a reallocation of the grid needs a new view.
+		if (dimensionChange)
+			ReleaseGridView(rq, &m_PassabilityMapBuffer);
+
 		m_PassabilityMap = passabilityMap;
-		if (globallyDirty)
+		if (dirtinessInfos.globallyDirty)
 		{
 			m_LongPathfinder.Reload(&m_PassabilityMap);
 			m_HierarchicalPathfinder.Recompute(&m_PassabilityMap, nonPathfindingPassClassMasks, pathfindingPassClassMasks);
@@ -546,28 +563,11 @@ public:
 		else
 		{
 			m_LongPathfinder.Update(&m_PassabilityMap);
-			m_HierarchicalPathfinder.Update(&m_PassabilityMap, dirtinessGrid);
+			m_HierarchicalPathfinder.Update(&m_PassabilityMap, dirtinessInfos);
 		}
 
-		ScriptRequest rq(m_ScriptInterface);
 		if (dimensionChange || justDeserialized)
-			Script::ToJSVal(rq, &m_PassabilityMapVal, m_PassabilityMap);
-		else
-		{
-			// Avoid a useless memory reallocation followed by a garbage collection.
-			JS::RootedObject mapObj(rq.cx, &m_PassabilityMapVal.toObject());
-			JS::RootedValue mapData(rq.cx);
-			ENSURE(JS_GetProperty(rq.cx, mapObj, "data", &mapData));
-			JS::RootedObject dataObj(rq.cx, &mapData.toObject());
-
-			u32 length = 0;
-			ENSURE(JS::GetArrayLength(rq.cx, dataObj, &length));
-			u32 nbytes = (u32)(length * sizeof(NavcellData));
-
-			bool sharedMemory;
-			JS::AutoCheckCannotGC nogc;
-			memcpy((void*)JS_GetUint16ArrayData(dataObj, &sharedMemory, nogc), m_PassabilityMap.m_Data, nbytes);
-		}
+			CreateGridView(rq, &m_PassabilityMapVal, &m_PassabilityMapBuffer, m_PassabilityMap);
 	}
 
 	void UpdateTerritoryMap(const Grid<u8>& territoryMap)
@@ -575,27 +575,14 @@ public:
 		ENSURE(m_CommandsComputed);
 		bool dimensionChange = m_TerritoryMap.m_W != territoryMap.m_W || m_TerritoryMap.m_H != territoryMap.m_H;
 
+		ScriptRequest rq(m_ScriptInterface);
+		if (dimensionChange)
+			ReleaseGridView(rq, &m_TerritoryMapBuffer);
+
 		m_TerritoryMap = territoryMap;
 
-		ScriptRequest rq(m_ScriptInterface);
 		if (dimensionChange)
-			Script::ToJSVal(rq, &m_TerritoryMapVal, m_TerritoryMap);
-		else
-		{
-			// Avoid a useless memory reallocation followed by a garbage collection.
-			JS::RootedObject mapObj(rq.cx, &m_TerritoryMapVal.toObject());
-			JS::RootedValue mapData(rq.cx);
-			ENSURE(JS_GetProperty(rq.cx, mapObj, "data", &mapData));
-			JS::RootedObject dataObj(rq.cx, &mapData.toObject());
-
-			u32 length = 0;
-			ENSURE(JS::GetArrayLength(rq.cx, dataObj, &length));
-			u32 nbytes = (u32)(length * sizeof(u8));
-
-			bool sharedMemory;
-			JS::AutoCheckCannotGC nogc;
-			memcpy((void*)JS_GetUint8ArrayData(dataObj, &sharedMemory, nogc), m_TerritoryMap.m_Data, nbytes);
-		}
+			CreateGridView(rq, &m_TerritoryMapVal, &m_TerritoryMapBuffer, m_TerritoryMap);
 	}
 
 	void StartComputation()
@@ -762,6 +749,8 @@ public:
 		u16 mapW, mapH;
 		deserializer.NumberU16_Unbounded("pathfinder grid w", mapW);
 		deserializer.NumberU16_Unbounded("pathfinder grid h", mapH);
+		// The view is recreated by the first UpdatePathfinder after deserialization.
+		ReleaseGridView(rq, &m_PassabilityMapBuffer);
 		m_PassabilityMap = Grid<NavcellData>(mapW, mapH);
 		deserializer.RawBytes("pathfinder grid data", (u8*)m_PassabilityMap.m_Data, mapW*mapH*sizeof(NavcellData));
 		m_LongPathfinder.Reload(&m_PassabilityMap);
@@ -785,6 +774,57 @@ private:
 			JS::TraceEdge(trc, &metadata.second, "CAIWorker::m_PlayerMetadata");
 	}
 
+	/**
+	 * Expose @a grid to the AI scripts without copying its data. @a ret gets the same
+	 * {width, height, data} layout as Script::ToJSVal<Grid<T>>, but the typed array is a view
+	 * over the grid's own storage, so copying a grid of the same size into @a grid updates the
+	 * scripts for free. The AI scripts must treat the data as read-only.
+	 * The view must be released with ReleaseGridView before the storage of @a grid is freed.
+	 */
+	template<typename T>
+	static void CreateGridView(const ScriptRequest& rq, JS::MutableHandleValue ret, JS::MutableHandleObject buffer, Grid<T>& grid)
+	{
+		static_assert(sizeof(T) == sizeof(u8) || sizeof(T) == sizeof(u16), "Only u8 and u16 grids can be viewed from scripts");
+
+		u32 length = (u32)(grid.m_W * grid.m_H);
+		if (!grid.m_Data || length == 0)
+		{
+			// There is no storage to share, an empty copy does the job.
+			buffer.set(nullptr);
+			Script::ToJSVal(rq, ret, grid);
+			return;
+		}
+
+		buffer.set(JS::NewArrayBufferWithUserOwnedContents(rq.cx, length * sizeof(T), grid.m_Data));
+		ENSURE(buffer);
+
+		JS::RootedObject objArr(rq.cx);
+		if constexpr (sizeof(T) == sizeof(u8))
+			objArr = JS_NewUint8ArrayWithBuffer(rq.cx, buffer, 0, length);
+		else
+			objArr = JS_NewUint16ArrayWithBuffer(rq.cx, buffer, 0, length);
+		ENSURE(objArr);
+
+		JS::RootedValue data(rq.cx, JS::ObjectValue(*objArr));
+		Script::CreateObject(
+			rq,
+			ret,
+			"width", grid.m_W,
+			"height", grid.m_H,
+			"data", data);
+	}
+
+	/**
+	 * Detach the buffer created by CreateGridView, so that scripts still holding the old
+	 * view see an empty array instead of freed memory.
+	 */
+	static void ReleaseGridView(const ScriptRequest& rq, JS::MutableHandleObject buffer)
+	{
+		if (buffer && !JS::IsDetachedArrayBufferObject(buffer))
+			ENSURE(JS::DetachArrayBuffer(rq.cx, buffer));
+		buffer.set(nullptr);
+	}
+
 	void LoadMetadata(const VfsPath& path, JS::MutableHandleValue out)
 	{
 		if (m_PlayerMetadata.find(path) == m_PlayerMetadata.end())
@@ -852,8 +892,11 @@ private:
 	JS::PersistentRootedValue m_GameState;
 	Grid<NavcellData> m_PassabilityMap;
 	JS::PersistentRootedValue m_PassabilityMapVal;
+	// Buffer viewing m_PassabilityMap.m_Data, see CreateGridView.
+	JS::PersistentRootedObject m_PassabilityMapBuffer;
 	Grid<u8> m_TerritoryMap;
 	JS::PersistentRootedValue m_TerritoryMapVal;
+	JS::PersistentRootedObject m_TerritoryMapBuffer;
 
 	std::map<std::string, pass_class_t> m_NonPathfindingPassClasses;
 	std::map<std::string, pass_class_t> m_PathfindingPassClasses;
@@ -1020,8 +1063,7 @@ public:
 				std::map<std::string, pass_class_t> nonPathfindingPassClassMasks, pathfindingPassClassMasks;
 				cmpPathfinder->GetPassabilityClasses(nonPathfindingPassClassMasks, pathfindingPassClassMasks);
 
-				m_Worker.UpdatePathfinder(passabilityMap,
-					dirtinessInformations.globallyDirty, dirtinessInformations.dirtinessGrid, m_JustDeserialized,
+				m_Worker.UpdatePathfinder(passabilityMap, dirtinessInformations, m_JustDeserialized,
 					nonPathfindingPassClassMasks, pathfindingPassClassMasks);
 			}
 
@@ -584,6 +584,7 @@ private:
 		m_UpdateInformations.dirty = true;
 		m_UpdateInformations.globallyDirty = true;
 		m_UpdateInformations.dirtinessGrid.reset();
+		m_UpdateInformations.dirtyRects.clear();
 
 		m_DebugOverlayDirty = true;
 	}
@@ -613,9 +614,7 @@ private:
 		Pathfinding::NearestNavcell(x - hbox.X, z - hbox.Y, i0, j0, m_UpdateInformations.dirtinessGrid.m_W, m_UpdateInformations.dirtinessGrid.m_H);
 		Pathfinding::NearestNavcell(x + hbox.X, z + hbox.Y, i1, j1, m_UpdateInformations.dirtinessGrid.m_W, m_UpdateInformations.dirtinessGrid.m_H);
 
-		for (int j = j0; j < j1; ++j)
-			for (int i = i0; i < i1; ++i)
-				m_UpdateInformations.dirtinessGrid.set(i, j, 1);
+		m_UpdateInformations.MarkDirty(i0, j0, i1, j1);
 	}
 
 	/**
@@ -1211,15 +1210,10 @@ void CCmpObstructionManager::Rasterize(Grid<NavcellData>& grid, const std::vecto
 // 栅格化辅助函数
 void CCmpObstructionManager::RasterizeHelper(Grid<NavcellData>& grid, ICmpObstructionManager::flags_t requireMask, bool fullUpdate, pass_class_t appliedMask, entity_pos_t clearance) const
 {
-	for (auto& pair : m_StaticShapes)
+	auto rasterizeStatic = [&](const StaticShape& shape)
 	{
-		const StaticShape& shape = pair.second;
 		if (!(shape.flags & requireMask))
-			continue;
-
-		// 如果不是完全更新，则只处理脏的形状
-		if (!fullUpdate && std::find(m_DirtyStaticShapes.begin(), m_DirtyStaticShapes.end(), pair.first) == m_DirtyStaticShapes.end())
-			continue;
+			return;
 
 		// TODO: 对于大的 'expand' 值，使用圆角进行栅格化可能会更好。
 		ObstructionSquare square = { shape.x, shape.z, shape.u, shape.v, shape.hw, shape.hh };
@@ -1234,18 +1228,15 @@ void CCmpObstructionManager::RasterizeHelper(Grid<NavcellData>& grid, ICmpObstru
 			for (i16 i = i0; i < i1; ++i)
 				grid.set(i, j, grid.get(i, j) | appliedMask);
 		}
-	}
+	};
 
-	for (auto& pair : m_UnitShapes)
+	auto rasterizeUnit = [&](const UnitShape& shape)
 	{
-		if (!(pair.second.flags & requireMask))
-			continue;
-
-		if (!fullUpdate && std::find(m_DirtyUnitShapes.begin(), m_DirtyUnitShapes.end(), pair.first) == m_DirtyUnitShapes.end())
-			continue;
+		if (!(shape.flags & requireMask))
+			return;
 
-		CFixedVector2D center(pair.second.x, pair.second.z);
-		entity_pos_t r = pair.second.clearance + clearance;
+		CFixedVector2D center(shape.x, shape.z);
+		entity_pos_t r = shape.clearance + clearance;
 
 		u16 i0, j0, i1, j1;
 		Pathfinding::NearestNavcell(center.X - r, center.Y - r, i0, j0, grid.m_W, grid.m_H);
@@ -1253,6 +1244,33 @@ void CCmpObstructionManager::RasterizeHelper(Grid<NavcellData>& grid, ICmpObstru
 		for (u16 j = j0 + 1; j < j1; ++j)
 			for (u16 i = i0 + 1; i < i1; ++i)
 				grid.set(i, j, grid.get(i, j) | appliedMask);
+	};
+
+	if (fullUpdate)
+	{
+		for (const std::pair<const u32, StaticShape>& pair : m_StaticShapes)
+			rasterizeStatic(pair.second);
+		for (const std::pair<const u32, UnitShape>& pair : m_UnitShapes)
+			rasterizeUnit(pair.second);
+		return;
+	}
+
+	// 如果不是完全更新，则只处理脏的形状。
+	// 它们是在 MakeDirty* 中通过空间细分在脏区域附近查询得到的，
+	// 所以这里不需要遍历所有形状。掩码是按位或上去的，所以顺序无关紧要。
+	for (u32 index : m_DirtyStaticShapes)
+	{
+		std::map<u32, StaticShape>::const_iterator it = m_StaticShapes.find(index);
+		// 这些向量可能包含已被删除的形状的ID
+		if (it != m_StaticShapes.end())
+			rasterizeStatic(it->second);
+	}
+
+	for (u32 index : m_DirtyUnitShapes)
+	{
+		std::map<u32, UnitShape>::const_iterator it = m_UnitShapes.find(index);
+		if (it != m_UnitShapes.end())
+			rasterizeUnit(it->second);
 	}
 }
 
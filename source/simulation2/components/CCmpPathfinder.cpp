@@ -42,6 +42,7 @@
 #include "renderer/Scene.h"
 
 #include <type_traits>
+#include <utility>
 
   // 向组件系统注册 Pathfinder 组件类型
 REGISTER_COMPONENT_TYPE(Pathfinder)
@@ -319,7 +320,8 @@ const Grid<NavcellData>& CCmpPathfinder::GetPassabilityGrid()
  * 给定一个可通行/不可通行的导航单元格（navcell）网格（基于某个通行性掩码），
  * 计算一个新的网格，其中一个导航单元格（根据该掩码）如果
  * 距离原始网格中一个不可通行的导航单元格 <= clearance 个导航单元格，则该单元格也不可通行。
- * 结果会通过“或”运算合并到原始网格上。
+ * 结果（每个单元格是否被阻塞）写入 expanded，由调用者通过“或”运算合并到原始网格上。
+ * 此函数只读取原始网格，所以不同掩码的扩展可以并行计算。
  *
  * 这用于在基于地形的导航单元格通行性上增加间隙。
  *
@@ -327,7 +329,7 @@ const Grid<NavcellData>& CCmpPathfinder::GetPassabilityGrid()
  * 目前它实际上是使用 dist=max(dx,dy)。
  * 这只对大的间隙才真正是个问题。
  */
-static void ExpandImpassableCells(Grid<NavcellData>& grid, u16 clearance, pass_class_t mask)
+static void ExpandImpassableCells(const Grid<NavcellData>& grid, u16 clearance, pass_class_t mask, Grid<u8>& expanded)
 {
 	PROFILE3("ExpandImpassableCells");
 
@@ -374,9 +376,9 @@ static void ExpandImpassableCells(Grid<NavcellData>& grid, u16 clearance, pass_c
 
 		for (u16 j = 0; j < h; ++j)
 		{
-			// 如果被至少一个附近的单元格阻塞，则添加掩码
+			// 如果被至少一个附近的单元格阻塞，则存储一个标志
 			if (numBlocked)
-				grid.set(i, j, grid.get(i, j) | mask);
+				expanded.set(i, j, 1);
 
 			// 向前滑动 numBlocked 窗口：
 			// 移除旧的 j-clearance 值，添加新的 (j+1)+clearance 值
@@ -574,10 +576,12 @@ void CCmpPathfinder::UpdateGrid()
 	{
 		ENSURE(m_Grid->compare_sizes(m_TerrainOnlyGrid));
 
-		for (u16 j = 0; j < m_DirtinessInformation.dirtinessGrid.m_H; ++j)
-			for (u16 i = 0; i < m_DirtinessInformation.dirtinessGrid.m_W; ++i)
-				if (m_DirtinessInformation.dirtinessGrid.get(i, j) == 1)
-					m_Grid->set(i, j, m_TerrainOnlyGrid->get(i, j));
+		// 只需访问脏矩形内的单元格，而不是整个网格。
+		for (const GridUpdateInformation::Rect& rect : m_DirtinessInformation.dirtyRects)
+			for (u16 j = rect.j0; j < rect.j1; ++j)
+				for (u16 i = rect.i0; i < rect.i1; ++i)
+					if (m_DirtinessInformation.dirtinessGrid.get(i, j) == 1)
+						m_Grid->set(i, j, m_TerrainOnlyGrid->get(i, j));
 	}
 
 	// 将障碍物光栅化到网格上
@@ -594,7 +598,7 @@ void CCmpPathfinder::UpdateGrid()
 	else
 	{
 		m_LongPathfinder->Update(m_Grid);
-		m_PathfinderHier->Update(m_Grid, m_DirtinessInformation.dirtinessGrid);
+		m_PathfinderHier->Update(m_Grid, m_DirtinessInformation);
 	}
 
 	// 记住AI寻路器也需要执行的必要更新
@@ -753,14 +757,43 @@ void CCmpPathfinder::TerrainUpdateHelper(bool expandPassability, int itile0, int
 	// 以便我们可以阻止单位过于靠近不可通行的导航单元格。
 	// 注意：不可能一次为所有具有相同间隙的通行性类别执行此扩展，
 	// 因为对于所有这些通行性类别，不可通行的单元格不一定相同。
-	for (PathfinderPassability& passability : m_PassClasses)
+	struct Expansion
+	{
+		u16 clearance;
+		pass_class_t mask;
+		Grid<u8> expanded;
+	};
+	std::vector<Expansion> expansions;
+	expansions.reserve(m_PassClasses.size());
+	for (const PathfinderPassability& passability : m_PassClasses)
 	{
 		if (passability.m_Clearance == fixed::Zero())
 			continue;
 
-		int clearance = (passability.m_Clearance / Pathfinding::NAVCELL_SIZE).ToInt_RoundToInfinity();
-		ExpandImpassableCells(*m_TerrainOnlyGrid, clearance, passability.m_Mask);
+		u16 clearance = (passability.m_Clearance / Pathfinding::NAVCELL_SIZE).ToInt_RoundToInfinity();
+		expansions.push_back({ clearance, passability.m_Mask, Grid<u8>(w, h) });
 	}
+
+	// 每个类别的掩码都不同，扩展只读取自己的位，所以可以在工作线程上并行计算，
+	// 之后再在这里按顺序合并，结果与串行计算完全相同。
+	std::vector<Future<void>> futures;
+	for (size_t k = 1; k < expansions.size(); ++k)
+		futures.push_back(g_TaskManager.PushTask(
+			[&grid = std::as_const(*m_TerrainOnlyGrid), &expansion = expansions[k]]()
+			{
+				ExpandImpassableCells(grid, expansion.clearance, expansion.mask, expansion.expanded);
+			}));
+	// 主线程也计算一个，以免空等。
+	if (!expansions.empty())
+		ExpandImpassableCells(*m_TerrainOnlyGrid, expansions[0].clearance, expansions[0].mask, expansions[0].expanded);
+	for (Future<void>& future : futures)
+		future.Get();
+
+	const size_t size = static_cast<size_t>(w) * h;
+	for (const Expansion& expansion : expansions)
+		for (size_t k = 0; k < size; ++k)
+			if (expansion.expanded.m_Data[k])
+				m_TerrainOnlyGrid->m_Data[k] |= expansion.mask;
 }
 
 //////////////////////////////////////////////////////////
@@ -24,9 +24,16 @@
 #include "simulation2/components/ICmpPosition.h"
 #include "simulation2/components/ICmpRangeManager.h"
 #include "simulation2/components/ICmpOwnership.h"
+#include "simulation2/components/ICmpTemplateManager.h"
 
+#include "ps/algorithm.h"
 #include "soundmanager/ISoundManager.h"
 
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
 class CCmpSoundManager final : public ICmpSoundManager
 {
 public:
@@ -105,6 +112,56 @@ public:
 		g_SoundManager->Pause(true);
 	}
 
+	void PrefetchSoundGroups() const override
+	{
+		if (!g_SoundManager)
+			return;
+
+		CmpPtr<ICmpTemplateManager> cmpTemplateManager(GetSystemEntity());
+		if (!cmpTemplateManager)
+			return;
+
+		std::set<std::wstring> soundGroups;
+		for (const std::string& templateName : cmpTemplateManager->FindUsedTemplates())
+		{
+			const CParamNode* node = cmpTemplateManager->GetTemplateWithoutValidation(templateName);
+			if (!node)
+				continue;
+
+			// Sound.js only plays sounds of entities with an identity.
+			const CParamNode& identity = node->GetChild("Identity");
+			if (!identity.IsOk())
+				continue;
+
+			// Expand the placeholders like Sound.js does at play time, with
+			// every phenotype the entities of this template can get.
+			std::wstring lang = identity.GetChild("Lang").ToWString();
+			if (lang.empty())
+				lang = L"greek";
+			std::vector<std::wstring> phenotypes;
+			std::wistringstream phenotypeStream(identity.GetChild("Phenotype").ToWString());
+			for (std::wstring phenotype; phenotypeStream >> phenotype;)
+				phenotypes.push_back(phenotype);
+			if (phenotypes.empty())
+				phenotypes.push_back(L"default");
+
+			for (const std::pair<const std::string, CParamNode>& soundGroup : node->GetChild("Sound").GetChild("SoundGroups").GetChildren())
+				for (const std::wstring& phenotype : phenotypes)
+				{
+					std::wstring path = soundGroup.second.ToWString();
+					PS::ReplaceSubrange(path, L"{lang}", lang);
+					PS::ReplaceSubrange(path, L"{phenotype}", phenotype);
+					// Skip placeholders we don't know about rather than
+					// failing to load the group.
+					if (path.find(L'{') == std::wstring::npos)
+						soundGroups.insert(std::move(path));
+				}
+		}
+
+		for (const std::wstring& soundGroup : soundGroups)
+			g_SoundManager->PrefetchSoundGroup(soundGroup);
+	}
+
 };
 
 REGISTER_COMPONENT_TYPE(SoundManager)
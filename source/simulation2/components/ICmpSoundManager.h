@@ -1,4 +1,4 @@
-/* Copyright (C) 2020 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -53,6 +53,12 @@ public:
 
 	virtual void StopMusic() = 0;
 
+	/**
+	 * Start decoding the sound groups of all templates used on the map in
+	 * the background, so playing them doesn't wait on the decoder.
+	 */
+	virtual void PrefetchSoundGroups() const = 0;
+
 	DECLARE_INTERFACE_TYPE(SoundManager)
 };
 
@@ -1,4 +1,4 @@
-/* Copyright (C) 2020 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -114,7 +114,7 @@ public:
 
 		HierarchicalPathfinder hierPath;
 		Grid<NavcellData> grid(mapSize, mapSize);
-		Grid<u8> dirtyGrid(mapSize, mapSize);
+		GridUpdateInformation dirtyInfos{ true, false, Grid<u8>(mapSize, mapSize) };
 
 		// Entirely passable for PASS_1, not for others;
 		for (size_t i = 0; i < mapSize; ++i)
@@ -130,10 +130,10 @@ public:
 		for (u16 j = 0; j < mapSize; ++j)
 		{
 			grid.set(125, j, 7);
-			dirtyGrid.set(125, j, 1);
+			dirtyInfos.MarkDirty(125, j, 126, j + 1);
 		}
 
-		hierPath.Update(&grid, dirtyGrid);
+		hierPath.Update(&grid, dirtyInfos);
 
 		// Global region: check we are now split in two.
 		TS_ASSERT(hierPath.GetGlobalRegion(50, 50, PASS_1) != hierPath.GetGlobalRegion(150, 50, PASS_1));
@@ -173,9 +173,9 @@ public:
 		for (u16 j = 0; j < mapSize; ++j)
 		{
 			grid.set(125, j, 6);
-			dirtyGrid.set(125, j, 1);
+			dirtyInfos.MarkDirty(125, j, 126, j + 1);
 		}
-		hierPath.Update(&grid, dirtyGrid);
+		hierPath.Update(&grid, dirtyInfos);
 		assert_blank(hierPath);
 
 		//////////////////////////////////////////////////////
@@ -183,9 +183,9 @@ public:
 		for (u16 j = 120; j < 150; ++j)
 		{
 			grid.set(125, j, 7);
-			dirtyGrid.set(125, j, 1);
+			dirtyInfos.MarkDirty(125, j, 126, j + 1);
 		}
-		hierPath.Update(&grid, dirtyGrid);
+		hierPath.Update(&grid, dirtyInfos);
 		reachables.clear();
 		hierPath.FindReachableRegions(hierPath.Get(170, 120, PASS_1), reachables, PASS_1);
 		TS_ASSERT(reachables.size() == 9);
@@ -196,9 +196,9 @@ public:
 		for (u16 j = 70; j < 200; ++j)
 		{
 			grid.set(96, j, 7);
-			dirtyGrid.set(96, j, 1);
+			dirtyInfos.MarkDirty(96, j, 97, j + 1);
 		}
-		hierPath.Update(&grid, dirtyGrid);
+		hierPath.Update(&grid, dirtyInfos);
 		reachables.clear();
 		hierPath.FindReachableRegions(hierPath.Get(170, 120, PASS_1), reachables, PASS_1);
 		TS_ASSERT(reachables.size() == 9);
@@ -211,9 +211,9 @@ public:
 		for (u16 j = 70; j < 200; ++j)
 		{
 			grid.set(192, j, 7);
-			dirtyGrid.set(192, j, 1);
+			dirtyInfos.MarkDirty(192, j, 193, j + 1);
 		}
-		hierPath.Update(&grid, dirtyGrid);
+		hierPath.Update(&grid, dirtyInfos);
 		reachables.clear();
 		hierPath.FindReachableRegions(hierPath.Get(170, 120, PASS_1), reachables, PASS_1);
 		TS_ASSERT(reachables.size() == 9);
@@ -226,19 +226,19 @@ public:
 		for (u16 i = 96; i < 140; ++i)
 		{
 			grid.set(i, 110, 7);
-			dirtyGrid.set(i, 110, 1);
+			dirtyInfos.MarkDirty(i, 110, i + 1, 111);
 		}
 		for (u16 i = 96; i < 140; ++i)
 		{
 			grid.set(i, 140, 7);
-			dirtyGrid.set(i, 140, 1);
+			dirtyInfos.MarkDirty(i, 140, i + 1, 141);
 		}
 		for (u16 j = 110; j < 141; ++j)
 		{
 			grid.set(140, j, 7);
-			dirtyGrid.set(140, j, 1);
+			dirtyInfos.MarkDirty(140, j, 141, j + 1);
 		}
-		hierPath.Update(&grid, dirtyGrid);
+		hierPath.Update(&grid, dirtyInfos);
 
 		TS_ASSERT(hierPath.GetGlobalRegion(120, 120, PASS_1) != hierPath.GetGlobalRegion(150, 50, PASS_1));
 
@@ -258,9 +258,9 @@ public:
 		for (u16 j = 110; j < 141; ++j)
 		{
 			grid.set(140, j, 6);
-			dirtyGrid.set(140, j, 1);
+			dirtyInfos.MarkDirty(140, j, 141, j + 1);
 		}
-		hierPath.Update(&grid, dirtyGrid);
+		hierPath.Update(&grid, dirtyInfos);
 
 		TS_ASSERT(hierPath.GetGlobalRegion(120, 120, PASS_1) == hierPath.GetGlobalRegion(150, 50, PASS_1));
 		reachables.clear();
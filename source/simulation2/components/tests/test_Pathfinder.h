@@ -65,6 +65,40 @@ public:
 		TS_ASSERT_EQUALS((Pathfinding::NAVCELL_SIZE >> 1).ToInt_RoundToZero(), Pathfinding::NAVCELL_SIZE_LOG2);
 	}
 
+	void test_dirty_rects()
+	{
+		GridUpdateInformation a{ false, false, Grid<u8>(16, 16) };
+		GridUpdateInformation b{ false, false, Grid<u8>(16, 16) };
+
+		a.dirty = true;
+		a.MarkDirty(1, 1, 3, 3);
+		a.MarkDirty(5, 5, 5, 8); // Empty rects are ignored.
+		TS_ASSERT_EQUALS(a.dirtyRects.size(), 1u);
+		TS_ASSERT_EQUALS(a.dirtinessGrid.get(2, 2), 1);
+		TS_ASSERT_EQUALS(a.dirtinessGrid.get(3, 3), 0);
+
+		b.dirty = true;
+		b.MarkDirty(10, 12, 11, 14);
+		a.MergeAndClear(b);
+		TS_ASSERT_EQUALS(a.dirtyRects.size(), 2u);
+		TS_ASSERT_EQUALS(a.dirtinessGrid.get(10, 13), 1);
+		TS_ASSERT(b.dirtyRects.empty());
+		TS_ASSERT(!b.dirty);
+
+		// Too many rects are merged into their bounding box.
+		for (size_t k = a.dirtyRects.size(); k <= GridUpdateInformation::MAX_DIRTY_RECTS; ++k)
+			a.MarkDirty(0, 15, 1, 16);
+		TS_ASSERT_EQUALS(a.dirtyRects.size(), 1u);
+		TS_ASSERT_EQUALS(a.dirtyRects[0].i0, 0);
+		TS_ASSERT_EQUALS(a.dirtyRects[0].j0, 1);
+		TS_ASSERT_EQUALS(a.dirtyRects[0].i1, 11);
+		TS_ASSERT_EQUALS(a.dirtyRects[0].j1, 16);
+
+		a.Clean();
+		TS_ASSERT(a.dirtyRects.empty());
+		TS_ASSERT(a.dirtinessGrid == Grid<u8>(16, 16));
+	}
+
 	void test_pathgoal_nearest_distance()
 	{
 		entity_pos_t i = Pathfinding::NAVCELL_SIZE;
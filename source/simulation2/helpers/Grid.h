@@ -1,4 +1,4 @@
-/* Copyright (C) 2020 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * 本文件是 0 A.D. 的一部分。
  *
  * 0 A.D. 是自由软件：您可以根据自由软件基金会发布的 GNU 通用公共许可证
@@ -17,7 +17,9 @@
 
 #include "simulation2/serialization/SerializeTemplates.h"
 
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
  // 预处理器宏，用于在非调试(NDEBUG)版本中禁用格子图边界检查，以提高性能
 #ifdef NDEBUG
@@ -415,9 +417,38 @@ public:
  */
 struct GridUpdateInformation
 {
+	/**
+	 * 脏区域的外接矩形（半开区间 [i0, i1) x [j0, j1)，以导航单元格为单位）。
+	 * 矩形之间可能重叠，矩形内部也可能有干净的单元格，
+	 * 所以使用者仍需检查 dirtinessGrid。
+	 */
+	struct Rect
+	{
+		u16 i0, j0, i1, j1;
+	};
+
+	// 超过此数量时，脏矩形会被合并成一个外接矩形，以免列表无限增长。
+	static constexpr size_t MAX_DIRTY_RECTS = 64;
+
 	bool dirty; // 标志位，表示是否有任何部分是“脏”的
 	bool globallyDirty; // 标志位，表示是否整个格子图都是“脏”的
 	Grid<u8> dirtinessGrid; // 存储“脏”区域的格子图
+	std::vector<Rect> dirtyRects; // 覆盖 dirtinessGrid 中所有脏单元格的矩形
+
+	/**
+	 * 将一个矩形区域标记为脏（不改变 dirty 标志位）。
+	 */
+	void MarkDirty(u16 i0, u16 j0, u16 i1, u16 j1)
+	{
+		if (i0 >= i1 || j0 >= j1)
+			return;
+
+		for (u16 j = j0; j < j1; ++j)
+			for (u16 i = i0; i < i1; ++i)
+				dirtinessGrid.set(i, j, 1);
+
+		AddDirtyRect({ i0, j0, i1, j1 });
+	}
 
 	/**
 	 * 将额外需要的更新信息合并进来，然后清除添加的源。
@@ -434,22 +465,58 @@ struct GridUpdateInformation
 
 		// 如果当前格子图无用，则交换它
 		if (!wasDirty)
+		{
 			dirtinessGrid.swap(b.dirtinessGrid);
-		// 如果新的格子图未被使用，则不必费心更新它
+			dirtyRects.swap(b.dirtyRects);
+		}
+		// 如果新的格子图未被使用，则不必费心更新它，
+		// 否则只需合并 b 的脏矩形内的单元格
 		else if (dirty && !globallyDirty)
-			dirtinessGrid.bitwise_or(b.dirtinessGrid);
+		{
+			for (const Rect& rect : b.dirtyRects)
+			{
+				for (u16 j = rect.j0; j < rect.j1; ++j)
+					for (u16 i = rect.i0; i < rect.i1; ++i)
+						dirtinessGrid.m_Data[j * dirtinessGrid.m_W + i] |= b.dirtinessGrid.m_Data[j * dirtinessGrid.m_W + i];
+				AddDirtyRect(rect);
+			}
+		}
 
 		b.Clean();
 	}
 
 	/**
 	 * 将所有内容标记为干净。
+	 * 所有脏单元格都在脏矩形内，所以只需重置这些矩形，而不是整个网格。
 	 */
 	void Clean()
 	{
 		dirty = false;
 		globallyDirty = false;
-		dirtinessGrid.reset();
+		for (const Rect& rect : dirtyRects)
+			for (u16 j = rect.j0; j < rect.j1; ++j)
+				memset(&dirtinessGrid.m_Data[j * dirtinessGrid.m_W + rect.i0], 0, (rect.i1 - rect.i0) * sizeof(u8));
+		dirtyRects.clear();
+	}
+
+private:
+	void AddDirtyRect(const Rect& rect)
+	{
+		if (dirtyRects.size() < MAX_DIRTY_RECTS)
+		{
+			dirtyRects.push_back(rect);
+			return;
+		}
+
+		Rect bounds = rect;
+		for (const Rect& r : dirtyRects)
+		{
+			bounds.i0 = std::min(bounds.i0, r.i0);
+			bounds.j0 = std::min(bounds.j0, r.j0);
+			bounds.i1 = std::max(bounds.i1, r.i1);
+			bounds.j1 = std::max(bounds.j1, r.j1);
+		}
+		dirtyRects.assign(1, bounds);
 	}
 };
 
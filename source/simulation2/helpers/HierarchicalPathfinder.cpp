@@ -1,4 +1,4 @@
-/* Copyright (C) 2021 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -435,7 +435,7 @@ void HierarchicalPathfinder::Recompute(Grid<NavcellData>* grid,
 	}
 }
 
-void HierarchicalPathfinder::Update(Grid<NavcellData>* grid, const Grid<u8>& dirtinessGrid)
+void HierarchicalPathfinder::Update(Grid<NavcellData>* grid, const GridUpdateInformation& dirtinessInfos)
 {
 	PROFILE3("Hierarchical Update");
 
@@ -444,7 +444,7 @@ void HierarchicalPathfinder::Update(Grid<NavcellData>* grid, const Grid<u8>& dir
 	std::map<pass_class_t, std::vector<RegionID> > needNewGlobalRegionMap;
 
 	// Algorithm for the partial update:
-	// 1. Loop over chunks.
+	// 1. Loop over the chunks overlapping a dirty rect.
 	// 2. For any dirty chunk:
 	//		- remove all regions from the global region map
 	//		- remove all edges, by removing the neighbor connection with them and then deleting us
@@ -455,46 +455,62 @@ void HierarchicalPathfinder::Update(Grid<NavcellData>* grid, const Grid<u8>& dir
 	// That's quite annoying, but I can't think of an easy way around it.
 	// If we could be sure that a region's topology hasn't changed, we could skip removing its global region
 	// but that's non trivial as we have no easy way to determine said topology (regions could "switch" IDs on update for now).
-	for (u8 cj = 0; cj <  m_ChunksH; ++cj)
+	const Grid<u8>& dirtinessGrid = dirtinessInfos.dirtinessGrid;
+
+	// Only chunks overlapping a dirty rect can contain dirty navcells. They are
+	// visited in the same order as a scan over all chunks would.
+	std::vector<int> dirtyChunks;
+	for (const GridUpdateInformation::Rect& rect : dirtinessInfos.dirtyRects)
+	{
+		int cj1 = std::min((rect.j1 - 1) / CHUNK_SIZE, m_ChunksH - 1);
+		int ci1 = std::min((rect.i1 - 1) / CHUNK_SIZE, m_ChunksW - 1);
+		for (int cj = rect.j0 / CHUNK_SIZE; cj <= cj1; ++cj)
+			for (int ci = rect.i0 / CHUNK_SIZE; ci <= ci1; ++ci)
+				dirtyChunks.push_back(ci + cj * m_ChunksW);
+	}
+	std::sort(dirtyChunks.begin(), dirtyChunks.end());
+	dirtyChunks.erase(std::unique(dirtyChunks.begin(), dirtyChunks.end()), dirtyChunks.end());
+
+	for (int chunk : dirtyChunks)
 	{
+		u8 ci = chunk % m_ChunksW;
+		u8 cj = chunk / m_ChunksW;
+
+		// Skip chunks where no navcells are dirty.
+		int i0 = ci * CHUNK_SIZE;
 		int j0 = cj * CHUNK_SIZE;
+		int i1 = std::min(i0 + CHUNK_SIZE, (int)dirtinessGrid.m_W);
 		int j1 = std::min(j0 + CHUNK_SIZE, (int)dirtinessGrid.m_H);
-		for (u8 ci = 0; ci < m_ChunksW; ++ci)
+		if (!dirtinessGrid.any_set_in_square(i0, j0, i1, j1))
+			continue;
+
+		for (const std::pair<const std::string, pass_class_t>& passClassMask : m_PassClassMasks)
 		{
-			// Skip chunks where no navcells are dirty.
-			int i0 = ci * CHUNK_SIZE;
-			int i1 = std::min(i0 + CHUNK_SIZE, (int)dirtinessGrid.m_W);
-			if (!dirtinessGrid.any_set_in_square(i0, j0, i1, j1))
-				continue;
+			pass_class_t passClass = passClassMask.second;
+			Chunk& a = m_Chunks[passClass].at(ci + cj*m_ChunksW);
 
-			for (const std::pair<const std::string, pass_class_t>& passClassMask : m_PassClassMasks)
+			// Clean up edges and global region ID
+			EdgesMap& edgeMap = m_Edges[passClass];
+			for (u16 i : a.m_RegionsID)
 			{
-				pass_class_t passClass = passClassMask.second;
-				Chunk& a = m_Chunks[passClass].at(ci + cj*m_ChunksW);
-
-				// Clean up edges and global region ID
-				EdgesMap& edgeMap = m_Edges[passClass];
-				for (u16 i : a.m_RegionsID)
+				RegionID reg{ci, cj, i};
+				m_GlobalRegions[passClass].erase(reg);
+				for (const RegionID& neighbor : edgeMap[reg])
 				{
-					RegionID reg{ci, cj, i};
-					m_GlobalRegions[passClass].erase(reg);
-					for (const RegionID& neighbor : edgeMap[reg])
-					{
-						edgeMap[neighbor].erase(reg);
-						if (edgeMap[neighbor].empty())
-							edgeMap.erase(neighbor);
-					}
-					edgeMap.erase(reg);
+					edgeMap[neighbor].erase(reg);
+					if (edgeMap[neighbor].empty())
+						edgeMap.erase(neighbor);
 				}
+				edgeMap.erase(reg);
+			}
 
-				// Recompute regions inside this chunk.
-				a.InitRegions(ci, cj, grid, passClass);
+			// Recompute regions inside this chunk.
+			a.InitRegions(ci, cj, grid, passClass);
 
-				for (u16 i : a.m_RegionsID)
-					needNewGlobalRegionMap[passClass].push_back(RegionID{ci, cj, i});
+			for (u16 i : a.m_RegionsID)
+				needNewGlobalRegionMap[passClass].push_back(RegionID{ci, cj, i});
 
-				UpdateEdges(ci, cj, passClass, edgeMap);
-			}
+			UpdateEdges(ci, cj, passClass, edgeMap);
 		}
 	}
 
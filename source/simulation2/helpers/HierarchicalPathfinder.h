@@ -1,4 +1,4 @@
-/* Copyright (C) 2021 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -28,6 +28,8 @@
 #include <map>
 #include <set>
 
+struct GridUpdateInformation;
+
 /**
  * Hierarchical pathfinder.
  *
@@ -111,7 +113,8 @@ public:
 		const std::map<std::string, pass_class_t>& nonPathfindingPassClassMasks,
 		const std::map<std::string, pass_class_t>& pathfindingPassClassMasks);
 
-	void Update(Grid<NavcellData>* grid, const Grid<u8>& dirtinessGrid);
+	// Only chunks overlapping the dirty rects of dirtinessInfos are checked for dirty navcells.
+	void Update(Grid<NavcellData>* grid, const GridUpdateInformation& dirtinessInfos);
 
 	RegionID Get(u16 i, u16 j, pass_class_t passClass) const;
 
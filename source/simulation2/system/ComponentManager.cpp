@@ -19,6 +19,7 @@
 
 #include "ComponentManager.h"
 
+#include "lib/timer.h"
 #include "lib/utf8.h"
 #include "ps/algorithm.h"
 #include "ps/CLogger.h"
@@ -61,7 +62,8 @@ public:
 CComponentManager::CComponentManager(CSimContext& context, ScriptContext& cx, bool skipScriptFunctions) :
 	m_NextScriptComponentTypeId(CID__LastNative),
 	m_ScriptInterface("Engine", "Simulation", cx),
-	m_SimContext(context), m_CurrentlyHotloading(false)
+	m_SimContext(context), m_CurrentlyHotloading(false),
+	m_MessageProfileEnabled(false), m_MessageProfileTime(0.0)
 {
 	context.SetComponentManager(this);
 
@@ -1039,6 +1041,26 @@ const CComponentManager::InterfaceListUnordered& CComponentManager::GetEntitiesW
 	return m_ComponentsByInterface[iid];
 }
 
+template<typename Dispatch>
+void CComponentManager::DeliverMessage(ComponentTypeId cid, MessageTypeId mtid, Dispatch dispatch)
+{
+	if (!m_MessageProfileEnabled)
+	{
+		dispatch();
+		return;
+	}
+
+	const double timeBefore = m_MessageProfileTime;
+	const double start = timer_Time();
+	const size_t calls = dispatch();
+	const double elapsed = timer_Time() - start;
+
+	MessageProfileEntry& entry = m_MessageProfile[std::make_pair(cid, mtid)];
+	entry.calls += static_cast<u32>(calls);
+	entry.time += elapsed - (m_MessageProfileTime - timeBefore);
+	m_MessageProfileTime = timeBefore + elapsed;
+}
+
 void CComponentManager::PostMessage(entity_id_t ent, const CMessage& msg)
 {
 	// Send the message to components of ent, that subscribed locally to this message
@@ -1057,7 +1079,10 @@ void CComponentManager::PostMessage(entity_id_t ent, const CMessage& msg)
 			// Send the message to all of them
 			std::map<entity_id_t, IComponent*>::const_iterator eit = emap->second.find(ent);
 			if (eit != emap->second.end())
-				eit->second->HandleMessage(msg, false);
+				DeliverMessage(*ctit, msg.GetType(), [&]() -> size_t {
+					eit->second->HandleMessage(msg, false);
+					return 1;
+				});
 		}
 	}
 
@@ -1080,9 +1105,12 @@ void CComponentManager::BroadcastMessage(const CMessage& msg)
 				continue;
 
 			// Send the message to all of them
-			std::map<entity_id_t, IComponent*>::const_iterator eit = emap->second.begin();
-			for (; eit != emap->second.end(); ++eit)
-				eit->second->HandleMessage(msg, false);
+			DeliverMessage(*ctit, msg.GetType(), [&]() -> size_t {
+				std::map<entity_id_t, IComponent*>::const_iterator eit = emap->second.begin();
+				for (; eit != emap->second.end(); ++eit)
+					eit->second->HandleMessage(msg, false);
+				return emap->second.size();
+			});
 		}
 	}
 
@@ -1117,9 +1145,12 @@ void CComponentManager::SendGlobalMessage(entity_id_t ent, const CMessage& msg)
 				continue;
 
 			// Send the message to all of them
-			std::map<entity_id_t, IComponent*>::const_iterator eit = emap->second.begin();
-			for (; eit != emap->second.end(); ++eit)
-				eit->second->HandleMessage(msg, true);
+			DeliverMessage(*ctit, msg.GetType(), [&]() -> size_t {
+				std::map<entity_id_t, IComponent*>::const_iterator eit = emap->second.begin();
+				for (; eit != emap->second.end(); ++eit)
+					eit->second->HandleMessage(msg, true);
+				return emap->second.size();
+			});
 		}
 	}
 
@@ -1130,10 +1161,33 @@ void CComponentManager::SendGlobalMessage(entity_id_t ent, const CMessage& msg)
 		dit->second.Flatten();
 		const std::vector<IComponent*>& dynamic = dit->second.GetComponents();
 		for (size_t i = 0; i < dynamic.size(); i++)
-			dynamic[i]->HandleMessage(msg, false);
+			DeliverMessage(dynamic[i]->GetComponentTypeId(), msg.GetType(), [&]() -> size_t {
+				dynamic[i]->HandleMessage(msg, false);
+				return 1;
+			});
 	}
 }
 
+void CComponentManager::SetMessageProfileEnabled(bool enabled)
+{
+	m_MessageProfileEnabled = enabled;
+}
+
+CComponentManager::MessageProfile CComponentManager::TakeMessageProfile()
+{
+	MessageProfile profile;
+	std::swap(profile, m_MessageProfile);
+	return profile;
+}
+
+std::string CComponentManager::LookupMessageTypeName(MessageTypeId mtid) const
+{
+	std::map<MessageTypeId, std::string>::const_iterator it = m_MessageTypeNamesById.find(mtid);
+	if (it == m_MessageTypeNamesById.end())
+		return "";
+	return it->second;
+}
+
 std::string CComponentManager::GenerateSchema() const
 {
 	std::string schema =
@@ -271,6 +271,32 @@ public:
 	 */
 	void BroadcastMessage(const CMessage& msg);
 
+	struct MessageProfileEntry
+	{
+		u32 calls = 0;
+		double time = 0.0; // seconds, excluding messages sent while handling this one
+	};
+
+	using MessageProfile = std::map<std::pair<ComponentTypeId, MessageTypeId>, MessageProfileEntry>;
+
+	/**
+	 * Enables or disables accumulating the number of HandleMessage calls and the time spent
+	 * in them for each component type and message type. (For script components, these are
+	 * the times of their On* and OnGlobal* functions.)
+	 * This costs one branch per subscribed component type when disabled.
+	 */
+	void SetMessageProfileEnabled(bool enabled);
+
+	/**
+	 * Returns the message profile accumulated since the last call, and resets it.
+	 */
+	MessageProfile TakeMessageProfile();
+
+	/**
+	 * @return The name of the given message type, or "" if not found
+	 */
+	std::string LookupMessageTypeName(MessageTypeId mtid) const;
+
 	/**
 	 * Resets the dynamic simulation state (deletes all entities, resets entity ID counters;
 	 * doesn't unload/reload component scripts).
@@ -314,6 +340,13 @@ private:
 	CMessage* ConstructMessage(int mtid, JS::HandleValue data);
 	void SendGlobalMessage(entity_id_t ent, const CMessage& msg);
 
+	/**
+	 * Calls @p dispatch, which sends a message of type @p mtid to components of type @p cid
+	 * and returns how many of them received it, and records that in the message profile.
+	 */
+	template<typename Dispatch>
+	void DeliverMessage(ComponentTypeId cid, MessageTypeId mtid, Dispatch dispatch);
+
 	void FlattenDynamicSubscriptions();
 	void RemoveComponentDynamicSubscriptions(IComponent* component);
 
@@ -358,6 +391,11 @@ private:
 
 	boost::rand48 m_RNG;
 
+	bool m_MessageProfileEnabled;
+	MessageProfile m_MessageProfile;
+	// Total time recorded by DeliverMessage, so nested messages can be excluded
+	double m_MessageProfileTime;
+
 	friend class TestComponentManager;
 };
 
@@ -1,4 +1,4 @@
-/* Copyright (C) 2024 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -247,6 +247,48 @@ public:
 		TS_ASSERT_EQUALS(static_cast<ICmpTest2*> (man.QueryInterface(ent4, IID_Test2))->GetX(), 21150);
 	}
 
+	void test_message_profile()
+	{
+		CSimContext context;
+		CComponentManager man(context, *g_ScriptContext);
+		man.LoadComponentTypes();
+
+		entity_id_t ent1 = 1, ent2 = 2, ent3 = 3;
+		CEntityHandle hnd1 = man.AllocateEntityHandle(ent1);
+		CEntityHandle hnd2 = man.AllocateEntityHandle(ent2);
+		CEntityHandle hnd3 = man.AllocateEntityHandle(ent3);
+		CParamNode noParam;
+
+		man.AddComponent(hnd1, CID_Test1A, noParam);
+		man.AddComponent(hnd2, CID_Test2A, noParam);
+		man.AddComponent(hnd3, CID_Test1A, noParam);
+		man.AddComponent(hnd3, CID_Test2A, noParam);
+
+		CMessageTurnStart msg;
+
+		// Nothing is recorded by default
+		man.BroadcastMessage(msg);
+		TS_ASSERT(man.TakeMessageProfile().empty());
+
+		man.SetMessageProfileEnabled(true);
+		man.PostMessage(ent1, msg);
+		man.BroadcastMessage(msg);
+
+		CComponentManager::MessageProfile profile = man.TakeMessageProfile();
+		TS_ASSERT_EQUALS(profile.size(), 2u);
+		TS_ASSERT_EQUALS(profile[std::make_pair(CID_Test1A, MT_TurnStart)].calls, 3u);
+		TS_ASSERT_EQUALS(profile[std::make_pair(CID_Test2A, MT_TurnStart)].calls, 2u);
+		TS_ASSERT_LESS_THAN_EQUALS(0.0, profile[std::make_pair(CID_Test1A, MT_TurnStart)].time);
+		TS_ASSERT_EQUALS(man.LookupMessageTypeName(MT_TurnStart), "TurnStart");
+
+		// Taking the profile resets it
+		TS_ASSERT(man.TakeMessageProfile().empty());
+
+		man.SetMessageProfileEnabled(false);
+		man.BroadcastMessage(msg);
+		TS_ASSERT(man.TakeMessageProfile().empty());
+	}
+
 	void test_ParamNode()
 	{
 		CSimContext context;
@@ -1,4 +1,4 @@
-/* Copyright (C) 2021 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -57,6 +57,12 @@ public:
 	virtual void PlayAsAmbient(const VfsPath& itemPath, bool looping) = 0;
 	virtual void PlayAsGroup(const VfsPath& groupPath, const CVector3D& sourcePos, entity_id_t source, bool ownedSound) = 0;
 
+	/**
+	 * Loads the sound group and starts decoding its sounds in the background,
+	 * so that playing it later doesn't have to wait for the decoder.
+	 */
+	virtual void PrefetchSoundGroup(const VfsPath& groupPath) = 0;
+
 	virtual bool InDistress() = 0;
 };
 
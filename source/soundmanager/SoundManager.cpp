@@ -33,11 +33,14 @@
 #include "ps/Threading.h"
 #include "ps/XML/Xeromyces.h"
 
+#include <algorithm>
 #include <thread>
 
 ISoundManager* g_SoundManager = NULL;
 
 #define SOURCE_NUM 64
+// Sources kept free from sound groups, for music, ambient and UI sounds.
+#define RESERVED_SOURCE_NUM 8
 
 #if CONFIG2_AUDIO
 
@@ -208,7 +211,11 @@ void ISoundManager::SetEnabled(bool doEnable)
 void ISoundManager::CloseGame()
 {
 	if (CSoundManager* aSndMgr = (CSoundManager*)g_SoundManager)
+	{
 		aSndMgr->SetAmbientItem(NULL);
+		aSndMgr->GetVoiceManager().Clear();
+		aSndMgr->GetDecodeCache().Clear();
+	}
 }
 
 void CSoundManager::al_ReportError(ALenum err, const char* caller, int line)
@@ -238,6 +245,10 @@ CSoundManager::CSoundManager(ALCdevice* device)
 	: m_Context(nullptr), m_Device(device), m_ALSourceBuffer(nullptr),
 	m_CurrentTune(nullptr), m_CurrentEnvirons(nullptr),
 	m_Worker(nullptr), m_DistressMutex(), m_PlayListItems(nullptr), m_SoundGroups(),
+	m_VoiceManager{
+		static_cast<size_t>(std::max(1, g_ConfigDB.Get("sound.voices.pergroup", 4))),
+		g_ConfigDB.Get("sound.voices.window", 1.0),
+		g_ConfigDB.Get("sound.voices.maxmergedgain", 2.f)},
 	m_Gain{g_ConfigDB.Get("sound.mastergain", 0.5f)},
 	m_MusicGain{g_ConfigDB.Get("sound.musicgain", 0.5f)},
 	m_AmbientGain{g_ConfigDB.Get("sound.ambientgain", 0.5f)},
@@ -251,6 +262,10 @@ CSoundManager::CSoundManager(ALCdevice* device)
 {
 	AlcInit();
 
+	const int decodeCacheSize = std::max(0, g_ConfigDB.Get("sound.decodecachesize", 64));
+	m_DecodeCache = std::make_unique<CSoundDecodeCache>(
+		static_cast<size_t>(decodeCacheSize) * MiB, m_BufferSize, m_BufferCount);
+
 	if (m_Enabled)
 	{
 		SetMasterGain(m_Gain);
@@ -287,6 +302,8 @@ CSoundManager::~CSoundManager()
 		delete p.second;
 	m_SoundGroups.clear();
 
+	m_DecodeCache.reset();
+
 	if (m_PlayListItems)
 		delete m_PlayListItems;
 
@@ -419,6 +436,15 @@ ALuint CSoundManager::GetALSource(ISoundItem* anItem)
 	return 0;
 }
 
+size_t CSoundManager::GetFreeALSourceCount() const
+{
+	size_t count = 0;
+	for (int x = 0; x < SOURCE_NUM; x++)
+		if (!m_ALSourceBuffer[x].SourceItem)
+			++count;
+	return count;
+}
+
 void CSoundManager::ReleaseALSource(ALuint theSource)
 {
 	for (int x = 0; x < SOURCE_NUM; x++)
@@ -596,6 +622,10 @@ void CSoundManager::IdleTask()
 		if (m_CurrentEnvirons)
 			m_CurrentEnvirons->EnsurePlay();
 
+		PlayQueuedVoices();
+
+		m_DecodeCache->CollectFinished();
+
 		if (m_Worker)
 			m_Worker->CleanupItems();
 	}
@@ -648,7 +678,7 @@ void CSoundManager::SetMusicEnabled(bool isEnabled)
 	m_MusicEnabled = isEnabled;
 }
 
-void CSoundManager::PlayAsGroup(const VfsPath& groupPath, const CVector3D& sourcePos, entity_id_t source, bool ownedSound)
+CSoundGroup* CSoundManager::GetSoundGroup(const VfsPath& groupPath)
 {
 	// Make sure the sound group is loaded
 	CSoundGroup* group;
@@ -668,12 +698,48 @@ void CSoundManager::PlayAsGroup(const VfsPath& groupPath, const CVector3D& sourc
 	{
 		group = m_SoundGroups[groupPath.string()];
 	}
+	return group;
+}
+
+void CSoundManager::PlayAsGroup(const VfsPath& groupPath, const CVector3D& sourcePos, entity_id_t source, bool ownedSound)
+{
+	CSoundGroup* group = GetSoundGroup(groupPath);
 
 	// Failed to load group -> do nothing
 	if (group && (ownedSound || !group->TestFlag(eOwnerOnly)))
 		group->PlayNext(sourcePos, source);
 }
 
+void CSoundManager::QueueGroupVoice(const CSoundVoiceManager::Request& request)
+{
+	if (m_Enabled && m_ActionGain > 0)
+		m_VoiceManager.Queue(request);
+}
+
+void CSoundManager::PlayQueuedVoices()
+{
+	if (m_VoiceManager.GetQueuedCount() == 0)
+		return;
+
+	PROFILE2("play sound voices");
+	const size_t freeSources = GetFreeALSourceCount();
+	const size_t budget = freeSources > RESERVED_SOURCE_NUM ? freeSources - RESERVED_SOURCE_NUM : 0;
+	const std::vector<CSoundVoiceManager::Voice> voices = m_VoiceManager.Resolve(timer_Time(), budget);
+	PROFILE2_ATTR("voices: %zu", voices.size());
+	for (const CSoundVoiceManager::Voice& voice : voices)
+		voice.request.group->UploadPropertiesAndPlay(
+			voice.request.soundIndex, voice.request.position, voice.request.source, voice.gain);
+}
+
+void CSoundManager::PrefetchSoundGroup(const VfsPath& groupPath)
+{
+	if (!m_Enabled)
+		return;
+
+	if (CSoundGroup* group = GetSoundGroup(groupPath))
+		group->Prefetch(*m_DecodeCache);
+}
+
 void CSoundManager::PlayAsMusic(const VfsPath& itemPath, bool looping)
 {
 	if (m_Enabled)
@@ -1,4 +1,4 @@
-/* Copyright (C) 2021 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -23,7 +23,9 @@
 #if CONFIG2_AUDIO
 
 #include "ISoundManager.h"
+#include "SoundVoiceManager.h"
 #include "data/SoundData.h"
+#include "data/SoundDecodeCache.h"
 #include "items/ISoundItem.h"
 #include "scripting/SoundGroup.h"
 
@@ -34,6 +36,7 @@
 #include "simulation2/system/Entity.h"
 
 #include <map>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -69,6 +72,8 @@ protected:
 	std::mutex m_DistressMutex;
 	PlayList* m_PlayListItems;
 	SoundGroupMap m_SoundGroups;
+	CSoundVoiceManager m_VoiceManager;
+	std::unique_ptr<CSoundDecodeCache> m_DecodeCache;
 
 	float m_Gain;
 	float m_MusicGain;
@@ -139,12 +144,17 @@ public:
 	CStr8 GetSoundCardNames() const;
 	CStr8 GetOpenALVersion() const;
 
+	CSoundDecodeCache& GetDecodeCache() { return *m_DecodeCache; }
+	CSoundVoiceManager& GetVoiceManager() { return m_VoiceManager; }
+
 	void PlayAsMusic(const VfsPath& itemPath, bool looping);
 	void PlayAsAmbient(const VfsPath& itemPath, bool looping);
 	void PlayAsUI(const VfsPath& itemPath, bool looping);
 	void PlayAsGroup(const VfsPath& groupPath, const CVector3D& sourcePos, entity_id_t source, bool ownedSound);
+	void PrefetchSoundGroup(const VfsPath& groupPath);
 
 	void PlayGroupItem(ISoundItem* anItem, ALfloat groupGain);
+	void QueueGroupVoice(const CSoundVoiceManager::Request& request);
 
 	bool InDistress();
 	void SetDistressThroughShortage();
@@ -169,6 +179,9 @@ protected:
 	void InitListener();
 	Status AlcInit();
 	void SetMusicItem(ISoundItem* anItem);
+	CSoundGroup* GetSoundGroup(const VfsPath& groupPath);
+	void PlayQueuedVoices();
+	size_t GetFreeALSourceCount() const;
 
 private:
 	CSoundManager(CSoundManager* UNUSED(other)){};
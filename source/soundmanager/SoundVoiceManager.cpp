@@ -0,0 +1,124 @@
+/* Copyright (C) 2025 Wildfire Games.
+ * This file is part of 0 A.D.
+ *
+ * 0 A.D. is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * 0 A.D. is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 0 A.D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "precompiled.h"
+
+#include "SoundVoiceManager.h"
+
+#include <algorithm>
+#include <cmath>
+
+CSoundVoiceManager::CSoundVoiceManager(size_t maxVoicesPerGroup, double window, float maxMergedGain)
+	: m_MaxVoicesPerGroup(maxVoicesPerGroup), m_Window(window), m_MaxMergedGain(std::max(1.f, maxMergedGain))
+{
+}
+
+void CSoundVoiceManager::Queue(const Request& request)
+{
+	m_Queue.push_back(request);
+}
+
+std::vector<CSoundVoiceManager::Voice> CSoundVoiceManager::Resolve(double time, size_t budget)
+{
+	ForgetOldVoices(time);
+
+	// Merge the requests of each group, keeping the most audible one. Sounds
+	// of a group are variations of the same sound, so playing them at the
+	// same time only makes them louder. Uncorrelated sounds add up in power.
+	struct Candidate
+	{
+		Voice voice;
+		float power;
+		float score;
+	};
+	std::vector<Candidate> candidates;
+	std::unordered_map<const CSoundGroup*, size_t> candidateIndices;
+	for (const Request& request : m_Queue)
+	{
+		std::unordered_map<const CSoundGroup*, size_t>::iterator it = candidateIndices.find(request.group);
+		if (it == candidateIndices.end())
+		{
+			candidateIndices.emplace(request.group, candidates.size());
+			candidates.push_back({{request, 1, 1.f}, request.audibility * request.audibility, 0.f});
+			continue;
+		}
+		Candidate& candidate = candidates[it->second];
+		++candidate.voice.mergedCount;
+		candidate.power += request.audibility * request.audibility;
+		if (request.audibility > candidate.voice.request.audibility)
+			candidate.voice.request = request;
+	}
+	m_Queue.clear();
+
+	for (Candidate& candidate : candidates)
+	{
+		const float audibility = candidate.voice.request.audibility;
+		if (audibility > 0.f)
+			candidate.voice.gain = std::min(m_MaxMergedGain, std::sqrt(candidate.power) / audibility);
+
+		// Groups which played recently are less interesting than new ones.
+		const size_t recentVoices = GetRecentVoiceCount(candidate.voice.request.group);
+		candidate.score = candidate.voice.request.priority * audibility * candidate.voice.gain / (1 + recentVoices);
+	}
+
+	std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b)
+	{
+		return a.score > b.score;
+	});
+
+	std::vector<Voice> voices;
+	for (const Candidate& candidate : candidates)
+	{
+		if (voices.size() >= budget)
+			break;
+		if (candidate.voice.request.audibility <= 0.f)
+			continue;
+
+		std::deque<double>& history = m_History[candidate.voice.request.group];
+		if (history.size() >= m_MaxVoicesPerGroup)
+			continue;
+		history.push_back(time);
+		voices.push_back(candidate.voice);
+	}
+	return voices;
+}
+
+void CSoundVoiceManager::Clear()
+{
+	m_Queue.clear();
+	m_History.clear();
+}
+
+size_t CSoundVoiceManager::GetRecentVoiceCount(const CSoundGroup* group) const
+{
+	std::unordered_map<const CSoundGroup*, std::deque<double>>::const_iterator it = m_History.find(group);
+	return it == m_History.end() ? 0 : it->second.size();
+}
+
+void CSoundVoiceManager::ForgetOldVoices(double time)
+{
+	for (std::unordered_map<const CSoundGroup*, std::deque<double>>::iterator it = m_History.begin(); it != m_History.end();)
+	{
+		std::deque<double>& history = it->second;
+		while (!history.empty() && history.front() <= time - m_Window)
+			history.pop_front();
+		if (history.empty())
+			it = m_History.erase(it);
+		else
+			++it;
+	}
+}
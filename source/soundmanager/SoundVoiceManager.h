@@ -0,0 +1,98 @@
+/* Copyright (C) 2025 Wildfire Games.
+ * This file is part of 0 A.D.
+ *
+ * 0 A.D. is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * 0 A.D. is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 0 A.D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDED_SOUNDVOICEMANAGER_H
+#define INCLUDED_SOUNDVOICEMANAGER_H
+
+#include "maths/Vector3D.h"
+#include "simulation2/system/Entity.h"
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+class CSoundGroup;
+
+/**
+ * Decides which of the sound group plays requested during a frame get a
+ * voice (an OpenAL source). Concurrent requests of the same group are merged
+ * into a single louder voice, the most audible requests of the highest
+ * priority groups win when there are more requests than free sources, and
+ * each group can only start a limited number of voices per time window.
+ */
+class CSoundVoiceManager
+{
+public:
+	struct Request
+	{
+		CSoundGroup* group;
+		size_t soundIndex;
+		CVector3D position;
+		entity_id_t source;
+		// How loud the sound is at the listener, between 0 and 1.
+		float audibility;
+		float priority;
+	};
+
+	struct Voice
+	{
+		// The most audible of the merged requests.
+		Request request;
+		size_t mergedCount;
+		// Gain multiplier accounting for the merged requests, at least 1.
+		float gain;
+	};
+
+	/**
+	 * @param maxVoicesPerGroup how many voices a group can start per window.
+	 * @param window length of the window in seconds.
+	 * @param maxMergedGain upper bound of the gain of merged requests.
+	 */
+	CSoundVoiceManager(size_t maxVoicesPerGroup, double window, float maxMergedGain);
+
+	void Queue(const Request& request);
+
+	/**
+	 * Merges and scores the queued requests and clears the queue.
+	 * @param time current time in seconds.
+	 * @param budget the maximum number of voices to start.
+	 * @return the voices to start, best first.
+	 */
+	std::vector<Voice> Resolve(double time, size_t budget);
+
+	void Clear();
+
+	size_t GetQueuedCount() const { return m_Queue.size(); }
+
+	/**
+	 * @return the number of voices the group started in the current window.
+	 */
+	size_t GetRecentVoiceCount(const CSoundGroup* group) const;
+
+private:
+	void ForgetOldVoices(double time);
+
+	const size_t m_MaxVoicesPerGroup;
+	const double m_Window;
+	const float m_MaxMergedGain;
+
+	std::vector<Request> m_Queue;
+	// Start times of the voices of each group in the current window.
+	std::unordered_map<const CSoundGroup*, std::deque<double>> m_History;
+};
+
+#endif // INCLUDED_SOUNDVOICEMANAGER_H
@@ -1,4 +1,4 @@
-/* Copyright (C) 2015 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -62,6 +62,10 @@ bool COggData::InitOggFile(const VfsPath& itemPath)
 	if (!sndManager)
 		return false;
 
+	// Sounds prefetched with their group are already decoded.
+	if (DecodedSoundPtr decoded = sndManager->GetDecodeCache().Get(itemPath))
+		return InitFromDecoded(itemPath, *decoded);
+
 	int buffersToStart = sndManager->GetBufferCount();
 	if (OpenOggNonstream(g_VFS, itemPath, ogg) != INFO::OK)
 		return false;
@@ -96,6 +100,34 @@ bool COggData::InitOggFile(const VfsPath& itemPath)
 	return true;
 }
 
+bool COggData::InitFromDecoded(const VfsPath& itemPath, const CDecodedSound& sound)
+{
+	SetFormatAndFreq(sound.format, sound.frequency);
+	SetFileName(itemPath);
+	m_FileFinished = true;
+	m_OneShot = true;
+
+	const ALsizei buffersToStart = static_cast<ALsizei>(sound.chunks.size());
+
+	AL_CHECK;
+
+	alGenBuffers(buffersToStart, m_Buffer);
+
+	ALenum err = alGetError();
+	if (err != AL_NO_ERROR)
+	{
+		LOGERROR("Failed to create initial buffer. OpenAL error: %s\n", alGetString(err));
+		return false;
+	}
+
+	for (ALsizei i = 0; i < buffersToStart; ++i)
+		alBufferData(m_Buffer[i], m_Format, sound.chunks[i].data(), static_cast<ALsizei>(sound.chunks[i].size()), static_cast<ALsizei>(m_Frequency));
+	m_BuffersUsed = buffersToStart;
+	AL_CHECK;
+
+	return true;
+}
+
 ALsizei COggData::GetBufferCount()
 {
 	return m_BuffersUsed;
@@ -1,4 +1,4 @@
-/* Copyright (C) 2015 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -24,6 +24,7 @@
 
 #include "ogg.h"
 #include "SoundData.h"
+#include "SoundDecodeCache.h"
 
 #include "lib/external_libraries/openal.h"
 #include "lib/file/vfs/vfs_path.h"
@@ -53,6 +54,7 @@ protected:
 	int m_BuffersUsed;
 
 	bool AddDataBuffer(char* data, long length);
+	bool InitFromDecoded(const VfsPath& itemPath, const CDecodedSound& sound);
 	void SetFormatAndFreq(int form, ALsizei freq);
 	int  GetBufferCount();
 	unsigned int GetBuffer();
@@ -0,0 +1,173 @@
+/* Copyright (C) 2025 Wildfire Games.
+ * This file is part of 0 A.D.
+ *
+ * 0 A.D. is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * 0 A.D. is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 0 A.D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "precompiled.h"
+
+#include "SoundDecodeCache.h"
+
+#if CONFIG2_AUDIO
+
+#include "ogg.h"
+#include "ps/CLogger.h"
+#include "ps/Filesystem.h"
+#include "ps/Profiler2.h"
+#include "ps/TaskManager.h"
+
+size_t CDecodedSound::GetSize() const
+{
+	size_t size = 0;
+	for (const std::vector<u8>& chunk : chunks)
+		size += chunk.size();
+	return size;
+}
+
+CSoundDecodeCache::CSoundDecodeCache(size_t capacity, size_t bufferSize, size_t bufferCount)
+	: m_Capacity(capacity), m_BufferSize(bufferSize), m_BufferCount(bufferCount)
+{
+}
+
+CSoundDecodeCache::~CSoundDecodeCache()
+{
+	Clear();
+}
+
+void CSoundDecodeCache::Prefetch(const VfsPath& path)
+{
+	CollectFinished();
+
+	Entry& entry = m_Entries[path];
+	if (entry.decoded || entry.pending.Valid())
+		return;
+
+	entry.pending = g_TaskManager.PushTask([path, bufferSize = m_BufferSize, bufferCount = m_BufferCount]()
+	{
+		return Decode(path, bufferSize, bufferCount);
+	}, Threading::TaskPriority::LOW);
+	++m_PendingCount;
+}
+
+DecodedSoundPtr CSoundDecodeCache::Get(const VfsPath& path)
+{
+	std::unordered_map<VfsPath, Entry>::iterator it = m_Entries.find(path);
+	if (it == m_Entries.end())
+		return nullptr;
+
+	Entry& entry = it->second;
+	if (!entry.decoded)
+	{
+		PROFILE2("wait for sound decode");
+		Finish(path, entry);
+	}
+	else if (entry.sound)
+		m_LRU.splice(m_LRU.begin(), m_LRU, entry.lruPosition);
+
+	// Keep a reference, the entry might be evicted right away.
+	DecodedSoundPtr sound = entry.sound;
+	EvictOverCapacity();
+	return sound;
+}
+
+void CSoundDecodeCache::CollectFinished()
+{
+	if (m_PendingCount == 0)
+		return;
+
+	for (std::pair<const VfsPath, Entry>& entry : m_Entries)
+		if (!entry.second.decoded && entry.second.pending.IsDone())
+			Finish(entry.first, entry.second);
+
+	EvictOverCapacity();
+}
+
+void CSoundDecodeCache::Clear()
+{
+	// Cancel decodes which didn't start yet.
+	for (std::pair<const VfsPath, Entry>& entry : m_Entries)
+		entry.second.pending.CancelOrWait();
+	m_Entries.clear();
+	m_LRU.clear();
+	m_MemoryUsage = 0;
+	m_PendingCount = 0;
+}
+
+void CSoundDecodeCache::Finish(const VfsPath& path, Entry& entry)
+{
+	entry.sound = entry.pending.Get();
+	entry.decoded = true;
+	--m_PendingCount;
+	if (!entry.sound)
+		return;
+
+	m_MemoryUsage += entry.sound->GetSize();
+	m_LRU.push_front(path);
+	entry.lruPosition = m_LRU.begin();
+}
+
+void CSoundDecodeCache::EvictOverCapacity()
+{
+	while (m_MemoryUsage > m_Capacity && !m_LRU.empty())
+	{
+		std::unordered_map<VfsPath, Entry>::iterator it = m_Entries.find(m_LRU.back());
+		ENSURE(it != m_Entries.end());
+		m_MemoryUsage -= it->second.sound->GetSize();
+		m_Entries.erase(it);
+		m_LRU.pop_back();
+	}
+}
+
+DecodedSoundPtr CSoundDecodeCache::Decode(const VfsPath& path, size_t bufferSize, size_t bufferCount)
+{
+	PROFILE2("decode sound");
+	PROFILE2_ATTR("file: %s", path.string8().c_str());
+
+	OggStreamPtr ogg;
+	if (OpenOggNonstream(g_VFS, path, ogg) != INFO::OK)
+	{
+		LOGERROR("Failed to open sound '%s'", path.string8());
+		return nullptr;
+	}
+
+	std::shared_ptr<CDecodedSound> sound = std::make_shared<CDecodedSound>();
+	sound->format = ogg->Format();
+	sound->frequency = ogg->SamplingRate();
+
+	for (size_t i = 0; i < bufferCount && !ogg->atFileEOF(); ++i)
+	{
+		std::vector<u8> chunk(bufferSize);
+		const Status ret = ogg->GetNextChunk(chunk.data(), chunk.size());
+		if (ret < 0)
+		{
+			ogg->Close();
+			return nullptr;
+		}
+		if (ret == 0)
+			continue;
+		chunk.resize(static_cast<size_t>(ret));
+		sound->chunks.emplace_back(std::move(chunk));
+	}
+
+	const bool finished = ogg->atFileEOF();
+	ogg->Close();
+
+	// Too long to be a one shot, it will be streamed instead.
+	if (!finished)
+		return nullptr;
+
+	return sound;
+}
+
+#endif // CONFIG2_AUDIO
@@ -0,0 +1,125 @@
+/* Copyright (C) 2025 Wildfire Games.
+ * This file is part of 0 A.D.
+ *
+ * 0 A.D. is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * 0 A.D. is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 0 A.D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDED_SOUNDDECODECACHE_H
+#define INCLUDED_SOUNDDECODECACHE_H
+
+#include "lib/config2.h"
+
+#if CONFIG2_AUDIO
+
+#include "lib/external_libraries/openal.h"
+#include "lib/file/vfs/vfs_path.h"
+#include "ps/Future.h"
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * PCM samples of a fully decoded sound, split into chunks of at most the
+ * sound manager buffer size so they map one to one on OpenAL buffers.
+ */
+struct CDecodedSound
+{
+	ALenum format = 0;
+	ALsizei frequency = 0;
+	std::vector<std::vector<u8>> chunks;
+
+	size_t GetSize() const;
+};
+
+using DecodedSoundPtr = std::shared_ptr<const CDecodedSound>;
+
+/**
+ * Bounded LRU cache of decoded short sounds, keyed by their VFS path.
+ * Decoding runs on the task manager, so prefetching a file doesn't block
+ * the caller. Files that don't fit in the given number of buffers are
+ * streamed and never cached.
+ *
+ * Not thread-safe: it's only used from the main thread, only the decoding
+ * itself runs on worker threads.
+ */
+class CSoundDecodeCache
+{
+	NONCOPYABLE(CSoundDecodeCache);
+public:
+	/**
+	 * @param capacity the maximum size in bytes of the decoded samples kept.
+	 * @param bufferSize the size of a single chunk.
+	 * @param bufferCount the maximum number of chunks of a cached sound.
+	 */
+	CSoundDecodeCache(size_t capacity, size_t bufferSize, size_t bufferCount);
+	~CSoundDecodeCache();
+
+	/**
+	 * Starts decoding the file in the background, unless it's already
+	 * cached or being decoded.
+	 */
+	void Prefetch(const VfsPath& path);
+
+	/**
+	 * Returns the decoded sound if it was prefetched, waiting for it to be
+	 * decoded if needed. Returns null if the file wasn't prefetched, was
+	 * evicted, or is too long to be cached.
+	 */
+	DecodedSoundPtr Get(const VfsPath& path);
+
+	/**
+	 * Moves finished decodes into the cache and evicts the least recently
+	 * used sounds over the capacity.
+	 */
+	void CollectFinished();
+
+	void Clear();
+
+	size_t GetMemoryUsage() const { return m_MemoryUsage; }
+
+	/**
+	 * Decodes the whole file synchronously.
+	 * @return null if the file couldn't be read or needs more than
+	 * @p bufferCount chunks.
+	 */
+	static DecodedSoundPtr Decode(const VfsPath& path, size_t bufferSize, size_t bufferCount);
+
+private:
+	struct Entry
+	{
+		Future<DecodedSoundPtr> pending;
+		DecodedSoundPtr sound;
+		bool decoded = false;
+		std::list<VfsPath>::iterator lruPosition;
+	};
+
+	void Finish(const VfsPath& path, Entry& entry);
+	void EvictOverCapacity();
+
+	const size_t m_Capacity;
+	const size_t m_BufferSize;
+	const size_t m_BufferCount;
+	size_t m_MemoryUsage = 0;
+	size_t m_PendingCount = 0;
+
+	std::unordered_map<VfsPath, Entry> m_Entries;
+	// Decoded entries, most recently used first.
+	std::list<VfsPath> m_LRU;
+};
+
+#endif // CONFIG2_AUDIO
+
+#endif // INCLUDED_SOUNDDECODECACHE_H
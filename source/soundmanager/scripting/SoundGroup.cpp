@@ -21,6 +21,7 @@
 #include "graphics/Camera.h"
 #include "graphics/GameView.h"
 #include "lib/rand.h"
+#include "maths/MathUtil.h"
 #include "ps/CLogger.h"
 #include "ps/ConfigDB.h"
 #include "ps/CStr.h"
@@ -180,12 +181,13 @@ float CSoundGroup::RadiansOffCenter(const CVector3D& position, bool& onScreen, f
 #endif // !CONFIG2_AUDIO
 }
 
-void CSoundGroup::UploadPropertiesAndPlay(size_t index, const CVector3D& position, entity_id_t source)
+void CSoundGroup::UploadPropertiesAndPlay(size_t index, const CVector3D& position, entity_id_t source, float gainScale)
 {
 #if !CONFIG2_AUDIO
 	UNUSED2(index);
 	UNUSED2(position);
 	UNUSED2(source);
+	UNUSED2(gainScale);
 #else
 	if (!g_SoundManager)
 		return;
@@ -236,7 +238,7 @@ void CSoundGroup::UploadPropertiesAndPlay(size_t index, const CVector3D& positio
 		m_Gain = CFastRand::RandFloat(m_Seed, m_GainLower, m_GainUpper);
 
 	hSound->SetCone(m_ConeInnerAngle, m_ConeOuterAngle, m_ConeOuterGain);
-	static_cast<CSoundManager*>(g_SoundManager)->PlayGroupItem(hSound, m_Gain);
+	static_cast<CSoundManager*>(g_SoundManager)->PlayGroupItem(hSound, std::min(m_Gain * gainScale, std::max(m_Gain, 1.f)));
 #endif // !CONFIG2_AUDIO
 }
 
@@ -255,7 +257,33 @@ void CSoundGroup::PlayNext(const CVector3D& position, entity_id_t source)
 		return;
 
 	m_CurrentSoundIndex = rand(0, m_Filenames.size());
-	UploadPropertiesAndPlay(m_CurrentSoundIndex, position, source);
+
+#if !CONFIG2_AUDIO
+	UNUSED2(position);
+	UNUSED2(source);
+#else
+	if (!g_SoundManager)
+		return;
+
+	bool isOnscreen = false;
+	ALfloat itemRollOff = DEFAULT_ROLLOFF;
+	RadiansOffCenter(position, isOnscreen, itemRollOff);
+	if (!isOnscreen && !TestFlag(eDistanceless) && !TestFlag(eOmnipresent))
+		return;
+
+	// Approximate the linear distance model, so far away sounds lose when
+	// there are not enough voices.
+	float audibility = 1.f;
+	if (!TestFlag(eOmnipresent) && !TestFlag(eDistanceless) && m_MaxDist > m_MinDist)
+	{
+		const CVector3D origin = g_Game->GetView()->GetCamera()->GetOrientation().GetTranslation();
+		const float distance = (position - origin).Length();
+		audibility = 1.f - Clamp((distance - m_MinDist) / (m_MaxDist - m_MinDist), 0.f, 1.f);
+	}
+
+	static_cast<CSoundManager*>(g_SoundManager)->QueueGroupVoice(
+		{this, m_CurrentSoundIndex, position, source, audibility, m_Priority});
+#endif // !CONFIG2_AUDIO
 }
 
 void CSoundGroup::Reload()
@@ -282,6 +310,20 @@ void CSoundGroup::Reload()
 #endif
 }
 
+void CSoundGroup::Prefetch(CSoundDecodeCache& decodeCache)
+{
+#if CONFIG2_AUDIO
+	// Sounds already loaded don't need to be decoded again.
+	if (!m_SoundGroups.empty())
+		return;
+
+	for (const std::wstring& filename : m_Filenames)
+		decodeCache.Prefetch(m_Filepath / filename);
+#else
+	UNUSED2(decodeCache);
+#endif
+}
+
 void CSoundGroup::ReleaseGroup()
 {
 #if CONFIG2_AUDIO
@@ -1,4 +1,4 @@
-/* Copyright (C) 2021 Wildfire Games.
+/* Copyright (C) 2025 Wildfire Games.
  * This file is part of 0 A.D.
  *
  * 0 A.D. is free software: you can redistribute it and/or modify
@@ -26,6 +26,7 @@
 
 #include <vector>
 
+class CSoundDecodeCache;
 class CVector3D;
 
 enum eSndGrpFlags
@@ -49,11 +50,16 @@ public:
 	CSoundGroup();
 	~CSoundGroup();
 
-	// Play next sound in group
+	// Request to play the next sound in group, the sound manager decides
+	// which requests of the frame are actually played
 	// @param position world position of the entity generating the sound
 	// (ignored if the eOmnipresent flag is set)
 	void PlayNext(const CVector3D& position, entity_id_t source);
 
+	// Play a sound of the group
+	// @param gainScale multiplier of the group gain, for merged requests
+	void UploadPropertiesAndPlay(size_t theIndex, const CVector3D& position, entity_id_t source, float gainScale);
+
 	float RadiansOffCenter(const CVector3D& position, bool& onScreen, float& itemRollOff);
 
 	// Load a group
@@ -61,6 +67,9 @@ public:
 
 	void Reload();
 
+	// Start decoding all sounds of the group in the background
+	void Prefetch(CSoundDecodeCache& decodeCache);
+
 	// Release all remaining loaded handles
 	void ReleaseGroup();
 
@@ -76,8 +85,6 @@ public:
 private:
 	void SetGain(float gain);
 
-	void UploadPropertiesAndPlay(size_t theIndex, const CVector3D& position, entity_id_t source);
-
 	void SetDefaultValues();
 #if CONFIG2_AUDIO
 	// We store the handles so we can load now and play later
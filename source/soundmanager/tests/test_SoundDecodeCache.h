@@ -0,0 +1,185 @@
+/* Copyright (C) 2025 Wildfire Games.
+ * This file is part of 0 A.D.
+ *
+ * 0 A.D. is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * 0 A.D. is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 0 A.D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lib/self_test.h"
+
+#include "lib/config2.h"
+#include "lib/file/vfs/vfs.h"
+#include "ps/CLogger.h"
+#include "ps/Filesystem.h"
+#include "soundmanager/data/SoundDecodeCache.h"
+
+#if CONFIG2_AUDIO
+#include <AL/alext.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+const VfsPath SOUND_A = L"audio/interface/ui/chat_alert.ogg";
+const VfsPath SOUND_B = L"audio/interface/ui/gamesetup_join.ogg";
+constexpr size_t BUFFER_SIZE = 98304;
+constexpr size_t BUFFER_COUNT = 50;
+}
+
+class TestSoundDecodeCache : public CxxTest::TestSuite
+{
+public:
+	void setUp()
+	{
+		g_VFS = CreateVfs();
+		TS_ASSERT_OK(g_VFS->Mount(L"", DataDir() / "mods" / "public" / "", VFS_MOUNT_MUST_EXIST));
+	}
+
+	void tearDown()
+	{
+		g_VFS.reset();
+	}
+
+	void test_decode()
+	{
+#if CONFIG2_AUDIO
+		const DecodedSoundPtr sound = CSoundDecodeCache::Decode(SOUND_A, BUFFER_SIZE, BUFFER_COUNT);
+		TS_ASSERT(sound);
+		TS_ASSERT(!sound->chunks.empty());
+		TS_ASSERT(sound->format == AL_FORMAT_MONO16 || sound->format == AL_FORMAT_STEREO16);
+		TS_ASSERT_LESS_THAN(0, sound->frequency);
+		for (const std::vector<u8>& chunk : sound->chunks)
+			TS_ASSERT_LESS_THAN_EQUALS(chunk.size(), BUFFER_SIZE);
+
+		// Sounds that don't fit in the buffers are streamed, not cached.
+		TS_ASSERT(!CSoundDecodeCache::Decode(SOUND_A, 1024, 1));
+
+		TestLogger logger;
+		TS_ASSERT(!CSoundDecodeCache::Decode(L"audio/missing.ogg", BUFFER_SIZE, BUFFER_COUNT));
+		TS_ASSERT_STR_CONTAINS(logger.GetOutput(), "Failed to open sound");
+#endif
+	}
+
+	void test_cache()
+	{
+#if CONFIG2_AUDIO
+		const size_t sizeA = CSoundDecodeCache::Decode(SOUND_A, BUFFER_SIZE, BUFFER_COUNT)->GetSize();
+		const size_t sizeB = CSoundDecodeCache::Decode(SOUND_B, BUFFER_SIZE, BUFFER_COUNT)->GetSize();
+
+		CSoundDecodeCache cache(sizeA + sizeB, BUFFER_SIZE, BUFFER_COUNT);
+		TS_ASSERT(!cache.Get(SOUND_A));
+
+		cache.Prefetch(SOUND_A);
+		cache.Prefetch(SOUND_B);
+		const DecodedSoundPtr a = cache.Get(SOUND_A);
+		TS_ASSERT(a);
+		TS_ASSERT_EQUALS(a, cache.Get(SOUND_A));
+		TS_ASSERT(cache.Get(SOUND_B));
+		TS_ASSERT_EQUALS(cache.GetMemoryUsage(), sizeA + sizeB);
+
+		cache.Clear();
+		TS_ASSERT_EQUALS(cache.GetMemoryUsage(), 0u);
+		TS_ASSERT(!cache.Get(SOUND_A));
+#endif
+	}
+
+	void test_evict()
+	{
+#if CONFIG2_AUDIO
+		const size_t sizeA = CSoundDecodeCache::Decode(SOUND_A, BUFFER_SIZE, BUFFER_COUNT)->GetSize();
+		const size_t sizeB = CSoundDecodeCache::Decode(SOUND_B, BUFFER_SIZE, BUFFER_COUNT)->GetSize();
+
+		// Only one of them fits, the least recently used one is evicted.
+		CSoundDecodeCache cache(std::max(sizeA, sizeB), BUFFER_SIZE, BUFFER_COUNT);
+		cache.Prefetch(SOUND_A);
+		TS_ASSERT(cache.Get(SOUND_A));
+		cache.Prefetch(SOUND_B);
+		TS_ASSERT(cache.Get(SOUND_B));
+		TS_ASSERT_EQUALS(cache.GetMemoryUsage(), sizeB);
+		TS_ASSERT(!cache.Get(SOUND_A));
+#endif
+	}
+
+	/**
+	 * Uploads cached samples to OpenAL buffers like COggData does, on an
+	 * OpenAL Soft loopback device so no audio hardware is needed.
+	 */
+	void test_upload_loopback()
+	{
+#if CONFIG2_AUDIO
+		if (!alcIsExtensionPresent(nullptr, "ALC_SOFT_loopback"))
+		{
+			debug_printf("Skipping sound upload test (ALC_SOFT_loopback isn't supported)\n");
+			return;
+		}
+		const LPALCLOOPBACKOPENDEVICESOFT alcLoopbackOpenDeviceSOFT =
+			reinterpret_cast<LPALCLOOPBACKOPENDEVICESOFT>(alcGetProcAddress(nullptr, "alcLoopbackOpenDeviceSOFT"));
+		const LPALCRENDERSAMPLESSOFT alcRenderSamplesSOFT =
+			reinterpret_cast<LPALCRENDERSAMPLESSOFT>(alcGetProcAddress(nullptr, "alcRenderSamplesSOFT"));
+		TS_ASSERT(alcLoopbackOpenDeviceSOFT && alcRenderSamplesSOFT);
+		if (!alcLoopbackOpenDeviceSOFT || !alcRenderSamplesSOFT)
+			return;
+
+		ALCdevice* device = alcLoopbackOpenDeviceSOFT(nullptr);
+		TS_ASSERT(device);
+		if (!device)
+			return;
+		const ALCint attributes[] = {
+			ALC_FORMAT_CHANNELS_SOFT, ALC_STEREO_SOFT,
+			ALC_FORMAT_TYPE_SOFT, ALC_SHORT_SOFT,
+			ALC_FREQUENCY, 44100,
+			0
+		};
+		ALCcontext* context = alcCreateContext(device, attributes);
+		TS_ASSERT(context);
+		TS_ASSERT(alcMakeContextCurrent(context));
+
+		CSoundDecodeCache cache(64 * MiB, BUFFER_SIZE, BUFFER_COUNT);
+		cache.Prefetch(SOUND_A);
+		const DecodedSoundPtr sound = cache.Get(SOUND_A);
+		TS_ASSERT(sound);
+
+		std::vector<ALuint> buffers(sound->chunks.size());
+		alGenBuffers(static_cast<ALsizei>(buffers.size()), buffers.data());
+		for (size_t i = 0; i < buffers.size(); ++i)
+		{
+			alBufferData(buffers[i], sound->format, sound->chunks[i].data(),
+				static_cast<ALsizei>(sound->chunks[i].size()), sound->frequency);
+			ALint size = 0;
+			alGetBufferi(buffers[i], AL_SIZE, &size);
+			TS_ASSERT_EQUALS(static_cast<size_t>(size), sound->chunks[i].size());
+		}
+
+		ALuint source;
+		alGenSources(1, &source);
+		alSourceQueueBuffers(source, static_cast<ALsizei>(buffers.size()), buffers.data());
+		alSourcePlay(source);
+		// Render less than the sound's length, so it's still playing.
+		std::vector<ALshort> output(256 * 2);
+		alcRenderSamplesSOFT(device, output.data(), 256);
+		ALint state = 0;
+		alGetSourcei(source, AL_SOURCE_STATE, &state);
+		TS_ASSERT_EQUALS(state, AL_PLAYING);
+		TS_ASSERT_EQUALS(alGetError(), AL_NO_ERROR);
+
+		alSourceStop(source);
+		alDeleteSources(1, &source);
+		alDeleteBuffers(static_cast<ALsizei>(buffers.size()), buffers.data());
+		alcMakeContextCurrent(nullptr);
+		alcDestroyContext(context);
+		alcCloseDevice(device);
+#endif
+	}
+};
@@ -0,0 +1,118 @@
+/* Copyright (C) 2025 Wildfire Games.
+ * This file is part of 0 A.D.
+ *
+ * 0 A.D. is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * 0 A.D. is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 0 A.D.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lib/self_test.h"
+
+#include "soundmanager/SoundVoiceManager.h"
+#include "soundmanager/scripting/SoundGroup.h"
+
+class TestSoundVoiceManager : public CxxTest::TestSuite
+{
+	CSoundVoiceManager::Request MakeRequest(CSoundGroup& group, entity_id_t source, float audibility, float priority)
+	{
+		return {&group, 0, CVector3D(static_cast<float>(source), 0.f, 0.f), source, audibility, priority};
+	}
+
+public:
+	void test_merge()
+	{
+		CSoundGroup swords;
+		CSoundGroup arrows;
+		CSoundVoiceManager voiceManager(4, 1.0, 2.f);
+
+		// A battle: many soldiers hit at the same time.
+		for (entity_id_t source = 1; source <= 20; ++source)
+			voiceManager.Queue(MakeRequest(swords, source, source == 7 ? 0.9f : 0.5f, 100.f));
+		voiceManager.Queue(MakeRequest(arrows, 100, 0.5f, 100.f));
+		TS_ASSERT_EQUALS(voiceManager.GetQueuedCount(), 21u);
+
+		const std::vector<CSoundVoiceManager::Voice> voices = voiceManager.Resolve(0.0, 10);
+		TS_ASSERT_EQUALS(voiceManager.GetQueuedCount(), 0u);
+		TS_ASSERT_EQUALS(voices.size(), 2u);
+
+		// The merged voice plays where it's the loudest, louder than a single
+		// request but not unbounded.
+		TS_ASSERT_EQUALS(voices[0].request.group, &swords);
+		TS_ASSERT_EQUALS(voices[0].request.source, 7u);
+		TS_ASSERT_EQUALS(voices[0].mergedCount, 20u);
+		TS_ASSERT_DELTA(voices[0].gain, 2.f, 0.001f);
+
+		TS_ASSERT_EQUALS(voices[1].request.group, &arrows);
+		TS_ASSERT_EQUALS(voices[1].mergedCount, 1u);
+		TS_ASSERT_DELTA(voices[1].gain, 1.f, 0.001f);
+	}
+
+	void test_budget_and_priority()
+	{
+		CSoundGroup groups[4];
+		CSoundVoiceManager voiceManager(4, 1.0, 2.f);
+
+		voiceManager.Queue(MakeRequest(groups[0], 1, 1.f, 30.f));
+		voiceManager.Queue(MakeRequest(groups[1], 2, 1.f, 100.f));
+		voiceManager.Queue(MakeRequest(groups[2], 3, 0.2f, 100.f));
+		// Out of range.
+		voiceManager.Queue(MakeRequest(groups[3], 4, 0.f, 100.f));
+
+		std::vector<CSoundVoiceManager::Voice> voices = voiceManager.Resolve(0.0, 2);
+		TS_ASSERT_EQUALS(voices.size(), 2u);
+		TS_ASSERT_EQUALS(voices[0].request.group, &groups[1]);
+		TS_ASSERT_EQUALS(voices[1].request.group, &groups[0]);
+
+		voiceManager.Queue(MakeRequest(groups[3], 4, 0.f, 100.f));
+		TS_ASSERT(voiceManager.Resolve(0.1, 2).empty());
+
+		// No free source.
+		voiceManager.Queue(MakeRequest(groups[1], 2, 1.f, 100.f));
+		TS_ASSERT(voiceManager.Resolve(0.2, 0).empty());
+	}
+
+	void test_recency()
+	{
+		CSoundGroup footsteps;
+		CSoundGroup horn;
+		CSoundVoiceManager voiceManager(3, 1.0, 2.f);
+
+		for (int frame = 0; frame < 2; ++frame)
+		{
+			voiceManager.Queue(MakeRequest(footsteps, 1, 1.f, 100.f));
+			TS_ASSERT_EQUALS(voiceManager.Resolve(frame * 0.1, 1).size(), 1u);
+		}
+		TS_ASSERT_EQUALS(voiceManager.GetRecentVoiceCount(&footsteps), 2u);
+
+		// A group which played recently yields to a quieter new one.
+		voiceManager.Queue(MakeRequest(footsteps, 1, 1.f, 100.f));
+		voiceManager.Queue(MakeRequest(horn, 2, 0.5f, 100.f));
+		std::vector<CSoundVoiceManager::Voice> voices = voiceManager.Resolve(0.2, 1);
+		TS_ASSERT_EQUALS(voices.size(), 1u);
+		TS_ASSERT_EQUALS(voices[0].request.group, &horn);
+
+		voiceManager.Queue(MakeRequest(footsteps, 1, 1.f, 100.f));
+		TS_ASSERT_EQUALS(voiceManager.Resolve(0.3, 10).size(), 1u);
+
+		// The cap holds even with free sources.
+		voiceManager.Queue(MakeRequest(footsteps, 1, 1.f, 100.f));
+		TS_ASSERT(voiceManager.Resolve(0.4, 10).empty());
+
+		// Until the oldest voice leaves the window.
+		voiceManager.Queue(MakeRequest(footsteps, 1, 1.f, 100.f));
+		TS_ASSERT_EQUALS(voiceManager.Resolve(1.05, 10).size(), 1u);
+		TS_ASSERT_EQUALS(voiceManager.GetRecentVoiceCount(&footsteps), 3u);
+
+		voiceManager.Clear();
+		TS_ASSERT_EQUALS(voiceManager.GetRecentVoiceCount(&footsteps), 0u);
+	}
+};
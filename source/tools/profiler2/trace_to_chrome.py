@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""Convert a profile2.trace file to the Chrome trace event format.
+
+The output can be loaded in Perfetto (https://ui.perfetto.dev) or in
+chrome://tracing. See CProfiler2Trace in source/ps/Profiler2.cpp for a
+description of the input format.
+"""
+
+import argparse
+import json
+import sys
+from pathlib import Path
+
+
+TRACE_MAGIC = b"PS2TRAC1"
+
+TRACE_THREAD = 1
+TRACE_STRING = 2
+TRACE_CHUNK = 3
+
+ITEM_EVENT = 2
+ITEM_ENTER = 3
+ITEM_LEAVE = 4
+ITEM_ATTRIBUTE = 5
+
+
+class Reader:
+    def __init__(self, data, pos=0, end=None):
+        self.data = data
+        self.pos = pos
+        self.end = len(data) if end is None else end
+
+    def at_end(self):
+        return self.pos >= self.end
+
+    def byte(self):
+        value = self.data[self.pos]
+        self.pos += 1
+        return value
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            byte = self.byte()
+            value |= (byte & 0x7F) << shift
+            if byte < 0x80:
+                return value
+            shift += 7
+
+    def signed_varint(self):
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+    def string(self):
+        length = self.varint()
+        value = self.data[self.pos : self.pos + length].decode("utf-8", "replace")
+        self.pos += length
+        return value
+
+
+class Converter:
+    def __init__(self, output):
+        self.output = output
+        self.first = True
+        self.strings = {}
+        self.times = {}
+        # The last event or enter of each thread, which is only written once
+        # its attributes are known.
+        self.pending = {}
+
+    def write(self, event):
+        self.output.write("\n" if self.first else ",\n")
+        self.output.write(json.dumps(event))
+        self.first = False
+
+    def flush_pending(self, thread):
+        event = self.pending.pop(thread, None)
+        if event is not None:
+            self.write(event)
+
+    def convert(self, data):
+        if data[: len(TRACE_MAGIC)] != TRACE_MAGIC:
+            msg = "not a profile2.trace file"
+            raise ValueError(msg)
+
+        self.output.write('{"displayTimeUnit": "ms", "traceEvents": [')
+        reader = Reader(data, len(TRACE_MAGIC))
+        while not reader.at_end():
+            record = reader.byte()
+            if record == TRACE_THREAD:
+                thread = reader.varint()
+                name = reader.string()
+                self.times[thread] = 0
+                self.write(
+                    {
+                        "ph": "M",
+                        "name": "thread_name",
+                        "pid": 0,
+                        "tid": thread,
+                        "args": {"name": name},
+                    }
+                )
+            elif record == TRACE_STRING:
+                index = reader.varint()
+                self.strings[index] = reader.string()
+            elif record == TRACE_CHUNK:
+                thread = reader.varint()
+                length = reader.varint()
+                self.convert_chunk(thread, Reader(data, reader.pos, reader.pos + length))
+                reader.pos += length
+            else:
+                msg = f"invalid record type {record} at offset {reader.pos - 1}"
+                raise ValueError(msg)
+
+        for thread in list(self.pending):
+            self.flush_pending(thread)
+        self.output.write("\n]}\n")
+
+    def convert_chunk(self, thread, reader):
+        while not reader.at_end():
+            item = reader.byte()
+            if item == ITEM_ATTRIBUTE:
+                attribute = reader.string()
+                if thread in self.pending:
+                    args = self.pending[thread].setdefault("args", {})
+                    args[f"attr{len(args)}"] = attribute
+                continue
+
+            self.flush_pending(thread)
+            self.times[thread] += reader.signed_varint()
+            event = {"pid": 0, "tid": thread, "ts": self.times[thread] / 1000}
+            if item == ITEM_EVENT:
+                event.update({"ph": "i", "s": "t", "name": self.strings[reader.varint()]})
+                self.pending[thread] = event
+            elif item == ITEM_ENTER:
+                event.update({"ph": "B", "name": self.strings[reader.varint()]})
+                self.pending[thread] = event
+            elif item == ITEM_LEAVE:
+                event["ph"] = "E"
+                self.write(event)
+            else:
+                msg = f"invalid item type {item} in chunk of thread {thread}"
+                raise ValueError(msg)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("input", type=Path, help="profile2.trace file written by the game")
+    parser.add_argument(
+        "output", type=Path, nargs="?", help="JSON file to write (default: standard output)"
+    )
+    args = parser.parse_args()
+
+    data = args.input.read_bytes()
+    if args.output:
+        with args.output.open("w", encoding="utf-8") as output:
+            Converter(output).convert(data)
+    else:
+        Converter(sys.stdout).convert(data)
+
+
+if __name__ == "__main__":
+    main()
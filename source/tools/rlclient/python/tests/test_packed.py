@@ -0,0 +1,55 @@
+import struct
+import time
+from os import path
+
+import pytest
+import zero_ad
+
+
+game = zero_ad.ZeroAD("http://localhost:6000")
+scriptdir = path.dirname(path.realpath(__file__))
+with open(path.join(scriptdir, "..", "samples", "arcadia.json"), encoding="utf-8") as f:
+    config = f.read()
+
+
+def test_packed_matches_json():
+    state = game.reset(config)
+    packed = game.reset_packed(config, use_snapshot=False)
+    units = {unit.id(): unit for unit in state.units()}
+    assert len(packed) > 0
+    for entity_id, owner in zip(packed.ids, packed.owners, strict=True):
+        if entity_id in units:
+            assert units[entity_id].owner() == owner
+
+
+def test_snapshot_reset():
+    first = game.reset_packed(config, use_snapshot=True)
+    game.step_packed()
+    restored = game.reset_packed(config, use_snapshot=True)
+    assert list(first.ids) == list(restored.ids)
+    assert list(first.x) == list(restored.x)
+    assert list(first.hitpoints) == list(restored.hitpoints)
+
+
+def test_env_steps_per_second():
+    game.reset_packed(config, use_snapshot=True)
+    steps = 100
+    start = time.perf_counter()
+    for _ in range(steps):
+        game.step_packed()
+    print(f"{steps / (time.perf_counter() - start):.1f} env-steps per second")
+
+
+def test_packed_state_layout():
+    data = struct.pack("<I2I2i2f2f2f", 2, 10, 11, 1, -1, 1.5, 2.5, 3.5, 4.5, 100.0, -1.0)
+    state = zero_ad.PackedState(data)
+    assert len(state) == 2
+    assert list(state.ids) == [10, 11]
+    assert list(state.owners) == [1, -1]
+    assert list(state.x) == [1.5, 2.5]
+    assert list(state.z) == [3.5, 4.5]
+    assert list(state.hitpoints) == [100.0, -1.0]
+
+    with pytest.raises(ValueError, match="invalid packed state"):
+        zero_ad.PackedState(b"Game not running. Please create a scenario first.")
+
@@ -6,3 +6,4 @@ from . import (
 
 ZeroAD = environment.ZeroAD
 GameState = environment.GameState
+PackedState = environment.PackedState
@@ -1,5 +1,5 @@
 import json
-from urllib import request
+from urllib import error, request
 
 
 class RLAPI:
@@ -7,19 +7,27 @@ class RLAPI:
         self.url = url
 
     def post(self, route, data):
-        response = request.urlopen(url=f"{self.url}/{route}", data=bytes(data, "utf8"))  # noqa: S310
+        try:
+            response = request.urlopen(url=f"{self.url}/{route}", data=bytes(data, "utf8"))  # noqa: S310
+        except error.HTTPError as e:
+            # The error replies (e.g. when no game is running) explain the problem in the body.
+            raise RuntimeError(e.read().decode("utf8", "replace")) from e
         return response.read()
 
-    def step(self, commands):
+    def step(self, commands, packed=False):
         post_data = "\n".join(f"{player};{json.dumps(action)}" for (player, action) in commands)
-        return self.post("step", post_data)
+        return self.post("step?format=packed" if packed else "step", post_data)
 
-    def reset(self, scenario_config, player_id, save_replay):
+    def reset(self, scenario_config, player_id, save_replay, use_snapshot=False, packed=False):
         path = "reset?"
         if save_replay:
             path += "saveReplay=1&"
+        if use_snapshot:
+            path += "useSnapshot=1&"
         if player_id:
             path += f"playerID={player_id}&"
+        if packed:
+            path += "format=packed&"
 
         return self.post(path, scenario_config)
 
@@ -1,4 +1,6 @@
 import json
+import sys
+from array import array
 from itertools import cycle
 from xml.etree import ElementTree as ET
 
@@ -23,11 +25,23 @@ class ZeroAD:
         self.current_state = GameState(json.loads(state_json), self)
         return self.current_state
 
-    def reset(self, config="", save_replay=False, player_id=1):
-        state_json = self.api.reset(config, player_id, save_replay)
+    def step_packed(self, actions=None, player=None):
+        if actions is None:
+            actions = []
+        player_ids = cycle([self.player_id]) if player is None else cycle(player)
+
+        cmds = zip(player_ids, actions, strict=False)
+        cmds = ((player, action) for (player, action) in cmds if action is not None)
+        return PackedState(self.api.step(cmds, packed=True))
+
+    def reset(self, config="", save_replay=False, player_id=1, use_snapshot=False):
+        state_json = self.api.reset(config, player_id, save_replay, use_snapshot)
         self.current_state = GameState(json.loads(state_json), self)
         return self.current_state
 
+    def reset_packed(self, config="", player_id=1, use_snapshot=True):
+        return PackedState(self.api.reset(config, player_id, False, use_snapshot, packed=True))
+
     def evaluate(self, code):
         return self.api.evaluate(code)
 
@@ -75,6 +89,38 @@ class GameState:
         )
 
 
+class PackedState:
+    """Entity ids, owners, positions and hitpoints as parallel arrays."""
+
+    def __init__(self, data):
+        if len(data) < 4:
+            msg = f"invalid packed state of {len(data)} bytes"
+            raise ValueError(msg)
+        count = array("I", data[:4])
+        if sys.byteorder != "little":
+            count.byteswap()
+        count = count[0]
+        if len(data) != 4 + 5 * 4 * count:
+            msg = f"invalid packed state of {len(data)} bytes for {count} entities"
+            raise ValueError(msg)
+
+        def read(typecode, index):
+            start = 4 + index * 4 * count
+            values = array(typecode, data[start : start + 4 * count])
+            if sys.byteorder != "little":
+                values.byteswap()
+            return values
+
+        self.ids = read("I", 0)
+        self.owners = read("i", 1)
+        self.x = read("f", 2)
+        self.z = read("f", 3)
+        self.hitpoints = read("f", 4)
+
+    def __len__(self):
+        return len(self.ids)
+
+
 class Entity:
     def __init__(self, data, game):
         self.data = data